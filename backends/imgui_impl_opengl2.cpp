@@ -18,6 +18,7 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2021-03-01: OpenGL: Upload font atlas regions listed in ImFontAtlas::TexDirtyRects[] (ImFontAtlasFlags_DynamicGlyphs).
 //  2021-01-03: OpenGL: Backup, setup and restore GL_SHADE_MODEL state, disable GL_STENCIL_TEST and disable GL_NORMAL_ARRAY client state to increase compatibility with legacy OpenGL applications.
 //  2020-01-23: OpenGL: Backup, setup and restore GL_TEXTURE_ENV to increase compatibility with legacy OpenGL applications.
 //  2019-04-30: OpenGL: Added support for special ImDrawCallback_ResetRenderState callback to reset render state.
@@ -120,6 +121,25 @@ static void ImGui_ImplOpenGL2_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glLoadIdentity();
 }
 
+// Upload regions of the font atlas modified since last frame (ImFontAtlasFlags_DynamicGlyphs).
+// We upload full rows to avoid relying on GL_UNPACK_ROW_LENGTH, which is not available on all GL versions.
+static void ImGui_ImplOpenGL2_UpdateFontsTexture()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    if (atlas->TexDirtyRects.Size == 0 || g_FontTexture == 0)
+        return;
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+    for (int n = 0; n < atlas->TexDirtyRects.Size; n++)
+    {
+        const ImFontAtlasDirtyRect& r = atlas->TexDirtyRects[n];
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, r.Y, width, r.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (size_t)r.Y * width * 4);
+    }
+    atlas->TexDirtyRects.resize(0);
+}
+
 // OpenGL2 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -140,6 +160,9 @@ void ImGui_ImplOpenGL2_RenderDrawData(ImDrawData* draw_data)
     GLint last_tex_env_mode; glGetTexEnviv(GL_TEXTURE_ENV, GL_TEXTURE_ENV_MODE, &last_tex_env_mode);
     glPushAttrib(GL_ENABLE_BIT | GL_COLOR_BUFFER_BIT | GL_TRANSFORM_BIT);
 
+    // Upload glyphs rasterized on demand (texture binding will be restored with other state)
+    ImGui_ImplOpenGL2_UpdateFontsTexture();
+
     // Setup desired GL state
     ImGui_ImplOpenGL2_SetupRenderState(draw_data, fb_width, fb_height);
 
@@ -6,6 +6,7 @@
 // Implemented features:
 //  [X] Renderer: User texture binding. Use 'GLuint' OpenGL texture identifier as void*/ImTextureID. Read the FAQ about ImTextureID!
 //  [x] Renderer: Desktop GL only: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Optionally keep vertex/index buffers per draw list and skip uploading unchanged ones (set ImGuiBackendFlags_RendererHasContentHash after init).
 
 // You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
 // If you are new to Dear ImGui, read documentation from the docs/ folder + read the top of imgui.cpp.
@@ -13,6 +14,8 @@
 
 // CHANGELOG
 // (minor and older changes stripped away, please see git history for details)
+//  2021-03-02: OpenGL: Keep vertex/index buffers per draw list and only upload them when ImDrawList::ContentGeneration changed. Opt-in: set ImGuiBackendFlags_RendererHasContentHash after init.
+//  2021-03-01: OpenGL: Upload font atlas regions listed in ImFontAtlas::TexDirtyRects[] (ImFontAtlasFlags_DynamicGlyphs).
 //  2021-02-18: OpenGL: Change blending equation to preserve alpha in output buffer.
 //  2021-01-03: OpenGL: Backup, setup and restore GL_STENCIL_TEST state.
 //  2020-10-23: OpenGL: Backup, setup and restore GL_PRIMITIVE_RESTART state.
@@ -151,6 +154,20 @@ static GLint        g_AttribLocationTex = 0, g_AttribLocationProjMtx = 0;
 static GLuint       g_AttribLocationVtxPos = 0, g_AttribLocationVtxUV = 0, g_AttribLocationVtxColor = 0; // Vertex attributes location
 static unsigned int g_VboHandle = 0, g_ElementsHandle = 0;
 
+// Vertex/index buffers kept for each draw list, re-uploaded only when the list's ContentGeneration changed (ImGuiBackendFlags_RendererHasContentHash)
+struct ImGui_ImplOpenGL3_DrawListBuffers
+{
+    const ImDrawList*   DrawList;
+    unsigned int        ContentGeneration;  // ImDrawList::ContentGeneration of the uploaded contents
+    GLuint              VboHandle, ElementsHandle;
+    bool                Used;               // Used by the current ImGui_ImplOpenGL3_RenderDrawData() call, buffers of unused lists are released at the end of it
+};
+static ImVector<ImGui_ImplOpenGL3_DrawListBuffers> g_DrawListBuffers;
+
+// Forward Declarations
+static void ImGui_ImplOpenGL3_UpdateFontsTexture();
+static void ImGui_ImplOpenGL3_SetupBuffers(GLuint vbo_handle, GLuint elements_handle);
+
 // Functions
 bool    ImGui_ImplOpenGL3_Init(const char* glsl_version)
 {
@@ -243,7 +260,7 @@ void    ImGui_ImplOpenGL3_NewFrame()
         ImGui_ImplOpenGL3_CreateDeviceObjects();
 }
 
-static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object)
+static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_width, int fb_height, GLuint vertex_array_object, GLuint vbo_handle, GLuint elements_handle)
 {
     // Setup render state: alpha-blending enabled, no face culling, no depth testing, scissor enabled, polygon fill
     glEnable(GL_BLEND);
@@ -301,8 +318,14 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
 #endif
 
     // Bind vertex/index buffers and setup attributes for ImDrawVert
-    glBindBuffer(GL_ARRAY_BUFFER, g_VboHandle);
-    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, g_ElementsHandle);
+    ImGui_ImplOpenGL3_SetupBuffers(vbo_handle, elements_handle);
+}
+
+// Bind vertex/index buffers and setup attributes for ImDrawVert (attribute pointers refer to the buffer bound when they are set)
+static void ImGui_ImplOpenGL3_SetupBuffers(GLuint vbo_handle, GLuint elements_handle)
+{
+    glBindBuffer(GL_ARRAY_BUFFER, vbo_handle);
+    glBindBuffer(GL_ELEMENT_ARRAY_BUFFER, elements_handle);
     glEnableVertexAttribArray(g_AttribLocationVtxPos);
     glEnableVertexAttribArray(g_AttribLocationVtxUV);
     glEnableVertexAttribArray(g_AttribLocationVtxColor);
@@ -311,6 +334,48 @@ static void ImGui_ImplOpenGL3_SetupRenderState(ImDrawData* draw_data, int fb_wid
     glVertexAttribPointer(g_AttribLocationVtxColor, 4, GL_UNSIGNED_BYTE, GL_TRUE,  sizeof(ImDrawVert), (GLvoid*)IM_OFFSETOF(ImDrawVert, col));
 }
 
+// Find or create buffers for a draw list. Lists are generally rendered in the same order every frame, so we first look at the same index.
+static ImGui_ImplOpenGL3_DrawListBuffers* ImGui_ImplOpenGL3_GetDrawListBuffers(const ImDrawList* draw_list, int draw_list_idx)
+{
+    ImGui_ImplOpenGL3_DrawListBuffers* buffers = NULL;
+    if (draw_list_idx < g_DrawListBuffers.Size && g_DrawListBuffers[draw_list_idx].DrawList == draw_list)
+        buffers = &g_DrawListBuffers[draw_list_idx];
+    for (int n = 0; n < g_DrawListBuffers.Size && buffers == NULL; n++)
+        if (g_DrawListBuffers[n].DrawList == draw_list)
+            buffers = &g_DrawListBuffers[n];
+    if (buffers == NULL)
+    {
+        ImGui_ImplOpenGL3_DrawListBuffers new_buffers;
+        memset(&new_buffers, 0, sizeof(new_buffers));
+        new_buffers.DrawList = draw_list;
+        glGenBuffers(1, &new_buffers.VboHandle);
+        glGenBuffers(1, &new_buffers.ElementsHandle);
+        g_DrawListBuffers.push_back(new_buffers);
+        buffers = &g_DrawListBuffers.back();
+    }
+    buffers->Used = true;
+    return buffers;
+}
+
+// Delete buffers of draw lists not used since the last call (or all of them)
+static void ImGui_ImplOpenGL3_ReleaseDrawListBuffers(bool release_all)
+{
+    int dst_n = 0;
+    for (int n = 0; n < g_DrawListBuffers.Size; n++)
+    {
+        ImGui_ImplOpenGL3_DrawListBuffers* buffers = &g_DrawListBuffers[n];
+        if (buffers->Used && !release_all)
+        {
+            buffers->Used = false;
+            g_DrawListBuffers[dst_n++] = *buffers;
+            continue;
+        }
+        glDeleteBuffers(1, &buffers->VboHandle);
+        glDeleteBuffers(1, &buffers->ElementsHandle);
+    }
+    g_DrawListBuffers.resize(dst_n);
+}
+
 // OpenGL3 Render function.
 // Note that this implementation is little overcomplicated because we are saving/setting up/restoring every OpenGL state explicitly.
 // This is in order to be able to run within an OpenGL engine that doesn't do so.
@@ -354,6 +419,9 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     GLboolean last_enable_primitive_restart = (g_GlVersion >= 310) ? glIsEnabled(GL_PRIMITIVE_RESTART) : GL_FALSE;
 #endif
 
+    // Upload glyphs rasterized on demand (texture binding will be restored with other state)
+    ImGui_ImplOpenGL3_UpdateFontsTexture();
+
     // Setup desired GL state
     // Recreate the VAO every time (this is to easily allow multiple GL contexts to be rendered to. VAO are not shared among GL contexts)
     // The renderer would actually work without any VAO bound, but then our VertexAttrib calls would overwrite the default one currently bound.
@@ -361,7 +429,11 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
 #ifndef IMGUI_IMPL_OPENGL_ES2
     glGenVertexArrays(1, &vertex_array_object);
 #endif
-    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object, g_VboHandle, g_ElementsHandle);
+
+    // Keep buffers per draw list when Render() tells us which lists are unchanged.
+    // This is opt-in: hashing every list in Render() costs more than uploading it unless most of the contents are static.
+    const bool use_draw_list_buffers = (ImGui::GetIO().BackendFlags & ImGuiBackendFlags_RendererHasContentHash) != 0;
 
     // Will project scissor/clipping rectangles into framebuffer space
     ImVec2 clip_off = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
@@ -373,8 +445,25 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
         const ImDrawList* cmd_list = draw_data->CmdLists[n];
 
         // Upload vertex/index buffers
-        glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
-        glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+        GLuint vbo_handle = g_VboHandle, elements_handle = g_ElementsHandle;
+        if (use_draw_list_buffers)
+        {
+            ImGui_ImplOpenGL3_DrawListBuffers* buffers = ImGui_ImplOpenGL3_GetDrawListBuffers(cmd_list, n);
+            vbo_handle = buffers->VboHandle;
+            elements_handle = buffers->ElementsHandle;
+            ImGui_ImplOpenGL3_SetupBuffers(vbo_handle, elements_handle);
+            if (buffers->ContentGeneration != cmd_list->ContentGeneration)
+            {
+                glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_DYNAMIC_DRAW);
+                glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_DYNAMIC_DRAW);
+                buffers->ContentGeneration = cmd_list->ContentGeneration;
+            }
+        }
+        else
+        {
+            glBufferData(GL_ARRAY_BUFFER, (GLsizeiptr)cmd_list->VtxBuffer.Size * (int)sizeof(ImDrawVert), (const GLvoid*)cmd_list->VtxBuffer.Data, GL_STREAM_DRAW);
+            glBufferData(GL_ELEMENT_ARRAY_BUFFER, (GLsizeiptr)cmd_list->IdxBuffer.Size * (int)sizeof(ImDrawIdx), (const GLvoid*)cmd_list->IdxBuffer.Data, GL_STREAM_DRAW);
+        }
 
         for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
         {
@@ -384,7 +473,7 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
                 // User callback, registered via ImDrawList::AddCallback()
                 // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
                 if (pcmd->UserCallback == ImDrawCallback_ResetRenderState)
-                    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object);
+                    ImGui_ImplOpenGL3_SetupRenderState(draw_data, fb_width, fb_height, vertex_array_object, vbo_handle, elements_handle);
                 else
                     pcmd->UserCallback(cmd_list, pcmd);
             }
@@ -420,6 +509,9 @@ void    ImGui_ImplOpenGL3_RenderDrawData(ImDrawData* draw_data)
     glDeleteVertexArrays(1, &vertex_array_object);
 #endif
 
+    // Release buffers of draw lists which were not rendered (or all of them if the feature was disabled)
+    ImGui_ImplOpenGL3_ReleaseDrawListBuffers(false);
+
     // Restore modified GL state
     glUseProgram(last_program);
     glBindTexture(GL_TEXTURE_2D, last_texture);
@@ -490,6 +582,25 @@ void ImGui_ImplOpenGL3_DestroyFontsTexture()
     }
 }
 
+// Upload regions of the font atlas modified since last frame (ImFontAtlasFlags_DynamicGlyphs).
+// We upload full rows to avoid relying on GL_UNPACK_ROW_LENGTH, which is not available on all GL versions.
+static void ImGui_ImplOpenGL3_UpdateFontsTexture()
+{
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    if (atlas->TexDirtyRects.Size == 0 || g_FontTexture == 0)
+        return;
+    unsigned char* pixels;
+    int width, height;
+    atlas->GetTexDataAsRGBA32(&pixels, &width, &height);
+    glBindTexture(GL_TEXTURE_2D, g_FontTexture);
+    for (int n = 0; n < atlas->TexDirtyRects.Size; n++)
+    {
+        const ImFontAtlasDirtyRect& r = atlas->TexDirtyRects[n];
+        glTexSubImage2D(GL_TEXTURE_2D, 0, 0, r.Y, width, r.Height, GL_RGBA, GL_UNSIGNED_BYTE, pixels + (size_t)r.Y * width * 4);
+    }
+    atlas->TexDirtyRects.resize(0);
+}
+
 // If you get an error please report on github. You may try different GL context version or GLSL version. See GL<>GLSL version table at the top of this file.
 static bool CheckShader(GLuint handle, const char* desc)
 {
@@ -710,6 +821,7 @@ void    ImGui_ImplOpenGL3_DestroyDeviceObjects()
 {
     if (g_VboHandle)        { glDeleteBuffers(1, &g_VboHandle); g_VboHandle = 0; }
     if (g_ElementsHandle)   { glDeleteBuffers(1, &g_ElementsHandle); g_ElementsHandle = 0; }
+    ImGui_ImplOpenGL3_ReleaseDrawListBuffers(true);
     if (g_ShaderHandle && g_VertHandle) { glDetachShader(g_ShaderHandle, g_VertHandle); }
     if (g_ShaderHandle && g_FragHandle) { glDetachShader(g_ShaderHandle, g_FragHandle); }
     if (g_VertHandle)       { glDeleteShader(g_VertHandle); g_VertHandle = 0; }
@@ -0,0 +1,630 @@
+// dear imgui: Renderer Backend for CPU software rasterization (no GPU required)
+// This needs to be used along with a Platform Backend (e.g. GLFW, SDL, Win32, custom..), or with none at all to render headless
+// (e.g. screenshots and golden-image tests on CI, measuring end-to-end frame cost on server machines).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Multi-threaded rasterization by tiles, using a parallel-for dispatcher provided by the application.
+//  [X] Renderer: Skip rendering when draw data didn't change since the previous call (uses ImGuiBackendFlags_RendererHasContentHash).
+// Output is identical with or without multi-threading and SSE2.
+// User callbacks (ImDrawList::AddCallback) are called before any triangle of the frame is rasterized.
+
+// You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// If you are new to Dear ImGui, read documentation from the docs/ folder + read the top of imgui.cpp.
+// Read online: https://github.com/ocornut/imgui/tree/master/docs
+
+// CHANGELOG
+// (minor and older changes stripped away, please see git history for details)
+//  2021-03-08: Initial version.
+
+// How it works:
+// - Triangles are binned into fixed-size screen tiles, then each tile is cleared and rasterized independently (one job per tile).
+//   Within a tile, triangles are drawn in submission order, so output doesn't depend on how jobs are scheduled.
+// - Coverage uses 8-bit sub-pixel fixed-point edge functions sampled at pixel centers, with a top-left fill rule so that pixels
+//   on an edge shared by two triangles are drawn exactly once (no seams or double blending on translucent quads).
+// - Color and UV are interpolated linearly, textures are sampled with bilinear filtering (required by ImDrawListFlags_AntiAliasedLinesUseTex).
+// - Triangles with the same color and UV on all vertices (most of dear imgui's output: solid fills use the white pixel of the atlas) are
+//   blended as constant spans, 4 pixels at a time with SSE2. Other triangles interpolate and sample their pixels one at a time, then
+//   modulate and blend them 4 at a time with SSE2. The same integer math is used by the scalar code so results are identical.
+// - Blending is SRC_ALPHA, ONE_MINUS_SRC_ALPHA on color and ONE, ONE_MINUS_SRC_ALPHA on alpha, so the output can be composited.
+
+#include "imgui.h"
+#include "imgui_impl_softraster.h"
+#include <math.h>       // floorf, ceilf
+#include <string.h>     // memset
+
+#if (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))) && !defined(IMGUI_DISABLE_SSE) && (IM_COL32_A_SHIFT == 24)
+#define IMGUI_IMPL_SOFTRASTER_SSE2
+#include <emmintrin.h>
+#endif
+
+// Tile size in pixels. Smaller tiles bin more triangles more than once, larger tiles make fewer jobs.
+#ifndef IMGUI_IMPL_SOFTRASTER_TILE_SIZE
+#define IMGUI_IMPL_SOFTRASTER_TILE_SIZE     64
+#endif
+#define IMGUI_IMPL_SOFTRASTER_SUBPIXEL_BITS 8
+#define IMGUI_IMPL_SOFTRASTER_COORD_MAX     (1 << 20)   // Vertex positions are clamped to this range (in pixels) so that edge functions fit in 64-bit integers
+
+// A triangle binned into tiles. Setup is done by each tile rasterizing it, so it is done in parallel.
+struct ImGui_ImplSoftRaster_Triangle
+{
+    const ImDrawVert*                   Vtx[3];
+    const ImGui_ImplSoftRaster_Texture* Texture;
+    int                                 MinX, MinY, MaxX, MaxY; // Bounding box intersected with clipping rectangle and target (max is exclusive)
+};
+
+// Render state shared by all tile jobs of a frame
+struct ImGui_ImplSoftRaster_FrameData
+{
+    ImGui_ImplSoftRaster_Texture*       Target;
+    ImU32                               ClearCol;
+    ImVec2                              ClipOff;
+    ImVec2                              ClipScale;
+    int                                 TilesCountX;
+};
+
+// Software Rasterizer Data
+static ImGui_ImplSoftRaster_Texture     g_FontTexture = { NULL, 0, 0 };
+static ImFontAtlasParallelForFunc       g_ParallelForFunc = NULL;
+static void*                            g_ParallelForUserData = NULL;
+static ImVector<ImGui_ImplSoftRaster_Triangle> g_Triangles;
+static ImVector<int>                    g_TileBinOffsets;       // Triangles of tile N are g_TileBinTriangles[g_TileBinOffsets[N] .. g_TileBinOffsets[N+1]]
+static ImVector<int>                    g_TileBinTriangles;
+static ImGui_ImplSoftRaster_FrameData   g_FrameData;
+
+// State of the previous render, to skip rendering when nothing changed
+static bool                             g_PrevValid = false;
+static ImGui_ImplSoftRaster_Texture     g_PrevTarget = { NULL, 0, 0 };
+static ImU32                            g_PrevClearCol = 0;
+static ImVec2                           g_PrevDisplayPos, g_PrevDisplaySize, g_PrevFramebufferScale;
+static ImVector<const ImDrawList*>      g_PrevCmdLists;
+static ImVector<unsigned int>           g_PrevCmdListsGenerations;
+
+//-----------------------------------------------------------------------------
+// Pixel helpers
+//-----------------------------------------------------------------------------
+
+template<typename T> static inline T ImGui_ImplSoftRaster_Min(T lhs, T rhs) { return lhs < rhs ? lhs : rhs; }
+template<typename T> static inline T ImGui_ImplSoftRaster_Max(T lhs, T rhs) { return lhs >= rhs ? lhs : rhs; }
+
+// Exact rounded division by 255 for x in [0, 65025]
+static inline int ImGui_ImplSoftRaster_Div255(int x)       { x += 128; return (x + (x >> 8)) >> 8; }
+static inline int ImGui_ImplSoftRaster_Channel(ImU32 col, int shift) { return (int)((col >> shift) & 0xFF); }
+
+static inline ImU32 ImGui_ImplSoftRaster_Modulate(ImU32 a, ImU32 b)
+{
+    if (a == 0xFFFFFFFF)
+        return b;
+    if (b == 0xFFFFFFFF)
+        return a;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+        out |= (ImU32)ImGui_ImplSoftRaster_Div255(ImGui_ImplSoftRaster_Channel(a, shift) * ImGui_ImplSoftRaster_Channel(b, shift)) << shift;
+    return out;
+}
+
+static inline ImU32 ImGui_ImplSoftRaster_Blend(ImU32 dst, ImU32 src)
+{
+    const int src_a = ImGui_ImplSoftRaster_Channel(src, IM_COL32_A_SHIFT);
+    if (src_a == 255)
+        return src;
+    if (src_a == 0)
+        return dst;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        const int s = (shift == IM_COL32_A_SHIFT) ? 255 : ImGui_ImplSoftRaster_Channel(src, shift);
+        out |= (ImU32)ImGui_ImplSoftRaster_Div255(s * src_a + ImGui_ImplSoftRaster_Channel(dst, shift) * (255 - src_a)) << shift;
+    }
+    return out;
+}
+
+// Blend a constant color over a span of pixels
+static void ImGui_ImplSoftRaster_BlendSpan(ImU32* dst, int count, ImU32 src)
+{
+    const int src_a = ImGui_ImplSoftRaster_Channel(src, IM_COL32_A_SHIFT);
+    if (src_a == 0)
+        return;
+    if (src_a == 255)
+    {
+        for (int n = 0; n < count; n++)
+            dst[n] = src;
+        return;
+    }
+    int n = 0;
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE2
+    // Same math as ImGui_ImplSoftRaster_Blend() with 16-bit lanes: (s * a + d * (255 - a) + 128) fits in 16 bits.
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i src_term = _mm_set_epi16(
+        (short)(255 * src_a + 128), (short)(ImGui_ImplSoftRaster_Channel(src, 16) * src_a + 128), (short)(ImGui_ImplSoftRaster_Channel(src, 8) * src_a + 128), (short)(ImGui_ImplSoftRaster_Channel(src, 0) * src_a + 128),
+        (short)(255 * src_a + 128), (short)(ImGui_ImplSoftRaster_Channel(src, 16) * src_a + 128), (short)(ImGui_ImplSoftRaster_Channel(src, 8) * src_a + 128), (short)(ImGui_ImplSoftRaster_Channel(src, 0) * src_a + 128));
+    const __m128i dst_mul = _mm_set1_epi16((short)(255 - src_a));
+    for (; n + 4 <= count; n += 4)
+    {
+        __m128i d = _mm_loadu_si128((const __m128i*)(dst + n));
+        __m128i lo = _mm_add_epi16(_mm_mullo_epi16(_mm_unpacklo_epi8(d, zero), dst_mul), src_term);
+        __m128i hi = _mm_add_epi16(_mm_mullo_epi16(_mm_unpackhi_epi8(d, zero), dst_mul), src_term);
+        lo = _mm_srli_epi16(_mm_add_epi16(lo, _mm_srli_epi16(lo, 8)), 8);
+        hi = _mm_srli_epi16(_mm_add_epi16(hi, _mm_srli_epi16(hi, 8)), 8);
+        _mm_storeu_si128((__m128i*)(dst + n), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; n < count; n++)
+        dst[n] = ImGui_ImplSoftRaster_Blend(dst[n], src);
+}
+
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE2
+// Exact rounded division by 255 on 16-bit lanes, same as ImGui_ImplSoftRaster_Div255()
+static inline __m128i ImGui_ImplSoftRaster_Div255_SSE2(__m128i x)
+{
+    x = _mm_add_epi16(x, _mm_set1_epi16(128));
+    return _mm_srli_epi16(_mm_add_epi16(x, _mm_srli_epi16(x, 8)), 8);
+}
+
+// Modulate then blend two pixels unpacked to 16-bit lanes
+static inline __m128i ImGui_ImplSoftRaster_ModulateBlend_SSE2(__m128i d, __m128i tex, __m128i col)
+{
+    const __m128i src = ImGui_ImplSoftRaster_Div255_SSE2(_mm_mullo_epi16(tex, col));
+    const __m128i src_a = _mm_shufflehi_epi16(_mm_shufflelo_epi16(src, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+    const __m128i src_rgb1 = _mm_or_si128(src, _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0));
+    const __m128i dst_mul = _mm_sub_epi16(_mm_set1_epi16(255), src_a);
+    return ImGui_ImplSoftRaster_Div255_SSE2(_mm_add_epi16(_mm_mullo_epi16(src_rgb1, src_a), _mm_mullo_epi16(d, dst_mul)));
+}
+#endif
+
+// Blend a span of pixels, each one being a texture sample modulated by a color.
+// Blend() and Modulate() shortcuts for 0 and 255 give the same results as their general formula, so the SSE2 path doesn't need them.
+static void ImGui_ImplSoftRaster_BlendPixels(ImU32* dst, int count, const ImU32* tex, const ImU32* col)
+{
+    int n = 0;
+#ifdef IMGUI_IMPL_SOFTRASTER_SSE2
+    const __m128i zero = _mm_setzero_si128();
+    const __m128i alpha_mask = _mm_set1_epi32((int)IM_COL32_A_MASK);
+    for (; n + 4 <= count; n += 4)
+    {
+        const __m128i d = _mm_loadu_si128((const __m128i*)(dst + n));
+        const __m128i t = _mm_loadu_si128((const __m128i*)(tex + n));
+        const __m128i c = _mm_loadu_si128((const __m128i*)(col + n));
+        if (_mm_movemask_epi8(_mm_cmpeq_epi32(_mm_and_si128(_mm_min_epu8(t, c), alpha_mask), zero)) == 0xFFFF)
+            continue; // Fully transparent (e.g. empty texels around glyphs)
+        const __m128i lo = ImGui_ImplSoftRaster_ModulateBlend_SSE2(_mm_unpacklo_epi8(d, zero), _mm_unpacklo_epi8(t, zero), _mm_unpacklo_epi8(c, zero));
+        const __m128i hi = ImGui_ImplSoftRaster_ModulateBlend_SSE2(_mm_unpackhi_epi8(d, zero), _mm_unpackhi_epi8(t, zero), _mm_unpackhi_epi8(c, zero));
+        _mm_storeu_si128((__m128i*)(dst + n), _mm_packus_epi16(lo, hi));
+    }
+#endif
+    for (; n < count; n++)
+        dst[n] = ImGui_ImplSoftRaster_Blend(dst[n], ImGui_ImplSoftRaster_Modulate(tex[n], col[n]));
+}
+
+// Bilinear sampling with clamp-to-edge, texel centers at (n + 0.5) / size
+static ImU32 ImGui_ImplSoftRaster_SampleTexture(const ImGui_ImplSoftRaster_Texture* tex, float u, float v)
+{
+    if (tex == NULL || tex->Pixels == NULL)
+        return 0xFFFFFFFF;
+    const float fx = u * tex->Width - 0.5f;
+    const float fy = v * tex->Height - 0.5f;
+    const float fx_floor = floorf(fx);
+    const float fy_floor = floorf(fy);
+    const int wx = (int)((fx - fx_floor) * 256.0f + 0.5f);
+    const int wy = (int)((fy - fy_floor) * 256.0f + 0.5f);
+    int x0 = (int)fx_floor, y0 = (int)fy_floor;
+    int x1 = x0 + 1, y1 = y0 + 1;
+    x0 = (x0 < 0) ? 0 : (x0 >= tex->Width) ? tex->Width - 1 : x0;
+    x1 = (x1 < 0) ? 0 : (x1 >= tex->Width) ? tex->Width - 1 : x1;
+    y0 = (y0 < 0) ? 0 : (y0 >= tex->Height) ? tex->Height - 1 : y0;
+    y1 = (y1 < 0) ? 0 : (y1 >= tex->Height) ? tex->Height - 1 : y1;
+    const ImU32 c00 = tex->Pixels[y0 * tex->Width + x0];
+    if ((wx == 0 || wx == 256) && (wy == 0 || wy == 256))
+        return tex->Pixels[(wy == 256 ? y1 : y0) * tex->Width + (wx == 256 ? x1 : x0)];
+    const ImU32 c10 = tex->Pixels[y0 * tex->Width + x1];
+    const ImU32 c01 = tex->Pixels[y1 * tex->Width + x0];
+    const ImU32 c11 = tex->Pixels[y1 * tex->Width + x1];
+    const int w00 = (256 - wx) * (256 - wy), w10 = wx * (256 - wy), w01 = (256 - wx) * wy, w11 = wx * wy;
+    ImU32 out = 0;
+    for (int shift = 0; shift < 32; shift += 8)
+    {
+        const int c = ImGui_ImplSoftRaster_Channel(c00, shift) * w00 + ImGui_ImplSoftRaster_Channel(c10, shift) * w10 + ImGui_ImplSoftRaster_Channel(c01, shift) * w01 + ImGui_ImplSoftRaster_Channel(c11, shift) * w11;
+        out |= (ImU32)((c + 32768) >> 16) << shift;
+    }
+    return out;
+}
+
+//-----------------------------------------------------------------------------
+// Triangle rasterization
+//-----------------------------------------------------------------------------
+
+// Edge function E(px, py) = A * px + B * py + C in fixed-point, positive inside the triangle
+struct ImGui_ImplSoftRaster_Edge
+{
+    ImS64   A, B, C;
+};
+
+// Attribute plane: value(x, y) = V + DX * (x - origin x) + DY * (y - origin y)
+struct ImGui_ImplSoftRaster_Plane
+{
+    float   V, DX, DY;
+};
+
+static inline ImS64 ImGui_ImplSoftRaster_FloorDiv(ImS64 n, ImS64 d) { return (n >= 0) ? n / d : -((-n + d - 1) / d); }  // d > 0
+static inline ImS64 ImGui_ImplSoftRaster_CeilDiv(ImS64 n, ImS64 d)  { return (n >= 0) ? (n + d - 1) / d : -((-n) / d); }  // d > 0
+
+static inline ImS64 ImGui_ImplSoftRaster_ToFixed(float v)
+{
+    const float v_max = (float)IMGUI_IMPL_SOFTRASTER_COORD_MAX;
+    v = (v < -v_max) ? -v_max : (v > v_max) ? v_max : v;
+    return (ImS64)floorf(v * (1 << IMGUI_IMPL_SOFTRASTER_SUBPIXEL_BITS) + 0.5f);
+}
+
+static ImGui_ImplSoftRaster_Plane ImGui_ImplSoftRaster_SetupPlane(const float* x, const float* y, float inv_det, float a0, float a1, float a2)
+{
+    ImGui_ImplSoftRaster_Plane plane;
+    plane.V = a0;
+    plane.DX = ((a1 - a0) * (y[2] - y[0]) - (a2 - a0) * (y[1] - y[0])) * inv_det;
+    plane.DY = ((a2 - a0) * (x[1] - x[0]) - (a1 - a0) * (x[2] - x[0])) * inv_det;
+    return plane;
+}
+
+static inline int ImGui_ImplSoftRaster_PlaneToChannel(float v)
+{
+    const int c = (int)(v + 0.5f);
+    return (c < 0) ? 0 : (c > 255) ? 255 : c;
+}
+
+// Rasterize the part of a triangle overlapping the [min_x,max_x)x[min_y,max_y) rectangle
+static void ImGui_ImplSoftRaster_RasterizeTriangle(const ImGui_ImplSoftRaster_Triangle& tri, int min_x, int min_y, int max_x, int max_y)
+{
+    const ImGui_ImplSoftRaster_FrameData& fd = g_FrameData;
+    const int sub = 1 << IMGUI_IMPL_SOFTRASTER_SUBPIXEL_BITS;
+
+    // Fixed-point positions, and positions rounded back to float so that attributes match coverage
+    const ImDrawVert* vtx[3] = { tri.Vtx[0], tri.Vtx[1], tri.Vtx[2] };
+    ImS64 fx[3], fy[3];
+    for (int n = 0; n < 3; n++)
+    {
+        fx[n] = ImGui_ImplSoftRaster_ToFixed((vtx[n]->pos.x - fd.ClipOff.x) * fd.ClipScale.x);
+        fy[n] = ImGui_ImplSoftRaster_ToFixed((vtx[n]->pos.y - fd.ClipOff.y) * fd.ClipScale.y);
+    }
+    ImS64 area = (fx[1] - fx[0]) * (fy[2] - fy[0]) - (fy[1] - fy[0]) * (fx[2] - fx[0]);
+    if (area == 0)
+        return;
+    if (area < 0)
+    {
+        ImS64 tmp_x = fx[1], tmp_y = fy[1]; fx[1] = fx[2]; fy[1] = fy[2]; fx[2] = tmp_x; fy[2] = tmp_y;
+        const ImDrawVert* tmp_v = vtx[1]; vtx[1] = vtx[2]; vtx[2] = tmp_v;
+        area = -area;
+    }
+
+    // Edges v0->v1, v1->v2, v2->v0. Pixels exactly on an edge are only covered by top and left edges (E > 0 required otherwise, hence the -1 bias).
+    ImGui_ImplSoftRaster_Edge edges[3];
+    for (int n = 0; n < 3; n++)
+    {
+        const int n1 = (n + 1) % 3;
+        ImGui_ImplSoftRaster_Edge& e = edges[n];
+        e.A = fy[n] - fy[n1];
+        e.B = fx[n1] - fx[n];
+        e.C = -(e.A * fx[n] + e.B * fy[n]);
+        const bool top_left = (e.A > 0) || (e.A == 0 && e.B > 0);
+        if (!top_left)
+            e.C -= 1;
+    }
+
+    // Constant color and texture sample (e.g. solid fills using the white pixel of the font atlas, or plain text) are computed once
+    const bool col_constant = (vtx[0]->col == vtx[1]->col && vtx[0]->col == vtx[2]->col);
+    const bool uv_constant = (vtx[0]->uv.x == vtx[1]->uv.x && vtx[0]->uv.x == vtx[2]->uv.x && vtx[0]->uv.y == vtx[1]->uv.y && vtx[0]->uv.y == vtx[2]->uv.y);
+    const ImU32 const_tex = uv_constant ? ImGui_ImplSoftRaster_SampleTexture(tri.Texture, vtx[0]->uv.x, vtx[0]->uv.y) : 0;
+    const ImU32 const_col = col_constant ? vtx[0]->col : 0;
+    if (col_constant && ImGui_ImplSoftRaster_Channel(const_col, IM_COL32_A_SHIFT) == 0)
+        return;
+
+    ImGui_ImplSoftRaster_Plane planes[6]; // R, G, B, A, U, V
+    memset(planes, 0, sizeof(planes));
+    float origin_x = 0.0f, origin_y = 0.0f;
+    if (!col_constant || !uv_constant)
+    {
+        float x[3], y[3];
+        for (int n = 0; n < 3; n++)
+        {
+            x[n] = (float)fx[n] / sub;
+            y[n] = (float)fy[n] / sub;
+        }
+        const float inv_det = (float)sub * (float)sub / (float)area;
+        origin_x = x[0];
+        origin_y = y[0];
+        if (!col_constant)
+            for (int c = 0; c < 4; c++)
+            {
+                const int shift = (c == 0) ? IM_COL32_R_SHIFT : (c == 1) ? IM_COL32_G_SHIFT : (c == 2) ? IM_COL32_B_SHIFT : IM_COL32_A_SHIFT;
+                planes[c] = ImGui_ImplSoftRaster_SetupPlane(x, y, inv_det, (float)ImGui_ImplSoftRaster_Channel(vtx[0]->col, shift), (float)ImGui_ImplSoftRaster_Channel(vtx[1]->col, shift), (float)ImGui_ImplSoftRaster_Channel(vtx[2]->col, shift));
+            }
+        if (!uv_constant)
+        {
+            planes[4] = ImGui_ImplSoftRaster_SetupPlane(x, y, inv_det, vtx[0]->uv.x, vtx[1]->uv.x, vtx[2]->uv.x);
+            planes[5] = ImGui_ImplSoftRaster_SetupPlane(x, y, inv_det, vtx[0]->uv.y, vtx[1]->uv.y, vtx[2]->uv.y);
+        }
+    }
+    const ImU32 const_src = ImGui_ImplSoftRaster_Modulate(const_tex, const_col);
+
+    // Clip to triangle bounds
+    min_x = ImGui_ImplSoftRaster_Max(min_x, tri.MinX); max_x = ImGui_ImplSoftRaster_Min(max_x, tri.MaxX);
+    min_y = ImGui_ImplSoftRaster_Max(min_y, tri.MinY); max_y = ImGui_ImplSoftRaster_Min(max_y, tri.MaxY);
+
+    ImGui_ImplSoftRaster_Texture* target = fd.Target;
+    for (int py = min_y; py < max_y; py++)
+    {
+        // Solve E(px) >= 0 for each edge at the center of pixels of this row
+        const ImS64 center_y = (ImS64)py * sub + sub / 2;
+        ImS64 span_min = min_x, span_max = max_x - 1;
+        for (int n = 0; n < 3 && span_min <= span_max; n++)
+        {
+            const ImGui_ImplSoftRaster_Edge& e = edges[n];
+            const ImS64 a = e.A * sub;
+            const ImS64 k = e.A * (sub / 2) + e.B * center_y + e.C;
+            if (a > 0)
+                span_min = ImGui_ImplSoftRaster_Max(span_min, ImGui_ImplSoftRaster_CeilDiv(-k, a));
+            else if (a < 0)
+                span_max = ImGui_ImplSoftRaster_Min(span_max, ImGui_ImplSoftRaster_FloorDiv(k, -a));
+            else if (k < 0)
+                span_max = span_min - 1;
+        }
+        if (span_min > span_max)
+            continue;
+
+        ImU32* dst = target->Pixels + (size_t)py * (size_t)target->Width;
+        if (col_constant && uv_constant)
+        {
+            ImGui_ImplSoftRaster_BlendSpan(dst + span_min, (int)(span_max - span_min + 1), const_src);
+            continue;
+        }
+
+        const float dx0 = (float)span_min + 0.5f - origin_x;
+        const float dy0 = (float)py + 0.5f - origin_y;
+        float values[6], steps[6];
+        for (int n = 0; n < 6; n++)
+        {
+            values[n] = planes[n].V + planes[n].DX * dx0 + planes[n].DY * dy0;
+            steps[n] = planes[n].DX;
+        }
+
+        // Interpolate and sample a batch of pixels, then modulate and blend them 4 at a time
+        ImU32 batch_tex[64], batch_col[64];
+        for (ImS64 px = span_min; px <= span_max; )
+        {
+            const int batch_count = (int)ImGui_ImplSoftRaster_Min(span_max - px + 1, (ImS64)IM_ARRAYSIZE(batch_tex));
+            for (int batch_n = 0; batch_n < batch_count; batch_n++)
+            {
+                batch_col[batch_n] = col_constant ? const_col :
+                    ((ImU32)ImGui_ImplSoftRaster_PlaneToChannel(values[0]) << IM_COL32_R_SHIFT) | ((ImU32)ImGui_ImplSoftRaster_PlaneToChannel(values[1]) << IM_COL32_G_SHIFT) |
+                    ((ImU32)ImGui_ImplSoftRaster_PlaneToChannel(values[2]) << IM_COL32_B_SHIFT) | ((ImU32)ImGui_ImplSoftRaster_PlaneToChannel(values[3]) << IM_COL32_A_SHIFT);
+                batch_tex[batch_n] = uv_constant ? const_tex : ImGui_ImplSoftRaster_SampleTexture(tri.Texture, values[4], values[5]);
+                for (int n = 0; n < 6; n++)
+                    values[n] += steps[n];
+            }
+            ImGui_ImplSoftRaster_BlendPixels(dst + px, batch_count, batch_tex, batch_col);
+            px += batch_count;
+        }
+    }
+}
+
+// Job: clear a tile then rasterize its triangles in submission order
+static void ImGui_ImplSoftRaster_RenderTile(void* job_data, int tile_n)
+{
+    IM_UNUSED(job_data);
+    const ImGui_ImplSoftRaster_FrameData& fd = g_FrameData;
+    ImGui_ImplSoftRaster_Texture* target = fd.Target;
+    const int min_x = (tile_n % fd.TilesCountX) * IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+    const int min_y = (tile_n / fd.TilesCountX) * IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+    const int max_x = ImGui_ImplSoftRaster_Min(min_x + IMGUI_IMPL_SOFTRASTER_TILE_SIZE, target->Width);
+    const int max_y = ImGui_ImplSoftRaster_Min(min_y + IMGUI_IMPL_SOFTRASTER_TILE_SIZE, target->Height);
+    for (int y = min_y; y < max_y; y++)
+    {
+        ImU32* dst = target->Pixels + (size_t)y * (size_t)target->Width;
+        for (int x = min_x; x < max_x; x++)
+            dst[x] = fd.ClearCol;
+    }
+    for (int bin_n = g_TileBinOffsets[tile_n]; bin_n < g_TileBinOffsets[tile_n + 1]; bin_n++)
+        ImGui_ImplSoftRaster_RasterizeTriangle(g_Triangles[g_TileBinTriangles[bin_n]], min_x, min_y, max_x, max_y);
+}
+
+//-----------------------------------------------------------------------------
+// Functions
+//-----------------------------------------------------------------------------
+
+bool    ImGui_ImplSoftRaster_Init(ImFontAtlasParallelForFunc parallel_for_func, void* parallel_for_user_data)
+{
+    // Setup backend capabilities flags
+    ImGuiIO& io = ImGui::GetIO();
+    io.BackendRendererName = "imgui_impl_softraster";
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset;      // We can honor the ImDrawCmd::VtxOffset field, allowing for large meshes.
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasContentHash;    // We skip rendering when no draw list changed.
+    g_ParallelForFunc = parallel_for_func;
+    g_ParallelForUserData = parallel_for_user_data;
+    return true;
+}
+
+void    ImGui_ImplSoftRaster_Shutdown()
+{
+    ImGui_ImplSoftRaster_DestroyFontsTexture();
+    g_Triangles.clear();
+    g_TileBinOffsets.clear();
+    g_TileBinTriangles.clear();
+    g_PrevCmdLists.clear();
+    g_PrevCmdListsGenerations.clear();
+    g_PrevValid = false;
+}
+
+void    ImGui_ImplSoftRaster_NewFrame()
+{
+    if (!g_FontTexture.Pixels)
+        ImGui_ImplSoftRaster_CreateFontsTexture();
+}
+
+void    ImGui_ImplSoftRaster_InvalidateOutput()
+{
+    g_PrevValid = false;
+}
+
+// Compare against the previous render. Draw lists with user callbacks are never considered unchanged.
+static bool ImGui_ImplSoftRaster_IsOutputUnchanged(ImDrawData* draw_data, ImGui_ImplSoftRaster_Texture* target, ImU32 clear_col)
+{
+    bool unchanged = g_PrevValid && g_PrevTarget.Pixels == target->Pixels && g_PrevTarget.Width == target->Width && g_PrevTarget.Height == target->Height && g_PrevClearCol == clear_col
+        && g_PrevDisplayPos.x == draw_data->DisplayPos.x && g_PrevDisplayPos.y == draw_data->DisplayPos.y && g_PrevDisplaySize.x == draw_data->DisplaySize.x && g_PrevDisplaySize.y == draw_data->DisplaySize.y
+        && g_PrevFramebufferScale.x == draw_data->FramebufferScale.x && g_PrevFramebufferScale.y == draw_data->FramebufferScale.y
+        && g_PrevCmdLists.Size == draw_data->CmdListsCount;
+    for (int n = 0; n < draw_data->CmdListsCount && unchanged; n++)
+        if (g_PrevCmdLists[n] != draw_data->CmdLists[n] || g_PrevCmdListsGenerations[n] != draw_data->CmdLists[n]->ContentGeneration)
+            unchanged = false;
+
+    g_PrevValid = true;
+    g_PrevTarget = *target;
+    g_PrevClearCol = clear_col;
+    g_PrevDisplayPos = draw_data->DisplayPos;
+    g_PrevDisplaySize = draw_data->DisplaySize;
+    g_PrevFramebufferScale = draw_data->FramebufferScale;
+    g_PrevCmdLists.resize(draw_data->CmdListsCount);
+    g_PrevCmdListsGenerations.resize(draw_data->CmdListsCount);
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        g_PrevCmdLists[n] = cmd_list;
+        g_PrevCmdListsGenerations[n] = cmd_list->ContentGeneration;
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+            if (cmd_list->CmdBuffer.Data[cmd_i].UserCallback != NULL)
+                unchanged = g_PrevValid = false;
+    }
+    return unchanged;
+}
+
+// Software Render function
+bool    ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data, ImGui_ImplSoftRaster_Texture* target, ImU32 clear_col)
+{
+    if (target == NULL || target->Pixels == NULL || target->Width <= 0 || target->Height <= 0)
+        return false;
+
+    // Glyphs rasterized on demand (ImFontAtlasFlags_DynamicGlyphs) are read directly from the atlas pixels, there is nothing to upload.
+    ImFontAtlas* atlas = ImGui::GetIO().Fonts;
+    if (atlas->TexDirtyRects.Size > 0)
+    {
+        atlas->TexDirtyRects.resize(0);
+        g_PrevValid = false;
+    }
+    if (ImGui_ImplSoftRaster_IsOutputUnchanged(draw_data, target, clear_col))
+        return false;
+
+    // Will project scissor/clipping rectangles into framebuffer space
+    ImGui_ImplSoftRaster_FrameData& fd = g_FrameData;
+    fd.Target = target;
+    fd.ClearCol = clear_col;
+    fd.ClipOff = draw_data->DisplayPos;         // (0,0) unless using multi-viewports
+    fd.ClipScale = draw_data->FramebufferScale; // (1,1) unless using retina display which are often (2,2)
+    fd.TilesCountX = (target->Width + IMGUI_IMPL_SOFTRASTER_TILE_SIZE - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+    const int tiles_count_y = (target->Height + IMGUI_IMPL_SOFTRASTER_TILE_SIZE - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE;
+    const int tiles_count = fd.TilesCountX * tiles_count_y;
+
+    // Collect visible triangles and count them per tile
+    g_Triangles.resize(0);
+    g_TileBinOffsets.resize(tiles_count + 1);
+    memset(g_TileBinOffsets.Data, 0, (size_t)g_TileBinOffsets.size_in_bytes());
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* cmd_list = draw_data->CmdLists[n];
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* pcmd = &cmd_list->CmdBuffer[cmd_i];
+            if (pcmd->UserCallback)
+            {
+                // User callback, registered via ImDrawList::AddCallback()
+                // (ImDrawCallback_ResetRenderState is a special callback value used by the user to request the renderer to reset render state.)
+                if (pcmd->UserCallback != ImDrawCallback_ResetRenderState)
+                    pcmd->UserCallback(cmd_list, pcmd);
+                continue;
+            }
+
+            // Project scissor/clipping rectangles into framebuffer space. Pixels are inside when their center is.
+            const int clip_min_x = ImGui_ImplSoftRaster_Max((int)ceilf((pcmd->ClipRect.x - fd.ClipOff.x) * fd.ClipScale.x - 0.5f), 0);
+            const int clip_min_y = ImGui_ImplSoftRaster_Max((int)ceilf((pcmd->ClipRect.y - fd.ClipOff.y) * fd.ClipScale.y - 0.5f), 0);
+            const int clip_max_x = ImGui_ImplSoftRaster_Min((int)ceilf((pcmd->ClipRect.z - fd.ClipOff.x) * fd.ClipScale.x - 0.5f), target->Width);
+            const int clip_max_y = ImGui_ImplSoftRaster_Min((int)ceilf((pcmd->ClipRect.w - fd.ClipOff.y) * fd.ClipScale.y - 0.5f), target->Height);
+            if (clip_min_x >= clip_max_x || clip_min_y >= clip_max_y)
+                continue;
+
+            const ImDrawVert* vtx_buffer = cmd_list->VtxBuffer.Data + pcmd->VtxOffset;
+            const ImDrawIdx* idx_buffer = cmd_list->IdxBuffer.Data + pcmd->IdxOffset;
+            for (unsigned int elem_n = 0; elem_n + 3 <= pcmd->ElemCount; elem_n += 3)
+            {
+                const ImDrawVert* v0 = &vtx_buffer[idx_buffer[elem_n + 0]];
+                const ImDrawVert* v1 = &vtx_buffer[idx_buffer[elem_n + 1]];
+                const ImDrawVert* v2 = &vtx_buffer[idx_buffer[elem_n + 2]];
+                const float bb_min_x = ImGui_ImplSoftRaster_Min(ImGui_ImplSoftRaster_Min(v0->pos.x, v1->pos.x), v2->pos.x), bb_max_x = ImGui_ImplSoftRaster_Max(ImGui_ImplSoftRaster_Max(v0->pos.x, v1->pos.x), v2->pos.x);
+                const float bb_min_y = ImGui_ImplSoftRaster_Min(ImGui_ImplSoftRaster_Min(v0->pos.y, v1->pos.y), v2->pos.y), bb_max_y = ImGui_ImplSoftRaster_Max(ImGui_ImplSoftRaster_Max(v0->pos.y, v1->pos.y), v2->pos.y);
+                ImGui_ImplSoftRaster_Triangle tri;
+                tri.MinX = ImGui_ImplSoftRaster_Max((int)ImGui_ImplSoftRaster_Max(floorf((bb_min_x - fd.ClipOff.x) * fd.ClipScale.x), -1.0f), clip_min_x);
+                tri.MinY = ImGui_ImplSoftRaster_Max((int)ImGui_ImplSoftRaster_Max(floorf((bb_min_y - fd.ClipOff.y) * fd.ClipScale.y), -1.0f), clip_min_y);
+                tri.MaxX = ImGui_ImplSoftRaster_Min((int)ImGui_ImplSoftRaster_Min(ceilf((bb_max_x - fd.ClipOff.x) * fd.ClipScale.x), (float)target->Width), clip_max_x);
+                tri.MaxY = ImGui_ImplSoftRaster_Min((int)ImGui_ImplSoftRaster_Min(ceilf((bb_max_y - fd.ClipOff.y) * fd.ClipScale.y), (float)target->Height), clip_max_y);
+                if (tri.MinX >= tri.MaxX || tri.MinY >= tri.MaxY)
+                    continue;
+                tri.Vtx[0] = v0;
+                tri.Vtx[1] = v1;
+                tri.Vtx[2] = v2;
+                tri.Texture = (const ImGui_ImplSoftRaster_Texture*)pcmd->TextureId;
+                g_Triangles.push_back(tri);
+                for (int ty = tri.MinY / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty <= (tri.MaxY - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty++)
+                    for (int tx = tri.MinX / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx <= (tri.MaxX - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx++)
+                        g_TileBinOffsets[ty * fd.TilesCountX + tx + 1]++;
+            }
+        }
+    }
+
+    // Fill bins (triangles are visited in order so each bin is sorted)
+    for (int tile_n = 0; tile_n < tiles_count; tile_n++)
+        g_TileBinOffsets[tile_n + 1] += g_TileBinOffsets[tile_n];
+    g_TileBinTriangles.resize(g_TileBinOffsets[tiles_count]);
+    for (int tri_n = 0; tri_n < g_Triangles.Size; tri_n++)
+    {
+        const ImGui_ImplSoftRaster_Triangle& tri = g_Triangles[tri_n];
+        for (int ty = tri.MinY / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty <= (tri.MaxY - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; ty++)
+            for (int tx = tri.MinX / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx <= (tri.MaxX - 1) / IMGUI_IMPL_SOFTRASTER_TILE_SIZE; tx++)
+                g_TileBinTriangles[g_TileBinOffsets[ty * fd.TilesCountX + tx]++] = tri_n;
+    }
+    for (int tile_n = tiles_count; tile_n > 0; tile_n--) // Filling advanced each offset to the start of the next bin: shift them back
+        g_TileBinOffsets[tile_n] = g_TileBinOffsets[tile_n - 1];
+    g_TileBinOffsets[0] = 0;
+
+    // Rasterize tiles
+    if (g_ParallelForFunc != NULL && tiles_count > 1)
+        g_ParallelForFunc(ImGui_ImplSoftRaster_RenderTile, NULL, tiles_count, g_ParallelForUserData);
+    else
+        for (int tile_n = 0; tile_n < tiles_count; tile_n++)
+            ImGui_ImplSoftRaster_RenderTile(NULL, tile_n);
+    return true;
+}
+
+bool ImGui_ImplSoftRaster_CreateFontsTexture()
+{
+    // Build texture atlas. Pixels are sampled directly from the atlas, which needs to keep its texture data (don't call ClearTexData()).
+    ImGuiIO& io = ImGui::GetIO();
+    unsigned char* pixels;
+    int width, height;
+    io.Fonts->GetTexDataAsRGBA32(&pixels, &width, &height);
+    g_FontTexture.Pixels = (ImU32*)(void*)pixels;
+    g_FontTexture.Width = width;
+    g_FontTexture.Height = height;
+
+    // Store our identifier
+    io.Fonts->SetTexID((ImTextureID)&g_FontTexture);
+    g_PrevValid = false;
+    return true;
+}
+
+void ImGui_ImplSoftRaster_DestroyFontsTexture()
+{
+    if (g_FontTexture.Pixels)
+    {
+        ImGuiIO& io = ImGui::GetIO();
+        io.Fonts->SetTexID(0);
+        g_FontTexture.Pixels = NULL;
+        g_FontTexture.Width = g_FontTexture.Height = 0;
+    }
+    g_PrevValid = false;
+}
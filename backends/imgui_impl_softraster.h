@@ -0,0 +1,38 @@
+// dear imgui: Renderer Backend for CPU software rasterization (no GPU required)
+// This needs to be used along with a Platform Backend (e.g. GLFW, SDL, Win32, custom..), or with none at all to render headless
+// (e.g. screenshots and golden-image tests on CI, measuring end-to-end frame cost on server machines).
+
+// Implemented features:
+//  [X] Renderer: User texture binding. Use 'ImGui_ImplSoftRaster_Texture*' as ImTextureID. Read the FAQ about ImTextureID!
+//  [X] Renderer: Support for large meshes (64k+ vertices) with 16-bit indices.
+//  [X] Renderer: Multi-threaded rasterization by tiles, using a parallel-for dispatcher provided by the application.
+//  [X] Renderer: Skip rendering when draw data didn't change since the previous call (uses ImGuiBackendFlags_RendererHasContentHash).
+// Output is identical with or without multi-threading and SSE2.
+// User callbacks (ImDrawList::AddCallback) are called before any triangle of the frame is rasterized.
+
+// You can copy and use unmodified imgui_impl_* files in your project. See examples/ folder for examples of using this.
+// If you are new to Dear ImGui, read documentation from the docs/ folder + read the top of imgui.cpp.
+// Read online: https://github.com/ocornut/imgui/tree/master/docs
+
+#pragma once
+#include "imgui.h"      // IMGUI_IMPL_API
+
+// RGBA32 image, used for the font atlas, for user textures and for the render target.
+// Pixels use the same packing as IM_COL32(). Rows are contiguous.
+struct ImGui_ImplSoftRaster_Texture
+{
+    ImU32*  Pixels;
+    int     Width;
+    int     Height;
+};
+
+// 'parallel_for_func' has the same signature as ImFontAtlas::BuildParallelForFunc, so the same dispatcher can be used for both (NULL to rasterize on the calling thread).
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_Init(ImFontAtlasParallelForFunc parallel_for_func = NULL, void* parallel_for_user_data = NULL);
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_Shutdown();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_NewFrame();
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_RenderDrawData(ImDrawData* draw_data, ImGui_ImplSoftRaster_Texture* target, ImU32 clear_col); // Clear and render into 'target'. Return false if draw data and target didn't change since the previous call: pixels were left untouched.
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_InvalidateOutput();    // Call after modifying the pixels of a user texture, so next render doesn't get skipped.
+
+// Called by Init/NewFrame/Shutdown
+IMGUI_IMPL_API bool     ImGui_ImplSoftRaster_CreateFontsTexture();
+IMGUI_IMPL_API void     ImGui_ImplSoftRaster_DestroyFontsTexture();
@@ -0,0 +1,3 @@
+@REM Build for Visual Studio compiler. Run your copy of vcvars32.bat or vcvarsall.bat to setup command-line compiler.
+mkdir Debug
+cl /nologo /Zi /MD /I ..\.. /I ..\..\backends %* *.cpp ..\..\*.cpp ..\..\backends\imgui_impl_softraster.cpp /FeDebug/example_null_benchmark.exe /FoDebug/ /link gdi32.lib shell32.lib imm32.lib
@@ -0,0 +1,1470 @@
+// dear imgui: "null" benchmark application
+// (compile and link imgui, create context, run scripted scenes headless with NO INPUTS, NO GRAPHICS OUTPUT)
+// Each scene runs in its own context for a fixed number of frames and reports per-phase timings,
+// vertex/index counts and allocation counts as machine-readable output (JSON lines or CSV).
+// This is meant to be run on CI to catch performance regressions in NewFrame()/Render() and the drawing code.
+//
+// Usage:
+//   example_null_benchmark [--frames N] [--warmup N] [--scene NAME] [--csv] [--list] [--micro] [--check-zero-alloc] [--text-size-cache] [--retain-geometry] [--content-hash] [--merged-buffers] [--merge-cmds] [--softraster] [--softraster-mt] [--screenshot PREFIX]
+//
+// Output fields (times are in microseconds, averaged over measured frames, 'max' is the worst frame):
+//   newframe, submit, endframe, render, flatten, upload, raster: time spent in ImGui::NewFrame(), in user code submitting widgets,
+//   in ImGui::EndFrame(), in ImGui::Render(), in ImDrawDataBuilder::FlattenIntoSingleLayer() (replayed over the frame's draw lists),
+//   copying draw lists into the buffers of a simulated renderer (which only copies lists whose ImDrawList::ContentGeneration changed),
+//   and rendering pixels with imgui_impl_softraster (with --softraster).
+//   vtx, idx, cmd_lists, cmds: geometry counts of the last frame.
+//   draw_calls: number of draw commands of the last frame after merging by the simulated renderer (== cmds unless using --merge-cmds).
+//   allocs, frees, alloc_bytes: heap activity per measured frame (after warm-up).
+//   upload_bytes, upload_calls: bytes copied and number of buffer uploads per measured frame by the simulated renderer.
+//   fb_hash: hash of the pixels of the last frame (with --softraster), to compare output across builds and options.
+//   idle_frames: number of measured frames after which io.WaitBeforeNextFrame was > 0 (static scenes should be idle).
+// With --micro, run micro-benchmarks of individual data structures/functions instead of scenes:
+//   one line per variant and problem size with 'ns_per_op' (nanoseconds per operation, best of 3 runs)
+//   and 'checksum' (hash of the output, to verify that optimized code paths produce identical results across builds).
+// With --check-zero-alloc, use ImGui::DebugStartZeroAllocCheck() to verify that no heap allocation is made after warm-up:
+//   offending allocations are printed to stderr (frame, size, category, window) and the exit code is 2.
+// With --text-size-cache, run scenes with io.ConfigTextSizeCache enabled.
+// With --retain-geometry, create the windows of scenes with ImGuiWindowFlags_RetainGeometry (vtx/idx counts should be unchanged).
+// With --content-hash, set ImGuiBackendFlags_RendererHasContentHash so the simulated renderer skips unchanged draw lists.
+//   Its buffers are compared to the draw lists after each frame: any difference is printed to stderr and the exit code is 3.
+// With --merged-buffers, the simulated renderer uploads each frame into a single vertex/index buffer using ImDrawData::MergeBuffers()
+//   (one upload per frame, unchanged lists are not skipped). Merged buffers and commands are verified the same way,
+//   and so is the order of draw list contents spliced by ImDrawList::AddDrawListDeferred().
+// With --merge-cmds, also merge draw commands across draw lists (implies --merged-buffers).
+// With --softraster, render every frame into a 1920x1080 buffer with the software rasterizer backend (--softraster-mt: using worker threads).
+//   With --content-hash as well, the backend skips rendering frames where no draw list changed.
+// With --screenshot PREFIX, write the last frame of each scene to PREFIX<scene>.tga (implies --softraster).
+
+#include "imgui.h"
+#include "imgui_internal.h"     // ImDrawDataBuilder, ImGuiViewportP
+#include "imgui_impl_softraster.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <atomic>
+#include <chrono>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+//-----------------------------------------------------------------------------
+// Helpers: timing, allocation counting
+//-----------------------------------------------------------------------------
+
+static double GetTimeInMicroseconds()
+{
+    using namespace std::chrono;
+    return (double)duration_cast<nanoseconds>(high_resolution_clock::now().time_since_epoch()).count() / 1000.0;
+}
+
+// Atomic as some scenes allocate from worker threads
+struct AllocCounters
+{
+    std::atomic<ImU64>  Allocs;
+    std::atomic<ImU64>  Frees;
+    std::atomic<ImU64>  AllocBytes;
+};
+static AllocCounters g_AllocCounters;
+
+static void* CountingMalloc(size_t size, void* user_data)
+{
+    IM_UNUSED(user_data);
+    g_AllocCounters.Allocs++;
+    g_AllocCounters.AllocBytes += size;
+    return malloc(size);
+}
+
+static void CountingFree(void* ptr, void* user_data)
+{
+    IM_UNUSED(user_data);
+    if (ptr != NULL)
+        g_AllocCounters.Frees++;
+    free(ptr);
+}
+
+//-----------------------------------------------------------------------------
+// Scenes
+//-----------------------------------------------------------------------------
+
+static ImGuiWindowFlags g_SceneWindowFlags = 0;     // Added to the flags of windows created by scenes (--retain-geometry)
+static int              g_SoftRasterMode = 0;       // 0: disabled, 1: --softraster, 2: --softraster-mt
+static const char*      g_ScreenshotPrefix = NULL;  // --screenshot
+static bool             g_MergedBuffers = false;    // --merged-buffers
+static bool             g_MergeCmds = false;        // --merge-cmds
+
+static void SceneText()
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::Begin("Text", NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    for (int n = 0; n < 10000; n++)
+        ImGui::Text("Line %05d: The quick brown fox jumps over the lazy dog.", n);
+    ImGui::End();
+}
+
+static void SceneTable()
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::Begin("Table", NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    const int columns_count = 32;
+    const int rows_count = 2000;
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("table", columns_count, flags))
+    {
+        for (int column_n = 0; column_n < columns_count; column_n++)
+        {
+            char label[16];
+            sprintf(label, "Col %d", column_n);
+            ImGui::TableSetupColumn(label, ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        }
+        ImGui::TableSetupScrollFreeze(1, 1);
+        ImGui::TableHeadersRow();
+        for (int row_n = 0; row_n < rows_count; row_n++)
+        {
+            ImGui::TableNextRow();
+            for (int column_n = 0; column_n < columns_count; column_n++)
+            {
+                ImGui::TableSetColumnIndex(column_n);
+                ImGui::Text("%d,%d", row_n, column_n);
+            }
+        }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+static void SceneTree()
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::Begin("Tree", NULL, ImGuiWindowFlags_NoSavedSettings | ImGuiWindowFlags_HorizontalScrollbar | g_SceneWindowFlags);
+    const int depth = 48;
+    for (int root_n = 0; root_n < 40; root_n++)
+    {
+        int opened_depth = 0;
+        for (int depth_n = 0; depth_n < depth; depth_n++)
+        {
+            ImGui::SetNextItemOpen(true, ImGuiCond_Always);
+            if (!ImGui::TreeNode((void*)(intptr_t)(root_n * depth + depth_n), "Node %d/%d", root_n, depth_n))
+                break;
+            ImGui::BulletText("Leaf");
+            opened_depth++;
+        }
+        while (opened_depth-- > 0)
+            ImGui::TreePop();
+    }
+    ImGui::End();
+}
+
+static void SceneWindows()
+{
+    for (int n = 0; n < 2000; n++)
+    {
+        char name[32];
+        sprintf(name, "Window %d", n);
+        ImGui::SetNextWindowPos(ImVec2((float)((n * 37) % 1800), (float)((n * 53) % 1000)));
+        ImGui::SetNextWindowSize(ImVec2(120, 60));
+        ImGui::Begin(name, NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+        ImGui::Text("Window %d", n);
+        ImGui::End();
+    }
+}
+
+static void SceneDrawList()
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::Begin("DrawList", NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    ImDrawList* draw_list = ImGui::GetWindowDrawList();
+    const ImVec2 p = ImGui::GetCursorScreenPos();
+
+    // Long polylines (thin, thick, closed)
+    static ImVec2 points[2000];
+    for (int n = 0; n < IM_ARRAYSIZE(points); n++)
+        points[n] = ImVec2(p.x + n * 0.9f, p.y + 200.0f + ImSin(n * 0.05f) * 150.0f);
+    draw_list->AddPolyline(points, IM_ARRAYSIZE(points), IM_COL32(255, 255, 0, 255), false, 1.0f);
+    draw_list->AddPolyline(points, IM_ARRAYSIZE(points), IM_COL32(0, 255, 255, 255), false, 4.0f);
+    draw_list->AddPolyline(points, IM_ARRAYSIZE(points), IM_COL32(255, 0, 255, 255), true, 2.5f);
+    draw_list->AddConvexPolyFilled(points, 500, IM_COL32(255, 255, 255, 64));
+
+    // Path API: arcs, beziers, rounded rectangles
+    for (int n = 0; n < 400; n++)
+    {
+        const ImVec2 c(p.x + (n % 40) * 45.0f + 20.0f, p.y + 420.0f + (n / 40) * 45.0f);
+        draw_list->PathArcTo(c, 18.0f, 0.0f, IM_PI * 1.5f);
+        draw_list->PathBezierCubicCurveTo(ImVec2(c.x + 10, c.y - 20), ImVec2(c.x - 10, c.y + 20), ImVec2(c.x + 5, c.y + 5));
+        draw_list->PathStroke(IM_COL32(255, 128, 0, 255), false, 1.5f);
+        draw_list->AddRect(ImVec2(c.x - 20, c.y - 20), ImVec2(c.x + 20, c.y + 20), IM_COL32(0, 255, 0, 255), 6.0f, ImDrawCornerFlags_All, 1.0f);
+        draw_list->AddCircleFilled(c, 6.0f, IM_COL32(0, 0, 255, 255));
+    }
+    ImGui::End();
+}
+
+// Same kind of heavy custom drawing as SceneDrawList(), split over many child windows and recorded by worker threads
+// into detached draw lists, which are spliced into the child windows with ImDrawList::AddDrawListDeferred().
+static ImVector<ImDrawList*> g_ThreadedDrawLists;
+
+static void RecordThreadedWidget(ImDrawList* draw_list, const ImVec2& p, const ImVec2& size, ImFont* font, float font_size, int seed)
+{
+    ImVec2 points[200];
+    for (int n = 0; n < IM_ARRAYSIZE(points); n++)
+        points[n] = ImVec2(p.x + n * size.x / IM_ARRAYSIZE(points), p.y + size.y * 0.5f + ImSin((n + seed) * 0.1f) * size.y * 0.4f);
+    draw_list->AddPolyline(points, IM_ARRAYSIZE(points), IM_COL32(255, 255, 0, 255), false, 1.0f);
+    draw_list->AddPolyline(points, IM_ARRAYSIZE(points), IM_COL32(0, 255, 255, 255), false, 3.0f);
+    for (int n = 0; n < 40; n++)
+    {
+        const ImVec2 c(p.x + (n % 10) * size.x / 10 + 10.0f, p.y + (n / 10) * size.y / 4 + 10.0f);
+        draw_list->AddCircle(c, 8.0f, IM_COL32(255, 128, 0, 255), 0, 1.5f);
+        draw_list->AddRectFilled(ImVec2(c.x - 3, c.y - 3), ImVec2(c.x + 3, c.y + 3), IM_COL32(0, 0, 255, 255), 2.0f);
+    }
+    char buf[32];
+    ImFormatString(buf, IM_ARRAYSIZE(buf), "Widget %d", seed);
+    draw_list->AddText(font, font_size, p, IM_COL32_WHITE, buf);
+}
+
+static void SceneDrawListThreaded()
+{
+    const int columns = 8, rows = 8;
+    const ImVec2 widget_size(1920.0f / columns, 1080.0f / rows);
+    if (g_ThreadedDrawLists.empty())
+        for (int n = 0; n < columns * rows; n++)
+            g_ThreadedDrawLists.push_back(IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData()));
+
+    // Prepare draw lists on the main thread
+    for (int n = 0; n < g_ThreadedDrawLists.Size; n++)
+    {
+        ImDrawList* draw_list = g_ThreadedDrawLists[n];
+        draw_list->_ResetForNewFrame();
+        draw_list->PushClipRectFullScreen();
+        draw_list->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    }
+
+    // Record on worker threads (spawning threads every frame is part of the measured cost, a real application would use a job system)
+    ImFont* font = ImGui::GetFont();
+    const float font_size = ImGui::GetFontSize();
+    const int workers_count = ImClamp((int)std::thread::hardware_concurrency(), 1, 8);
+    std::thread workers[8];
+    for (int worker_n = 0; worker_n < workers_count; worker_n++)
+        workers[worker_n] = std::thread([=]()
+        {
+            for (int n = worker_n; n < g_ThreadedDrawLists.Size; n += workers_count)
+                RecordThreadedWidget(g_ThreadedDrawLists[n], ImVec2((n % columns) * widget_size.x, (n / columns) * widget_size.y), widget_size, font, font_size, n);
+        });
+
+    // Meanwhile, submit windows on the main thread
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::PushStyleVar(ImGuiStyleVar_WindowPadding, ImVec2(0, 0));
+    ImGui::Begin("DrawList Threaded", NULL, ImGuiWindowFlags_NoDecoration | ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    for (int n = 0; n < g_ThreadedDrawLists.Size; n++)
+    {
+        ImGui::SetCursorScreenPos(ImVec2((n % columns) * widget_size.x, (n / columns) * widget_size.y));
+        ImGui::BeginChild(n + 1, widget_size);
+        ImGui::GetWindowDrawList()->AddDrawListDeferred(g_ThreadedDrawLists[n]);
+        ImGui::EndChild();
+    }
+    ImGui::End();
+    ImGui::PopStyleVar();
+
+    // Draw lists need to be complete before ImGui::Render()
+    for (int worker_n = 0; worker_n < workers_count; worker_n++)
+        workers[worker_n].join();
+}
+
+static void SceneDrawListThreadedShutdown()
+{
+    for (int n = 0; n < g_ThreadedDrawLists.Size; n++)
+        IM_DELETE(g_ThreadedDrawLists[n]);
+    g_ThreadedDrawLists.clear();
+}
+
+static void SceneHash()
+{
+    // Stress ID hashing (ImHashStr/ImHashData) with typical labels, PushID/GetID patterns and ### overrides
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::Begin("Hash", NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    static const char* labels[] = { "OK", "Cancel##dialog", "Enable Shadows", "Some Longer Widget Label With Words", "Display Name###stable_id" };
+    ImGuiID acc = 0;
+    for (int n = 0; n < 20000; n++)
+    {
+        ImGui::PushID(n);
+        for (int label_n = 0; label_n < IM_ARRAYSIZE(labels); label_n++)
+            acc += ImGui::GetID(labels[label_n]);
+        acc += ImGui::GetID((void*)(intptr_t)n);
+        ImGui::PopID();
+    }
+    ImGui::Text("Hash accumulator: %08X", acc);
+    ImGui::End();
+}
+
+// Scroll through a 1500 columns x 100K rows table, only submitting visible rows (ImGuiListClipper) and columns (TableNextVisibleColumn)
+static void SceneTableWide()
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::Begin("Wide Table", NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    const int columns_count = 1500;
+    const int rows_count = 100000;
+    const ImGuiTableFlags flags = ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_Resizable | ImGuiTableFlags_Reorderable | ImGuiTableFlags_Hideable | ImGuiTableFlags_ScrollX | ImGuiTableFlags_ScrollY;
+    if (ImGui::BeginTable("table_wide", columns_count, flags))
+    {
+        for (int column_n = 0; column_n < columns_count; column_n++)
+        {
+            char label[16];
+            sprintf(label, "Col %d", column_n);
+            ImGui::TableSetupColumn(label, ImGuiTableColumnFlags_WidthFixed, 80.0f);
+        }
+        ImGui::TableSetupScrollFreeze(1, 1);
+        // Jump between a fixed set of scroll positions: the default warm-up covers the whole cycle, so draw channels have seen
+        // the contents of every position and the measured frames reach a steady state (no buffer growth, see --check-zero-alloc).
+        static const ImVec2 scroll_ratios[] = { ImVec2(0.00f, 0.00f), ImVec2(0.73f, 0.41f), ImVec2(0.21f, 0.97f), ImVec2(0.94f, 0.18f), ImVec2(0.48f, 0.62f), ImVec2(1.00f, 1.00f) };
+        const ImVec2 scroll_ratio = scroll_ratios[ImGui::GetFrameCount() % IM_ARRAYSIZE(scroll_ratios)];
+        ImGui::SetScrollX(ImGui::GetScrollMaxX() * scroll_ratio.x);
+        ImGui::SetScrollY(ImGui::GetScrollMaxY() * scroll_ratio.y);
+        ImGui::TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(rows_count);
+        while (clipper.Step())
+            for (int row_n = clipper.DisplayStart; row_n < clipper.DisplayEnd; row_n++)
+            {
+                ImGui::TableNextRow();
+                while (ImGui::TableNextVisibleColumn())
+                    ImGui::Text("%d,%d", row_n, ImGui::TableGetColumnIndex());
+            }
+        ImGui::EndTable();
+    }
+    ImGui::End();
+}
+
+// Jump through a list of 1M items with variable heights, only submitting the visible items
+static ImGuiListItemHeights g_ClipperItemHeights;
+
+static void SceneClipperVariable()
+{
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::Begin("Clipper", NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    ImGui::SetScrollY(ImGui::GetScrollMaxY() * (float)((ImGui::GetFrameCount() * 7919) % 1000) / 1000.0f);
+    ImGui::PushTextWrapPos(600.0f);
+    ImGuiListClipper clipper;
+    clipper.BeginVariableHeights(1000000, &g_ClipperItemHeights);
+    while (clipper.Step())
+        for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+        {
+            if (n % 7 == 0)
+                ImGui::TextWrapped("Item %d: The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog.", n);
+            else
+                ImGui::Text("Item %d", n);
+        }
+    ImGui::PopTextWrapPos();
+    ImGui::End();
+}
+
+static void SceneClipperVariableShutdown()
+{
+    g_ClipperItemHeights.Clear();
+}
+
+// Type into a 4 MB document (64K lines) in InputTextMultiline, one character per frame at the start of the text
+static ImVector<char> g_LargeDocument;
+
+static int LargeDocumentResizeCallback(ImGuiInputTextCallbackData* data)
+{
+    if (data->EventFlag == ImGuiInputTextFlags_CallbackResize)
+    {
+        g_LargeDocument.resize(data->BufSize);
+        data->Buf = g_LargeDocument.Data;
+    }
+    return 0;
+}
+
+static void LargeDocumentInit()
+{
+    if (!g_LargeDocument.empty())
+        return;
+    ImGuiTextBuffer text;
+    for (int n = 0; n < 64000; n++)
+        text.appendf("[%06d] INFO  worker %d: processed request %08X in %d ms, caf\xC3\xA9 \xE4\xB8\xAD\xE6\x96\x87\n", n, n % 16, (unsigned int)n * 2654435761u, (n * 7) % 100);
+    g_LargeDocument.resize(text.size() + 1);
+    memcpy(g_LargeDocument.Data, text.c_str(), (size_t)text.size() + 1);
+}
+
+static void SceneInputTextLarge()
+{
+    LargeDocumentInit();
+
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::Begin("Large Document", NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    const int frame_count = ImGui::GetFrameCount();
+    if (frame_count == 1)
+        ImGui::SetKeyboardFocusHere();
+    else
+        ImGui::GetIO().AddInputCharacter((frame_count % 40) == 0 ? '\n' : (unsigned int)('a' + frame_count % 26));
+    ImGui::InputTextMultiline("##document", g_LargeDocument.Data, (size_t)g_LargeDocument.Size, ImVec2(-FLT_MIN, -FLT_MIN), ImGuiInputTextFlags_CallbackResize, LargeDocumentResizeCallback);
+    ImGui::End();
+}
+
+static void SceneInputTextLargeShutdown()
+{
+    g_LargeDocument.clear();
+}
+
+// Replace the whole 4 MB document by a single character (CTRL+A, type), then undo/redo this edit on alternate frames
+static void SceneInputTextUndo()
+{
+    LargeDocumentInit();
+
+    ImGuiIO& io = ImGui::GetIO();
+    const int frame_count = ImGui::GetFrameCount();
+    io.KeyMap[ImGuiKey_A] = ImGuiKey_A;
+    io.KeyMap[ImGuiKey_Z] = ImGuiKey_Z;
+    io.KeyMap[ImGuiKey_Y] = ImGuiKey_Y;
+    io.KeyCtrl = (frame_count == 3 || frame_count >= 5);
+    io.KeyMods = io.KeyCtrl ? ImGuiKeyModFlags_Ctrl : ImGuiKeyModFlags_None;
+    io.KeysDown[ImGuiKey_A] = (frame_count == 2); // Read on next frame
+    io.KeysDown[ImGuiKey_Z] = (frame_count >= 4 && (frame_count & 1) == 0);
+    io.KeysDown[ImGuiKey_Y] = (frame_count >= 4 && (frame_count & 1) == 1);
+
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::Begin("Large Document", NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    if (frame_count == 1)
+        ImGui::SetKeyboardFocusHere();
+    else if (frame_count == 4)
+        io.AddInputCharacter('x');
+    ImGui::InputTextMultiline("##document", g_LargeDocument.Data, (size_t)g_LargeDocument.Size, ImVec2(-FLT_MIN, -FLT_MIN), ImGuiInputTextFlags_CallbackResize, LargeDocumentResizeCallback);
+    ImGui::End();
+}
+
+// Page down through a 1M lines read-only document in InputTextMultiline, the widget being active
+static ImVector<char> g_LinesDocument;
+
+static void SceneInputTextScroll()
+{
+    if (g_LinesDocument.empty())
+    {
+        ImGuiTextBuffer text;
+        for (int n = 0; n < 1000000; n++)
+            text.appendf("%07d\n", n); // Same width for all lines: every page renders the same amount of vertices, so buffers reach steady state
+        g_LinesDocument.resize(text.size() + 1);
+        memcpy(g_LinesDocument.Data, text.c_str(), (size_t)text.size() + 1);
+    }
+
+    ImGuiIO& io = ImGui::GetIO();
+    const int frame_count = ImGui::GetFrameCount();
+    io.KeyMap[ImGuiKey_PageDown] = ImGuiKey_PageDown;
+    io.KeysDown[ImGuiKey_PageDown] = (frame_count > 1 && (frame_count & 1)); // Read on next frame
+
+    ImGui::SetNextWindowPos(ImVec2(0, 0));
+    ImGui::SetNextWindowSize(ImVec2(1920, 1080));
+    ImGui::Begin("Lines Document", NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    if (frame_count == 1)
+        ImGui::SetKeyboardFocusHere();
+    ImGui::InputTextMultiline("##document", g_LinesDocument.Data, (size_t)g_LinesDocument.Size, ImVec2(-FLT_MIN, -FLT_MIN), ImGuiInputTextFlags_ReadOnly);
+    ImGui::End();
+}
+
+static void SceneInputTextScrollShutdown()
+{
+    g_LinesDocument.clear();
+}
+
+static void SceneDemo()
+{
+    ImGui::ShowDemoWindow(NULL);
+    ImGui::ShowMetricsWindow(NULL);
+    ImGui::SetNextWindowPos(ImVec2(1200, 20));
+    ImGui::Begin("Style Editor", NULL, ImGuiWindowFlags_NoSavedSettings | g_SceneWindowFlags);
+    ImGui::ShowStyleEditor();
+    ImGui::End();
+}
+
+struct Scene
+{
+    const char* Name;
+    void        (*Func)();
+    void        (*Shutdown)();  // Optional, called before destroying the context
+};
+
+static const Scene g_Scenes[] =
+{
+    { "text",             SceneText,             NULL },
+    { "table",            SceneTable,            NULL },
+    { "table_wide",       SceneTableWide,        NULL },
+    { "tree",             SceneTree,             NULL },
+    { "windows",          SceneWindows,          NULL },
+    { "drawlist",         SceneDrawList,         NULL },
+    { "drawlist_mt",      SceneDrawListThreaded, SceneDrawListThreadedShutdown },
+    { "hash",             SceneHash,             NULL },
+    { "clipper_variable", SceneClipperVariable,  SceneClipperVariableShutdown },
+    { "inputtext_large",  SceneInputTextLarge,   SceneInputTextLargeShutdown },
+    { "inputtext_scroll", SceneInputTextScroll,  SceneInputTextScrollShutdown },
+    { "inputtext_undo",   SceneInputTextUndo,    SceneInputTextLargeShutdown },
+    { "demo",             SceneDemo,             NULL },
+};
+
+//-----------------------------------------------------------------------------
+// Micro-benchmarks
+//-----------------------------------------------------------------------------
+
+// 'checksum' is a hash of the benchmark output, which can be compared between builds (e.g. with or without IMGUI_DISABLE_SSE)
+static void PrintMicroResult(const char* bench_name, const char* variant, int n, double ns_per_op, ImU32 checksum, bool csv)
+{
+    if (csv)
+        printf("%s,%s,%d,%.2f,%08X\n", bench_name, variant, n, ns_per_op, checksum);
+    else
+        printf("{\"bench\":\"%s\",\"variant\":\"%s\",\"n\":%d,\"ns_per_op\":%.2f,\"checksum\":\"%08X\"}\n", bench_name, variant, n, ns_per_op, checksum);
+}
+
+// ImGuiStorage: insert + lookup of N random keys, sorted vector vs hash index
+static void MicroStorage(bool csv)
+{
+    const int sizes[] = { 1000, 100000, 1000000 };
+    for (int size_n = 0; size_n < IM_ARRAYSIZE(sizes); size_n++)
+    {
+        const int count = sizes[size_n];
+        ImVector<ImGuiID> keys;
+        keys.resize(count);
+        for (int n = 0; n < count; n++)
+            keys[n] = ImHashData(&n, sizeof(n));
+
+        for (int mode = 0; mode < 2; mode++)
+        {
+            const bool use_hash_index = (mode == 1);
+            if (!use_hash_index && count > 100000)
+                continue; // Sorted insertion is O(N) per key: 1M keys would take minutes.
+            double best_insert = 0.0, best_lookup = 0.0;
+            ImU32 checksum = 0;
+            for (int run = 0; run < 3; run++)
+            {
+                ImGuiStorage storage;
+                storage.SetUseHashIndex(use_hash_index);
+                double t0 = GetTimeInMicroseconds();
+                for (int n = 0; n < count; n++)
+                    storage.SetInt(keys[n], n);
+                double t1 = GetTimeInMicroseconds();
+                ImU32 acc = 0;
+                for (int n = 0; n < count; n++)
+                    acc += (ImU32)storage.GetInt(keys[n]);
+                double t2 = GetTimeInMicroseconds();
+                checksum = acc;
+                if (run == 0 || t1 - t0 < best_insert)
+                    best_insert = t1 - t0;
+                if (run == 0 || t2 - t1 < best_lookup)
+                    best_lookup = t2 - t1;
+            }
+            PrintMicroResult("storage", use_hash_index ? "hash_insert" : "sorted_insert", count, best_insert * 1000.0 / count, checksum, csv);
+            PrintMicroResult("storage", use_hash_index ? "hash_lookup" : "sorted_lookup", count, best_lookup * 1000.0 / count, checksum, csv);
+        }
+    }
+}
+
+// ImDrawList::AddPolyline(): anti-aliased thin/thick/textured lines and non anti-aliased lines over 50k points
+static void MicroPolyline(bool csv)
+{
+    struct Variant { const char* Name; float Thickness; bool Closed; ImDrawListFlags Flags; };
+    const Variant variants[] =
+    {
+        { "aa_thin",        1.0f, false, ImDrawListFlags_AntiAliasedLines },
+        { "aa_thin_closed", 1.0f, true,  ImDrawListFlags_AntiAliasedLines },
+        { "aa_thick",       3.5f, false, ImDrawListFlags_AntiAliasedLines },
+        { "aa_textured",    3.0f, false, ImDrawListFlags_AntiAliasedLines | ImDrawListFlags_AntiAliasedLinesUseTex },
+        { "no_aa",          2.0f, false, ImDrawListFlags_None },
+    };
+    const int points_count = 50000; // With 16-bit ImDrawIdx the indices will wrap around, which doesn't matter for measuring
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    ImGui::NewFrame();
+
+    ImVector<ImVec2> points;
+    points.resize(points_count);
+    for (int n = 0; n < points_count; n++)
+        points[n] = ImVec2(n * 0.03f, 500.0f + ImSin(n * 0.05f) * 300.0f + ImCos(n * 0.013f) * 100.0f);
+
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    for (int variant_n = 0; variant_n < IM_ARRAYSIZE(variants); variant_n++)
+    {
+        const Variant& variant = variants[variant_n];
+        double best_time = 0.0;
+        ImU32 checksum = 0;
+        for (int run = 0; run < 3; run++)
+        {
+            draw_list._ResetForNewFrame();
+            draw_list.Flags = variant.Flags;
+            draw_list.PushClipRectFullScreen();
+            draw_list.PushTextureID(io.Fonts->TexID);
+            double t0 = GetTimeInMicroseconds();
+            draw_list.AddPolyline(points.Data, points.Size, IM_COL32(255, 255, 0, 255), variant.Closed, variant.Thickness);
+            double t1 = GetTimeInMicroseconds();
+            if (run == 0 || t1 - t0 < best_time)
+                best_time = t1 - t0;
+            checksum = ImHashData(draw_list.VtxBuffer.Data, (size_t)draw_list.VtxBuffer.size_in_bytes());
+            checksum = ImHashData(draw_list.IdxBuffer.Data, (size_t)draw_list.IdxBuffer.size_in_bytes(), checksum);
+        }
+        PrintMicroResult("polyline", variant.Name, points_count, best_time * 1000.0 / points_count, checksum, csv);
+    }
+    draw_list._ClearFreeMemory();
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+}
+
+// Minimal ImFontAtlas::BuildParallelForFunc implementation (a real application would use its job system)
+static void ParallelForThreads(ImFontAtlasJobFunc job_func, void* job_data, int jobs_count, void* user_data)
+{
+    IM_UNUSED(user_data);
+    std::atomic<int> next_job(0);
+    const int workers_count = ImClamp((int)std::thread::hardware_concurrency(), 1, 8);
+    std::thread workers[8];
+    for (int worker_n = 0; worker_n < workers_count; worker_n++)
+        workers[worker_n] = std::thread([&]()
+        {
+            for (int job_n = next_job++; job_n < jobs_count; job_n = next_job++)
+                job_func(job_data, job_n);
+        });
+    for (int worker_n = 0; worker_n < workers_count; worker_n++)
+        workers[worker_n].join();
+}
+
+// ImFontAtlas::Build() of a font with large ranges, baking every glyph vs ImFontAtlasFlags_DynamicGlyphs,
+// then cost per glyph of rasterizing all glyphs on demand. Requires misc/fonts/Roboto-Medium.ttf (run from repository root or from this folder).
+static void MicroFontAtlas(bool csv)
+{
+    const char* font_filenames[] = { "misc/fonts/Roboto-Medium.ttf", "../../misc/fonts/Roboto-Medium.ttf" };
+    const char* font_filename = NULL;
+    for (int n = 0; n < IM_ARRAYSIZE(font_filenames) && font_filename == NULL; n++)
+        if (ImFileHandle f = ImFileOpen(font_filenames[n], "rb"))
+        {
+            ImFileClose(f);
+            font_filename = font_filenames[n];
+        }
+    if (font_filename == NULL)
+        return;
+
+    static const ImWchar ranges[] = { 0x0020, 0xFFFF, 0 };
+    static const char* mode_names[] = { "static_build", "static_build_mt", "dynamic_build", "cache_load" };
+    ImVector<unsigned char> cache_data;
+    for (int mode = 0; mode < IM_ARRAYSIZE(mode_names); mode++)
+    {
+        const bool dynamic_glyphs = (mode == 2);
+        double best_build = 0.0, best_load = 0.0;
+        int glyphs_built = 0, glyphs_loaded = 0;
+        ImU32 checksum = 0;
+        for (int run = 0; run < 3; run++)
+        {
+            ImFontAtlas atlas;
+            if (dynamic_glyphs)
+                atlas.Flags |= ImFontAtlasFlags_DynamicGlyphs;
+            if (mode == 1)
+                atlas.BuildParallelForFunc = ParallelForThreads;
+            ImFont* font = atlas.AddFontFromFileTTF(font_filename, 20.0f, NULL, ranges);
+            if (mode == 3 && cache_data.empty())
+            {
+                ImFontAtlas atlas_src;
+                atlas_src.AddFontFromFileTTF(font_filename, 20.0f, NULL, ranges);
+                atlas_src.Build();
+                atlas_src.SaveBuildCacheToMemory(&cache_data);
+            }
+            double t0 = GetTimeInMicroseconds();
+            if (mode == 3)
+                atlas.LoadBuildCacheFromMemory(cache_data.Data, (size_t)cache_data.Size);
+            else
+                atlas.Build();
+            double t1 = GetTimeInMicroseconds();
+            glyphs_built = font->Glyphs.Size;
+
+            // Request every glyph once (as RenderText() would do) then rasterize them
+            for (int c = 0; c < font->IndexLookup.Size; c++)
+                font->FindGlyph((ImWchar)c);
+            double t2 = GetTimeInMicroseconds();
+            atlas.UpdateGlyphCache();
+            double t3 = GetTimeInMicroseconds();
+            glyphs_loaded = font->Glyphs.Size - glyphs_built;
+
+            checksum = ImHashData(atlas.TexPixelsAlpha8, (size_t)(atlas.TexWidth * atlas.TexHeight));
+            if (run == 0 || t1 - t0 < best_build)
+                best_build = t1 - t0;
+            if (run == 0 || t3 - t2 < best_load)
+                best_load = t3 - t2;
+        }
+        PrintMicroResult("font_atlas", mode_names[mode], glyphs_built, best_build * 1000.0, checksum, csv);
+        if (dynamic_glyphs)
+            PrintMicroResult("font_atlas", "dynamic_load_glyph", glyphs_loaded, glyphs_loaded > 0 ? best_load * 1000.0 / glyphs_loaded : 0.0, checksum, csv);
+    }
+}
+
+// ImFont::RenderText(): 200 lines of log-like text per call, glyphs partially clipped on the right and bottom edges
+static void MicroRenderText(bool csv)
+{
+    struct Variant { const char* Name; bool Utf8; float WrapWidth; bool FineClip; };
+    const Variant variants[] =
+    {
+        { "ascii",           false, 0.0f,   false },
+        { "ascii_fine_clip", false, 0.0f,   true  },
+        { "ascii_wrapped",   false, 500.0f, false },
+        { "utf8_mixed",      true,  0.0f,   false },
+    };
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+    ImGui::NewFrame();
+    ImFont* font = ImGui::GetFont();
+
+    ImDrawList draw_list(ImGui::GetDrawListSharedData());
+    for (int variant_n = 0; variant_n < IM_ARRAYSIZE(variants); variant_n++)
+    {
+        const Variant& variant = variants[variant_n];
+        ImGuiTextBuffer text;
+        for (int line_n = 0; line_n < 200; line_n++)
+            text.appendf("[%08.3f] %s: worker %d processed request #%d in %d us, status=OK (%s)\n", line_n * 0.0137f, (line_n % 3) ? "INFO" : "WARN", line_n % 7, line_n * 31, (line_n * 7919) % 10000,
+                variant.Utf8 && (line_n % 2) ? "r\xC3\xA9sum\xC3\xA9 na\xC3\xAFve caf\xC3\xA9" : "cache hit, no retry");
+        const ImVec4 clip_rect(0.0f, 0.0f, 700.5f, 200 * ImGui::GetFontSize() - 6.5f);
+
+        double best_time = 0.0;
+        ImU32 checksum = 0;
+        for (int run = 0; run < 10; run++)
+        {
+            // Reset the draw list on every call so its buffers stay in cache and we measure RenderText() rather than memory bandwidth
+            double t0 = GetTimeInMicroseconds();
+            for (int n = 0; n < 10; n++)
+            {
+                draw_list._ResetForNewFrame();
+                draw_list.PushClipRectFullScreen();
+                draw_list.PushTextureID(io.Fonts->TexID);
+                font->RenderText(&draw_list, ImGui::GetFontSize(), ImVec2(0.0f, 0.0f), IM_COL32(255, 255, 255, 255), clip_rect, text.begin(), text.end(), variant.WrapWidth, variant.FineClip);
+            }
+            double t1 = GetTimeInMicroseconds();
+            if (run == 0 || t1 - t0 < best_time)
+                best_time = t1 - t0;
+            checksum = ImHashData(draw_list.VtxBuffer.Data, (size_t)draw_list.VtxBuffer.size_in_bytes());
+            checksum = ImHashData(draw_list.IdxBuffer.Data, (size_t)draw_list.IdxBuffer.size_in_bytes(), checksum);
+        }
+        const int chars_count = text.size() * 10;
+        PrintMicroResult("render_text", variant.Name, chars_count, best_time * 1000.0 / chars_count, checksum, csv);
+    }
+    draw_list._ClearFreeMemory();
+
+    ImGui::EndFrame();
+    ImGui::DestroyContext();
+}
+
+// ImTextStrFromUtf8(), ImTextCountCharsFromUtf8(), ImTextStrToUtf8(), ImTextCountUtf8BytesFromStr() and ImTextCharFromUtf8() over 1 MB of text
+// The 'invalid' corpus has random bytes (invalid/truncated sequences, no zero), its checksum verifies that all code paths handle errors the same way.
+static void MicroUtf8(bool csv)
+{
+    const char* corpus_names[] = { "ascii", "latin1", "cjk", "invalid" };
+    const char* corpus_lines[] =
+    {
+        "[INFO] worker 3 processed request #4127 in 83 us, status=OK (cache hit, no retry)\n",
+        "Le caf\xC3\xA9 \xC3\xA0 c\xC3\xB4t\xC3\xA9 de l'h\xC3\xB4tel, o\xC3\xB9 l'on d\xC3\xA9gustait une cr\xC3\xA8me br\xC3\xBBl\xC3\xA9\x65 na\xC3\xAFve.\n",
+        "\xE4\xB8\xAD\xE6\x96\x87\xE6\x96\x87\xE6\x9C\xAC\xE7\xBC\x96\xE8\xBE\x91\xE5\x99\xA8\xEF\xBC\x8C\xE6\x97\xA5\xE6\x9C\xAC\xE8\xAA\x9E\xE3\x81\xAE\xE3\x83\x86\xE3\x82\xAD\xE3\x82\xB9\xE3\x83\x88\xE3\x80\x82\n",
+        NULL,
+    };
+    const int text_size = 1024 * 1024;
+    for (int corpus_n = 0; corpus_n < IM_ARRAYSIZE(corpus_names); corpus_n++)
+    {
+        ImVector<char> text;
+        text.reserve(text_size + 256);
+        ImU32 rand_state = 0x12345678;
+        while (text.Size < text_size)
+        {
+            if (const char* line = corpus_lines[corpus_n])
+            {
+                const int line_len = (int)strlen(line);
+                text.resize(text.Size + line_len);
+                memcpy(text.Data + text.Size - line_len, line, (size_t)line_len);
+                continue;
+            }
+            rand_state = rand_state * 1664525u + 1013904223u;
+            text.push_back((char)(1 + (rand_state >> 24) % 255));
+        }
+        text.push_back(0);
+        const char* text_begin = text.Data;
+        const char* text_end = text.Data + text.Size - 1;
+
+        ImVector<ImWchar> text_w;
+        text_w.resize(text.Size);
+        ImVector<char> text_a;
+        text_a.resize(text.Size * 3);
+
+        enum { Variant_Decode, Variant_CountChars, Variant_Encode, Variant_CountBytes, Variant_DecodeChar, Variant_COUNT };
+        const char* variant_names[Variant_COUNT] = { "decode", "count_chars", "encode", "count_bytes", "decode_char" };
+        const int chars_count = ImTextStrFromUtf8(text_w.Data, text_w.Size, text_begin, text_end);
+        for (int variant_n = 0; variant_n < Variant_COUNT; variant_n++)
+        {
+            double best_time = 0.0;
+            ImU32 checksum = 0;
+            for (int run = 0; run < 3; run++)
+            {
+                int result = 0;
+                ImU32 acc = 0;
+                double t0 = GetTimeInMicroseconds();
+                switch (variant_n)
+                {
+                case Variant_Decode:        result = ImTextStrFromUtf8(text_w.Data, text_w.Size, text_begin, text_end); break;
+                case Variant_CountChars:    result = ImTextCountCharsFromUtf8(text_begin, text_end); break;
+                case Variant_Encode:        result = ImTextStrToUtf8(text_a.Data, text_a.Size, text_w.Data, text_w.Data + chars_count); break;
+                case Variant_CountBytes:    result = ImTextCountUtf8BytesFromStr(text_w.Data, text_w.Data + chars_count); break;
+                case Variant_DecodeChar:
+                    for (const char* s = text_begin; s < text_end; )
+                    {
+                        unsigned int c;
+                        s += ImTextCharFromUtf8(&c, s, text_end);
+                        acc = acc * 31 + c;
+                    }
+                    break;
+                }
+                double t1 = GetTimeInMicroseconds();
+                if (run == 0 || t1 - t0 < best_time)
+                    best_time = t1 - t0;
+                checksum = (ImU32)result + acc;
+                if (variant_n == Variant_Decode)
+                    checksum = ImHashData(text_w.Data, (size_t)result * sizeof(ImWchar), checksum);
+                else if (variant_n == Variant_Encode)
+                    checksum = ImHashData(text_a.Data, (size_t)result, checksum);
+            }
+            char variant_name[64];
+            ImFormatString(variant_name, IM_ARRAYSIZE(variant_name), "%s_%s", variant_names[variant_n], corpus_names[corpus_n]);
+            PrintMicroResult("utf8", variant_name, text.Size - 1, best_time * 1000.0 / (text.Size - 1), checksum, csv);
+        }
+    }
+}
+
+// ImGuiTextFilter over the lines of a 500K lines log: testing every line (what a log window does every frame without caching results),
+// building an ImGuiTextFilterIndex after the filter changed, and updating it when 100 lines are added (per line) / when nothing changed (per call).
+struct MicroTextFilterLog
+{
+    ImGuiTextBuffer Buf;
+    ImVector<int>   LineOffsets;
+};
+
+static void MicroTextFilterGetLine(void* data, int idx, const char** out_text, const char** out_text_end)
+{
+    const MicroTextFilterLog* log = (const MicroTextFilterLog*)data;
+    *out_text = log->Buf.begin() + log->LineOffsets[idx];
+    *out_text_end = log->Buf.begin() + log->LineOffsets[idx + 1] - 1;
+}
+
+static void MicroTextFilter(bool csv)
+{
+    const int lines_count = 500000;
+    const int lines_added = 100;
+    static const char* levels[] = { "INFO", "DEBUG", "WARNING", "ERROR" };
+    static const char* messages[] = { "processed request, status=OK (cache hit)", "connection to server timed out, retrying", "loaded asset 'textures/terrain.png'", "Frame took longer than expected" };
+    MicroTextFilterLog log;
+    log.LineOffsets.push_back(0);
+    ImU32 rand_state = 0x12345678;
+    for (int n = 0; n < lines_count + lines_added; n++)
+    {
+        rand_state = rand_state * 1664525u + 1013904223u;
+        log.Buf.appendf("[%05d] [%s] worker %d: %s (%d us)\n", n, levels[(rand_state >> 8) % 4], (int)((rand_state >> 12) % 16), messages[(rand_state >> 16) % 4], (int)((rand_state >> 20) % 1000));
+        log.LineOffsets.push_back(log.Buf.size());
+    }
+
+    ImGuiTextFilter filter("TIMED OUT,-worker 3:");
+    enum { Variant_PassFilter, Variant_IndexBuild, Variant_IndexAppend, Variant_IndexUnchanged, Variant_COUNT };
+    const char* variant_names[Variant_COUNT] = { "pass_filter", "index_build", "index_append", "index_unchanged" };
+    for (int variant_n = 0; variant_n < Variant_COUNT; variant_n++)
+    {
+        double best_time = 0.0;
+        ImU32 checksum = 0;
+        for (int run = 0; run < 5; run++)
+        {
+            ImGuiTextFilterIndex index;
+            if (variant_n == Variant_IndexAppend || variant_n == Variant_IndexUnchanged)
+                index.Update(filter, lines_count, MicroTextFilterGetLine, &log);
+            int passed = 0;
+            double t0 = GetTimeInMicroseconds();
+            switch (variant_n)
+            {
+            case Variant_PassFilter:
+                for (int n = 0; n < lines_count; n++)
+                {
+                    const char* line;
+                    const char* line_end;
+                    MicroTextFilterGetLine(&log, n, &line, &line_end);
+                    if (filter.PassFilter(line, line_end))
+                        passed++;
+                }
+                break;
+            case Variant_IndexBuild:        index.Update(filter, lines_count, MicroTextFilterGetLine, &log); break;
+            case Variant_IndexAppend:       index.Update(filter, lines_count + lines_added, MicroTextFilterGetLine, &log); break;
+            case Variant_IndexUnchanged:
+                for (int n = 0; n < 1000; n++)
+                    index.Update(filter, lines_count, MicroTextFilterGetLine, &log);
+                break;
+            }
+            double t1 = GetTimeInMicroseconds();
+            if (run == 0 || t1 - t0 < best_time)
+                best_time = t1 - t0;
+            checksum = (variant_n == Variant_PassFilter) ? (ImU32)passed : ImHashData(index.Items.Data, (size_t)index.Items.size_in_bytes(), (ImU32)index.Size());
+        }
+        const int n = (variant_n == Variant_IndexAppend) ? lines_added : (variant_n == Variant_IndexUnchanged) ? 1000 : lines_count;
+        PrintMicroResult("text_filter", variant_names[variant_n], n, best_time * 1000.0 / n, checksum, csv);
+    }
+}
+
+struct MicroBench
+{
+    const char* Name;
+    void        (*Func)(bool csv);
+};
+
+static const MicroBench g_MicroBenches[] =
+{
+    { "storage",     MicroStorage },
+    { "polyline",    MicroPolyline },
+    { "font_atlas",  MicroFontAtlas },
+    { "render_text", MicroRenderText },
+    { "utf8",        MicroUtf8 },
+    { "text_filter", MicroTextFilter },
+};
+
+//-----------------------------------------------------------------------------
+// Runner
+//-----------------------------------------------------------------------------
+
+enum Phase { Phase_NewFrame, Phase_Submit, Phase_EndFrame, Phase_Render, Phase_Flatten, Phase_Upload, Phase_Raster, Phase_COUNT };
+static const char* g_PhaseNames[Phase_COUNT] = { "newframe", "submit", "endframe", "render", "flatten", "upload", "raster" };
+
+struct SceneResult
+{
+    double  TimeTotal[Phase_COUNT];
+    double  TimeMax[Phase_COUNT];
+    int     VtxCount;
+    int     IdxCount;
+    int     CmdListsCount;
+    int     CmdCount;
+    int     DrawCallCount;
+    ImU64   Allocs;
+    ImU64   Frees;
+    ImU64   AllocBytes;
+    ImU64   UploadBytes;            // Bytes copied by the simulated renderer
+    ImU64   UploadCalls;            // Number of buffer uploads made by the simulated renderer
+    int     UploadMismatches;       // Number of times a draw list differed from the copy kept by the simulated renderer
+    ImU32   FramebufferHash;        // With --softraster: hash of the pixels of the last frame
+    int     IdleFrames;             // Number of measured frames after which io.WaitBeforeNextFrame > 0 (an application could have slept)
+    int     ZeroAllocCheckCount;    // With --check-zero-alloc: number of heap allocations made after warm-up
+};
+
+// Replay ImDrawDataBuilder::FlattenIntoSingleLayer() over the draw lists of the frame we just rendered.
+// Render() has already flattened the viewport builder so we redistribute its lists across layers.
+static double MeasureFlatten(ImDrawDataBuilder* builder)
+{
+    ImGuiViewportP* viewport = (ImGuiViewportP*)ImGui::GetMainViewport();
+    const ImVector<ImDrawList*>& draw_lists = viewport->DrawDataBuilder.Layers[0];
+    builder->Clear();
+    for (int n = 0; n < draw_lists.Size; n++)
+        builder->Layers[n & 1].push_back(draw_lists[n]);
+    const double t0 = GetTimeInMicroseconds();
+    builder->FlattenIntoSingleLayer();
+    return GetTimeInMicroseconds() - t0;
+}
+
+// Simulated renderer keeping one vertex/index buffer per draw list, as a GPU renderer would to avoid re-uploading unchanged lists.
+// Uses STL containers rather than ImVector as this memory doesn't belong to dear imgui and shouldn't be counted.
+struct UploadBuffer
+{
+    unsigned int            Generation;
+    std::vector<ImDrawVert> VtxBuffer;
+    std::vector<ImDrawIdx>  IdxBuffer;
+    UploadBuffer() { Generation = 0; }
+};
+typedef std::unordered_map<const ImDrawList*, UploadBuffer> UploadBufferMap;
+
+// Only copy lists whose ContentGeneration changed. Return number of bytes copied.
+static ImU64 UploadDrawData(UploadBufferMap* buffers, const ImDrawData* draw_data, ImU64* upload_calls)
+{
+    ImU64 upload_bytes = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        UploadBuffer* buf = &(*buffers)[draw_list];
+        if (buf->Generation == draw_list->ContentGeneration)
+            continue;
+        buf->Generation = draw_list->ContentGeneration;
+        buf->VtxBuffer.assign(draw_list->VtxBuffer.begin(), draw_list->VtxBuffer.end());
+        buf->IdxBuffer.assign(draw_list->IdxBuffer.begin(), draw_list->IdxBuffer.end());
+        upload_bytes += (ImU64)draw_list->VtxBuffer.size_in_bytes() + (ImU64)draw_list->IdxBuffer.size_in_bytes();
+        *upload_calls += 1;
+    }
+    return upload_bytes;
+}
+
+// Verify that the buffers kept for every list match the list contents, i.e. that no change was missed. Return number of mismatching lists.
+static int VerifyUploadedDrawData(UploadBufferMap* buffers, const ImDrawData* draw_data)
+{
+    int mismatches = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        const UploadBuffer* buf = &(*buffers)[draw_list];
+        if (buf->VtxBuffer.size() == (size_t)draw_list->VtxBuffer.Size && buf->IdxBuffer.size() == (size_t)draw_list->IdxBuffer.Size
+            && (draw_list->VtxBuffer.Size == 0 || memcmp(buf->VtxBuffer.data(), draw_list->VtxBuffer.Data, (size_t)draw_list->VtxBuffer.size_in_bytes()) == 0)
+            && (draw_list->IdxBuffer.Size == 0 || memcmp(buf->IdxBuffer.data(), draw_list->IdxBuffer.Data, (size_t)draw_list->IdxBuffer.size_in_bytes()) == 0))
+            continue;
+        fprintf(stderr, "draw list '%s' was not uploaded but its contents changed!\n", draw_list->_OwnerName ? draw_list->_OwnerName : "");
+        mismatches++;
+    }
+    return mismatches;
+}
+
+// Simulated renderer keeping a single vertex/index buffer for the whole frame (--merged-buffers).
+// Buffers only grow, with some slack, as GPU renderers do. The command buffer is an ImVector as required by ImDrawData::MergeBuffers().
+struct MergedUploadBuffer
+{
+    std::vector<ImDrawVert> VtxBuffer;
+    std::vector<ImDrawIdx>  IdxBuffer;
+    ImVector<ImDrawCmd>     CmdBuffer;
+};
+
+static ImDrawDataMergeFlags GetMergeFlags(const ImDrawData* draw_data)
+{
+    if (!g_MergeCmds)
+        return ImDrawDataMergeFlags_None;
+    ImDrawDataMergeFlags flags = ImDrawDataMergeFlags_MergeCmds | ImDrawDataMergeFlags_MergeContainedClip;
+    if (sizeof(ImDrawIdx) == 4 || draw_data->TotalVtxCount <= (1 << 16))
+        flags |= ImDrawDataMergeFlags_RebaseIndices;    // Otherwise commands can only be merged within each draw list
+    return flags;
+}
+
+// Copy the whole frame with a single call. Return number of bytes copied.
+static ImU64 UploadDrawDataMerged(MergedUploadBuffer* buffer, const ImDrawData* draw_data, ImU64* upload_calls)
+{
+    if (draw_data->TotalVtxCount == 0)
+        return 0;
+    if (buffer->VtxBuffer.size() < (size_t)draw_data->TotalVtxCount)
+        buffer->VtxBuffer.resize((size_t)draw_data->TotalVtxCount + 5000);
+    if (buffer->IdxBuffer.size() < (size_t)draw_data->TotalIdxCount)
+        buffer->IdxBuffer.resize((size_t)draw_data->TotalIdxCount + 10000);
+    draw_data->MergeBuffers(buffer->VtxBuffer.data(), buffer->IdxBuffer.data(), &buffer->CmdBuffer, GetMergeFlags(draw_data));
+    *upload_calls += 1;
+    return (ImU64)draw_data->TotalVtxCount * sizeof(ImDrawVert) + (ImU64)draw_data->TotalIdxCount * sizeof(ImDrawIdx);
+}
+
+// Verify that the merged buffers and commands draw the same triangles as the draw lists, with the same texture and clipping. Return number of mismatching lists.
+static int VerifyUploadedDrawDataMerged(const MergedUploadBuffer* buffer, const ImDrawData* draw_data)
+{
+    int mismatches = 0;
+    int dst_cmd_n = 0;
+    unsigned int global_idx_offset = 0;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+    {
+        const ImDrawList* draw_list = draw_data->CmdLists[n];
+        bool match = true;
+        for (int cmd_n = 0; match && cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        {
+            const ImDrawCmd& src = draw_list->CmdBuffer[cmd_n];
+            if (src.ElemCount == 0)
+                continue;
+            const unsigned int idx_offset = global_idx_offset + src.IdxOffset;
+            while (dst_cmd_n < buffer->CmdBuffer.Size && buffer->CmdBuffer[dst_cmd_n].IdxOffset + buffer->CmdBuffer[dst_cmd_n].ElemCount <= idx_offset)
+                dst_cmd_n++;
+            if (dst_cmd_n == buffer->CmdBuffer.Size)
+            {
+                match = false;
+                break;
+            }
+            const ImDrawCmd& dst = buffer->CmdBuffer[dst_cmd_n];
+            match = dst.IdxOffset <= idx_offset && idx_offset + src.ElemCount <= dst.IdxOffset + dst.ElemCount && dst.TextureId == src.TextureId;
+
+            // Same vertices, and clipping by either rectangle must be a no-op if they differ
+            ImVec4 bb(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+            for (unsigned int elem_n = 0; match && elem_n < src.ElemCount; elem_n++)
+            {
+                const ImDrawVert& src_vtx = draw_list->VtxBuffer[(int)(src.VtxOffset + draw_list->IdxBuffer[(int)(src.IdxOffset + elem_n)])];
+                const ImDrawVert& dst_vtx = buffer->VtxBuffer[dst.VtxOffset + buffer->IdxBuffer[idx_offset + elem_n]];
+                match = memcmp(&src_vtx, &dst_vtx, sizeof(ImDrawVert)) == 0;
+                bb = ImVec4(ImMin(bb.x, src_vtx.pos.x), ImMin(bb.y, src_vtx.pos.y), ImMax(bb.z, src_vtx.pos.x), ImMax(bb.w, src_vtx.pos.y));
+            }
+            if (match && memcmp(&dst.ClipRect, &src.ClipRect, sizeof(ImVec4)) != 0)
+                match = bb.x >= ImMax(src.ClipRect.x, dst.ClipRect.x) && bb.y >= ImMax(src.ClipRect.y, dst.ClipRect.y) && bb.z <= ImMin(src.ClipRect.z, dst.ClipRect.z) && bb.w <= ImMin(src.ClipRect.w, dst.ClipRect.w);
+        }
+        if (!match)
+        {
+            fprintf(stderr, "draw list '%s' doesn't match its contents in the merged buffers!\n", draw_list->_OwnerName ? draw_list->_OwnerName : "");
+            mismatches++;
+        }
+        global_idx_offset += (unsigned int)draw_list->IdxBuffer.Size;
+    }
+    return mismatches;
+}
+
+// Verify that contents spliced by AddDrawListDeferred() keep their submission order: a deferred green rectangle followed by a direct red one
+// must draw 12 indices, green first. Return 1 on mismatch.
+static int VerifySplicedDrawListOrder()
+{
+    ImDrawList draw_list_storage(ImGui::GetDrawListSharedData()), deferred_draw_list_storage(ImGui::GetDrawListSharedData());
+    ImDrawList* draw_list = &draw_list_storage;
+    ImDrawList* deferred_draw_list = &deferred_draw_list_storage;
+    const ImU32 green = IM_COL32(0, 255, 0, 255), red = IM_COL32(255, 0, 0, 255);
+    ImDrawList* lists[2] = { draw_list, deferred_draw_list };
+    for (int n = 0; n < 2; n++)
+    {
+        lists[n]->_ResetForNewFrame();
+        lists[n]->PushClipRect(ImVec2(0, 0), ImVec2(100, 100));
+        lists[n]->PushTextureID(ImGui::GetIO().Fonts->TexID);
+    }
+    deferred_draw_list->AddRectFilled(ImVec2(0, 0), ImVec2(10, 10), green);
+    draw_list->AddDrawListDeferred(deferred_draw_list);
+    draw_list->AddRectFilled(ImVec2(5, 5), ImVec2(15, 15), red);
+    draw_list->_SpliceDeferredDrawLists();
+
+    unsigned int elem_count = 0;
+    for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+        elem_count += draw_list->CmdBuffer[cmd_n].ElemCount;
+    bool match = (elem_count == 12 && draw_list->IdxBuffer.Size == 12);
+    for (int cmd_n = 0; match && cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+    {
+        const ImDrawCmd& cmd = draw_list->CmdBuffer[cmd_n];
+        for (unsigned int elem_n = 0; match && elem_n < cmd.ElemCount; elem_n++)
+        {
+            const unsigned int idx_n = cmd.IdxOffset + elem_n;
+            const ImU32 col = draw_list->VtxBuffer[(int)(cmd.VtxOffset + draw_list->IdxBuffer[(int)idx_n])].col;
+            match = (col == (idx_n < 6 ? green : red));
+        }
+    }
+    if (!match)
+        fprintf(stderr, "draw list contents spliced by AddDrawListDeferred() are out of order!\n");
+    return match ? 0 : 1;
+}
+
+// Write an uncompressed 32-bit TGA file, top-left origin
+static void WriteScreenshot(const char* prefix, const char* scene_name, const ImGui_ImplSoftRaster_Texture& fb)
+{
+    char filename[256];
+    ImFormatString(filename, IM_ARRAYSIZE(filename), "%s%s.tga", prefix, scene_name);
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (f == NULL)
+    {
+        fprintf(stderr, "Failed to write '%s'.\n", filename);
+        return;
+    }
+    const unsigned char header[18] = { 0, 0, 2, 0, 0, 0, 0, 0, 0, 0, 0, 0, (unsigned char)(fb.Width & 0xFF), (unsigned char)(fb.Width >> 8), (unsigned char)(fb.Height & 0xFF), (unsigned char)(fb.Height >> 8), 32, 0x28 };
+    ImFileWrite(header, 1, sizeof(header), f);
+    std::vector<unsigned char> row((size_t)fb.Width * 4);
+    for (int y = 0; y < fb.Height; y++)
+    {
+        for (int x = 0; x < fb.Width; x++)
+        {
+            const ImU32 col = fb.Pixels[y * fb.Width + x];
+            row[(size_t)x * 4 + 0] = (unsigned char)(col >> IM_COL32_B_SHIFT);
+            row[(size_t)x * 4 + 1] = (unsigned char)(col >> IM_COL32_G_SHIFT);
+            row[(size_t)x * 4 + 2] = (unsigned char)(col >> IM_COL32_R_SHIFT);
+            row[(size_t)x * 4 + 3] = (unsigned char)(col >> IM_COL32_A_SHIFT);
+        }
+        ImFileWrite(row.data(), 1, row.size(), f);
+    }
+    ImFileClose(f);
+}
+
+static void RunScene(const Scene& scene, int warmup_frames, int frames, bool check_zero_alloc, bool text_size_cache, bool content_hash, SceneResult* out)
+{
+    memset(out, 0, sizeof(*out));
+
+    ImGui::CreateContext();
+    ImGuiIO& io = ImGui::GetIO();
+    io.IniFilename = NULL;
+    io.DisplaySize = ImVec2(1920, 1080);
+    io.DeltaTime = 1.0f / 60.0f;
+    io.BackendFlags |= ImGuiBackendFlags_RendererHasVtxOffset; // Allow large meshes with 16-bit indices, as most renderer backends do
+    io.ConfigTextSizeCache = text_size_cache;
+    if (content_hash)
+        io.BackendFlags |= ImGuiBackendFlags_RendererHasContentHash;
+    if (check_zero_alloc)
+        ImGui::DebugStartZeroAllocCheck(warmup_frames, false, false);
+
+    // Build atlas
+    unsigned char* tex_pixels = NULL;
+    int tex_w, tex_h;
+    io.Fonts->GetTexDataAsRGBA32(&tex_pixels, &tex_w, &tex_h);
+
+    // Software rasterizer (uses STL memory for the framebuffer, backend allocations go through dear imgui and are counted)
+    std::vector<ImU32> fb_pixels;
+    ImGui_ImplSoftRaster_Texture fb = { NULL, 1920, 1080 };
+    if (g_SoftRasterMode != 0)
+    {
+        ImGui_ImplSoftRaster_Init(g_SoftRasterMode == 2 ? ParallelForThreads : NULL, NULL);
+        if (!content_hash)
+            io.BackendFlags &= ~ImGuiBackendFlags_RendererHasContentHash;
+        fb_pixels.resize((size_t)fb.Width * (size_t)fb.Height);
+        fb.Pixels = fb_pixels.data();
+    }
+
+    ImDrawDataBuilder flatten_builder;
+    UploadBufferMap upload_buffers;
+    MergedUploadBuffer merged_upload_buffer;
+    ImU64 upload_bytes = 0;
+    ImU64 upload_calls = 0;
+    if (g_MergedBuffers)
+        out->UploadMismatches += VerifySplicedDrawListOrder();
+    for (int frame_n = 0; frame_n < warmup_frames + frames; frame_n++)
+    {
+        const bool measure = (frame_n >= warmup_frames);
+        if (frame_n == warmup_frames)
+        {
+            g_AllocCounters.Allocs = 0;
+            g_AllocCounters.Frees = 0;
+            g_AllocCounters.AllocBytes = 0;
+            upload_bytes = 0;
+            upload_calls = 0;
+        }
+
+        double t[Phase_COUNT];
+        if (g_SoftRasterMode != 0)
+            ImGui_ImplSoftRaster_NewFrame();
+        double t0 = GetTimeInMicroseconds();
+        ImGui::NewFrame();
+        double t1 = GetTimeInMicroseconds();
+        scene.Func();
+        double t2 = GetTimeInMicroseconds();
+        ImGui::EndFrame();
+        double t3 = GetTimeInMicroseconds();
+        ImGui::Render();
+        double t4 = GetTimeInMicroseconds();
+        t[Phase_NewFrame] = t1 - t0;
+        t[Phase_Submit] = t2 - t1;
+        t[Phase_EndFrame] = t3 - t2;
+        t[Phase_Render] = t4 - t3;
+        t[Phase_Flatten] = MeasureFlatten(&flatten_builder);
+        double t5 = GetTimeInMicroseconds();
+        if (g_MergedBuffers)
+            upload_bytes += UploadDrawDataMerged(&merged_upload_buffer, ImGui::GetDrawData(), &upload_calls);
+        else
+            upload_bytes += UploadDrawData(&upload_buffers, ImGui::GetDrawData(), &upload_calls);
+        t[Phase_Upload] = GetTimeInMicroseconds() - t5;
+        if (g_MergedBuffers)
+            out->UploadMismatches += VerifyUploadedDrawDataMerged(&merged_upload_buffer, ImGui::GetDrawData());
+        else
+            out->UploadMismatches += VerifyUploadedDrawData(&upload_buffers, ImGui::GetDrawData());
+        double t6 = GetTimeInMicroseconds();
+        if (g_SoftRasterMode != 0)
+            ImGui_ImplSoftRaster_RenderDrawData(ImGui::GetDrawData(), &fb, IM_COL32(114, 140, 153, 255));
+        t[Phase_Raster] = GetTimeInMicroseconds() - t6;
+        if (!measure)
+            continue;
+
+        for (int phase_n = 0; phase_n < Phase_COUNT; phase_n++)
+        {
+            out->TimeTotal[phase_n] += t[phase_n];
+            out->TimeMax[phase_n] = ImMax(out->TimeMax[phase_n], t[phase_n]);
+        }
+        if (io.WaitBeforeNextFrame > 0.0f)
+            out->IdleFrames++;
+    }
+
+    // Allocations made by MeasureFlatten() are accounted for, but it only reuses the capacity of its own builder.
+    out->Allocs = g_AllocCounters.Allocs;
+    out->Frees = g_AllocCounters.Frees;
+    out->AllocBytes = g_AllocCounters.AllocBytes;
+    out->UploadBytes = upload_bytes;
+    out->UploadCalls = upload_calls;
+
+    ImDrawData* draw_data = ImGui::GetDrawData();
+    out->VtxCount = draw_data->TotalVtxCount;
+    out->IdxCount = draw_data->TotalIdxCount;
+    out->CmdListsCount = draw_data->CmdListsCount;
+    for (int n = 0; n < draw_data->CmdListsCount; n++)
+        out->CmdCount += draw_data->CmdLists[n]->CmdBuffer.Size;
+    out->DrawCallCount = g_MergedBuffers ? merged_upload_buffer.CmdBuffer.Size : out->CmdCount;
+
+    if (check_zero_alloc)
+    {
+        ImGuiContext& g = *ImGui::GetCurrentContext();
+        out->ZeroAllocCheckCount = g.DebugZeroAllocCheckCount;
+        const int reports_count = ImMin(g.DebugZeroAllocCheckCount, IM_ARRAYSIZE(g.DebugZeroAllocCheckReports));
+        for (int n = 0; n < reports_count; n++)
+        {
+            const ImGuiDebugAllocReport* report = &g.DebugZeroAllocCheckReports[(g.DebugZeroAllocCheckCount - reports_count + n) % IM_ARRAYSIZE(g.DebugZeroAllocCheckReports)];
+            ImGuiWindow* window = report->WindowID ? ImGui::FindWindowByID(report->WindowID) : NULL;
+            fprintf(stderr, "%s: frame %d: heap allocation of %d bytes, category %s, window '%s'\n",
+                scene.Name, report->Frame, (int)report->Size, ImGui::GetMemCategoryName(report->Category), window ? window->Name : "NULL");
+        }
+        if (g.DebugZeroAllocCheckCount > reports_count)
+            fprintf(stderr, "%s: ... %d more\n", scene.Name, g.DebugZeroAllocCheckCount - reports_count);
+    }
+
+    if (g_SoftRasterMode != 0)
+    {
+        out->FramebufferHash = ImHashData(fb.Pixels, fb_pixels.size() * sizeof(ImU32));
+        if (g_ScreenshotPrefix != NULL)
+            WriteScreenshot(g_ScreenshotPrefix, scene.Name, fb);
+        ImGui_ImplSoftRaster_Shutdown();
+    }
+
+    flatten_builder.ClearFreeMemory();
+    if (scene.Shutdown)
+        scene.Shutdown();
+    ImGui::DestroyContext();
+}
+
+static void PrintResult(const char* scene_name, const SceneResult& r, int frames, bool csv)
+{
+    const double inv_frames = 1.0 / frames;
+    if (csv)
+    {
+        printf("%s,%d", scene_name, frames);
+        for (int phase_n = 0; phase_n < Phase_COUNT; phase_n++)
+            printf(",%.2f,%.2f", r.TimeTotal[phase_n] * inv_frames, r.TimeMax[phase_n]);
+        printf(",%d,%d,%d,%d,%d,%.2f,%.2f,%.1f,%.1f,%.2f,%08X,%d\n", r.VtxCount, r.IdxCount, r.CmdListsCount, r.CmdCount, r.DrawCallCount,
+            r.Allocs * inv_frames, r.Frees * inv_frames, r.AllocBytes * inv_frames, r.UploadBytes * inv_frames, r.UploadCalls * inv_frames, r.FramebufferHash, r.IdleFrames);
+        return;
+    }
+    printf("{\"scene\":\"%s\",\"frames\":%d", scene_name, frames);
+    for (int phase_n = 0; phase_n < Phase_COUNT; phase_n++)
+        printf(",\"%s_us\":%.2f,\"%s_max_us\":%.2f", g_PhaseNames[phase_n], r.TimeTotal[phase_n] * inv_frames, g_PhaseNames[phase_n], r.TimeMax[phase_n]);
+    printf(",\"vtx\":%d,\"idx\":%d,\"cmd_lists\":%d,\"cmds\":%d,\"draw_calls\":%d,\"allocs\":%.2f,\"frees\":%.2f,\"alloc_bytes\":%.1f,\"upload_bytes\":%.1f,\"upload_calls\":%.2f,\"fb_hash\":\"%08X\",\"idle_frames\":%d}\n",
+        r.VtxCount, r.IdxCount, r.CmdListsCount, r.CmdCount, r.DrawCallCount,
+        r.Allocs * inv_frames, r.Frees * inv_frames, r.AllocBytes * inv_frames, r.UploadBytes * inv_frames, r.UploadCalls * inv_frames, r.FramebufferHash, r.IdleFrames);
+}
+
+static void PrintCsvHeader()
+{
+    printf("scene,frames");
+    for (int phase_n = 0; phase_n < Phase_COUNT; phase_n++)
+        printf(",%s_us,%s_max_us", g_PhaseNames[phase_n], g_PhaseNames[phase_n]);
+    printf(",vtx,idx,cmd_lists,cmds,draw_calls,allocs,frees,alloc_bytes,upload_bytes,upload_calls,fb_hash,idle_frames\n");
+}
+
+int main(int argc, char** argv)
+{
+    IMGUI_CHECKVERSION();
+
+    int frames = 100;
+    int warmup_frames = 10;
+    const char* scene_filter = NULL;
+    bool csv = false;
+    bool micro = false;
+    bool check_zero_alloc = false;
+    bool text_size_cache = false;
+    bool content_hash = false;
+    for (int n = 1; n < argc; n++)
+    {
+        if (strcmp(argv[n], "--frames") == 0 && n + 1 < argc)
+            frames = atoi(argv[++n]);
+        else if (strcmp(argv[n], "--warmup") == 0 && n + 1 < argc)
+            warmup_frames = atoi(argv[++n]);
+        else if (strcmp(argv[n], "--scene") == 0 && n + 1 < argc)
+            scene_filter = argv[++n];
+        else if (strcmp(argv[n], "--csv") == 0)
+            csv = true;
+        else if (strcmp(argv[n], "--micro") == 0)
+            micro = true;
+        else if (strcmp(argv[n], "--check-zero-alloc") == 0)
+            check_zero_alloc = true;
+        else if (strcmp(argv[n], "--text-size-cache") == 0)
+            text_size_cache = true;
+        else if (strcmp(argv[n], "--retain-geometry") == 0)
+            g_SceneWindowFlags |= ImGuiWindowFlags_RetainGeometry;
+        else if (strcmp(argv[n], "--content-hash") == 0)
+            content_hash = true;
+        else if (strcmp(argv[n], "--merged-buffers") == 0)
+            g_MergedBuffers = true;
+        else if (strcmp(argv[n], "--merge-cmds") == 0)
+            g_MergedBuffers = g_MergeCmds = true;
+        else if (strcmp(argv[n], "--softraster") == 0)
+            g_SoftRasterMode = ImMax(g_SoftRasterMode, 1);
+        else if (strcmp(argv[n], "--softraster-mt") == 0)
+            g_SoftRasterMode = 2;
+        else if (strcmp(argv[n], "--screenshot") == 0 && n + 1 < argc)
+        {
+            g_ScreenshotPrefix = argv[++n];
+            g_SoftRasterMode = ImMax(g_SoftRasterMode, 1);
+        }
+        else if (strcmp(argv[n], "--list") == 0)
+        {
+            for (int scene_n = 0; scene_n < IM_ARRAYSIZE(g_Scenes); scene_n++)
+                printf("%s\n", g_Scenes[scene_n].Name);
+            for (int bench_n = 0; bench_n < IM_ARRAYSIZE(g_MicroBenches); bench_n++)
+                printf("%s (--micro)\n", g_MicroBenches[bench_n].Name);
+            return 0;
+        }
+        else
+        {
+            fprintf(stderr, "Usage: %s [--frames N] [--warmup N] [--scene NAME] [--csv] [--list] [--micro] [--check-zero-alloc] [--text-size-cache] [--retain-geometry] [--content-hash] [--merged-buffers] [--merge-cmds] [--softraster] [--softraster-mt] [--screenshot PREFIX]\n", argv[0]);
+            return 1;
+        }
+    }
+    if (frames < 1 || warmup_frames < 0)
+    {
+        fprintf(stderr, "Invalid frame count.\n");
+        return 1;
+    }
+
+    ImGui::SetAllocatorFunctions(CountingMalloc, CountingFree, NULL);
+    if (micro)
+    {
+        if (csv)
+            printf("bench,variant,n,ns_per_op,checksum\n");
+        int benches_ran = 0;
+        for (int bench_n = 0; bench_n < IM_ARRAYSIZE(g_MicroBenches); bench_n++)
+        {
+            const MicroBench& bench = g_MicroBenches[bench_n];
+            if (scene_filter != NULL && strcmp(scene_filter, bench.Name) != 0)
+                continue;
+            bench.Func(csv);
+            fflush(stdout);
+            benches_ran++;
+        }
+        if (benches_ran == 0)
+        {
+            fprintf(stderr, "Unknown micro-benchmark '%s'. Use --list to list available benchmarks.\n", scene_filter);
+            return 1;
+        }
+        return 0;
+    }
+
+    if (csv)
+        PrintCsvHeader();
+
+    int scenes_ran = 0;
+    int scenes_allocating = 0;
+    int scenes_mismatching = 0;
+    for (int scene_n = 0; scene_n < IM_ARRAYSIZE(g_Scenes); scene_n++)
+    {
+        const Scene& scene = g_Scenes[scene_n];
+        if (scene_filter != NULL && strcmp(scene_filter, scene.Name) != 0)
+            continue;
+        SceneResult result;
+        RunScene(scene, warmup_frames, frames, check_zero_alloc, text_size_cache, content_hash, &result);
+        PrintResult(scene.Name, result, frames, csv);
+        fflush(stdout);
+        scenes_ran++;
+        if (result.ZeroAllocCheckCount > 0)
+            scenes_allocating++;
+        if (result.UploadMismatches > 0)
+            scenes_mismatching++;
+    }
+    if (scenes_ran == 0)
+    {
+        fprintf(stderr, "Unknown scene '%s'. Use --list to list available scenes.\n", scene_filter);
+        return 1;
+    }
+    if (scenes_allocating > 0)
+    {
+        fprintf(stderr, "Zero-allocation check failed in %d scene(s).\n", scenes_allocating);
+        return 2;
+    }
+    if (scenes_mismatching > 0)
+    {
+        fprintf(stderr, "Upload check failed in %d scene(s).\n", scenes_mismatching);
+        return 3;
+    }
+    return 0;
+}
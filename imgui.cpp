@@ -64,6 +64,7 @@ CODE
 // [SECTION] ImGuiTextFilter
 // [SECTION] ImGuiTextBuffer
 // [SECTION] ImGuiListClipper
+// [SECTION] ImGuiListItemHeights
 // [SECTION] STYLING
 // [SECTION] RENDER HELPERS
 // [SECTION] MAIN CODE (most of the code! lots of stuff, needs tidying up!)
@@ -898,6 +899,8 @@ static void             UpdateMouseInputs();
 static void             UpdateMouseWheel();
 static void             UpdateTabFocus();
 static void             UpdateDebugToolItemPicker();
+static void             UpdateTextSizeCache();
+static void             UpdateWaitBeforeNextFrame();
 static bool             UpdateWindowManualResize(ImGuiWindow* window, const ImVec2& size_auto_fit, int* border_held, int resize_grip_count, ImU32 resize_grip_col[4], const ImRect& visibility_rect);
 static void             RenderWindowOuterBorders(ImGuiWindow* window);
 static void             RenderWindowDecorations(ImGuiWindow* window, const ImRect& title_bar_rect, bool title_bar_is_highlight, int resize_grip_count, const ImU32 resize_grip_col[4], float resize_grip_draw_size);
@@ -1068,6 +1071,8 @@ ImGuiIO::ImGuiIO()
     ConfigWindowsResizeFromEdges = true;
     ConfigWindowsMoveFromTitleBarOnly = false;
     ConfigMemoryCompactTimer = 60.0f;
+    ConfigTextSizeCache = false;
+    ConfigInputTextUndoMemoryMax = 16 * 1024 * 1024;
 
     // Platform Functions
     BackendPlatformName = BackendRendererName = NULL;
@@ -1338,24 +1343,88 @@ const ImWchar* ImStrbolW(const ImWchar* buf_mid_line, const ImWchar* buf_begin)
     return buf_mid_line;
 }
 
+#ifdef IMGUI_ENABLE_SSE
+// Index of the lowest bit set in a non-zero mask (e.g. from _mm_movemask_epi8)
+static inline int ImLowestBitIndex(unsigned int mask)
+{
+    static const unsigned char debruijn_bit_pos[32] = { 0, 1, 28, 2, 29, 14, 24, 3, 30, 22, 20, 15, 25, 17, 4, 8, 31, 27, 13, 23, 21, 19, 16, 7, 26, 12, 18, 6, 11, 5, 10, 9 };
+    return debruijn_bit_pos[((mask & (0u - mask)) * 0x077CB531u) >> 27];
+}
+#endif
+
 const char* ImStristr(const char* haystack, const char* haystack_end, const char* needle, const char* needle_end)
 {
     if (!needle_end)
         needle_end = needle + strlen(needle);
-
-    const char un0 = (char)toupper(*needle);
-    while ((!haystack_end && *haystack) || (haystack_end && haystack < haystack_end))
-    {
-        if (toupper(*haystack) == un0)
+    if (!haystack_end)
+        haystack_end = haystack + strlen(haystack);
+    const int needle_len = (int)(needle_end - needle);
+    if (needle_len == 0)
+        return haystack;
+    if (haystack_end - haystack < needle_len)
+        return NULL;
+    const char* haystack_last = haystack_end - needle_len; // Last position where the needle may start
+
+    // With an ASCII needle, only positions whose first and last characters match are compared with toupper() (16 at a time with SSE2).
+    // Letters are matched case-insensitively by setting their 0x20 bit on both sides, other characters are matched as is.
+    // toupper() depends on the C locale and may fold non-ASCII bytes, so positions starting or ending on one are always compared.
+    bool needle_is_ascii = true;
+    for (const char* p = needle; p < needle_end && needle_is_ascii; p++)
+        needle_is_ascii = (*p & 0x80) == 0;
+    if (needle_is_ascii)
+    {
+        const char fold_first = (toupper(needle[0]) >= 'A' && toupper(needle[0]) <= 'Z') ? 0x20 : 0;
+        const char fold_last = (toupper(needle_end[-1]) >= 'A' && toupper(needle_end[-1]) <= 'Z') ? 0x20 : 0;
+        const char first_char = (char)(needle[0] | fold_first);
+        const char last_char = (char)(needle_end[-1] | fold_last);
+#ifdef IMGUI_ENABLE_SSE
+        const __m128i first_fold_x16 = _mm_set1_epi8(fold_first);
+        const __m128i first_char_x16 = _mm_set1_epi8(first_char);
+        const __m128i last_fold_x16 = _mm_set1_epi8(fold_last);
+        const __m128i last_char_x16 = _mm_set1_epi8(last_char);
+        while (haystack_last - haystack >= 15)
+        {
+            const __m128i block_first = _mm_loadu_si128((const __m128i*)(const void*)haystack);
+            const __m128i block_last = _mm_loadu_si128((const __m128i*)(const void*)(haystack + needle_len - 1));
+            const unsigned int mask_first = (unsigned int)(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(block_first, first_fold_x16), first_char_x16)) | _mm_movemask_epi8(block_first));
+            const unsigned int mask_last = (unsigned int)(_mm_movemask_epi8(_mm_cmpeq_epi8(_mm_or_si128(block_last, last_fold_x16), last_char_x16)) | _mm_movemask_epi8(block_last));
+            for (unsigned int mask = mask_first & mask_last; mask != 0; mask &= mask - 1)
+            {
+                const char* candidate = haystack + ImLowestBitIndex(mask);
+                int n = 0;
+                while (n < needle_len && toupper(candidate[n]) == toupper(needle[n]))
+                    n++;
+                if (n == needle_len)
+                    return candidate;
+            }
+            haystack += 16;
+        }
+#endif
+        for (; haystack <= haystack_last; haystack++)
         {
-            const char* b = needle + 1;
-            for (const char* a = haystack + 1; b < needle_end; a++, b++)
-                if (toupper(*a) != toupper(*b))
-                    break;
-            if (b == needle_end)
+            const char c_first = haystack[0];
+            const char c_last = haystack[needle_len - 1];
+            if (((c_first & 0x80) == 0 && (char)(c_first | fold_first) != first_char) || ((c_last & 0x80) == 0 && (char)(c_last | fold_last) != last_char))
+                continue;
+            int n = 0;
+            while (n < needle_len && toupper(haystack[n]) == toupper(needle[n]))
+                n++;
+            if (n == needle_len)
                 return haystack;
         }
-        haystack++;
+        return NULL;
+    }
+
+    const char un0 = (char)toupper(*needle);
+    for (; haystack <= haystack_last; haystack++)
+    {
+        if (toupper(*haystack) != un0)
+            continue;
+        int n = 1;
+        while (n < needle_len && toupper(haystack[n]) == toupper(needle[n]))
+            n++;
+        if (n == needle_len)
+            return haystack;
     }
     return NULL;
 }
@@ -1435,6 +1504,42 @@ int ImFormatStringV(char* buf, size_t buf_size, const char* fmt, va_list args)
 }
 #endif // #ifdef IMGUI_DISABLE_DEFAULT_FORMAT_FUNCTIONS
 
+// Known size 64-bit hash, processing 8 bytes per iteration (based on MurmurHash64A)
+// - Used where 32 bits are not enough to trust a match (e.g. ImDrawList::ContentGeneration), and by ImHashData() when IMGUI_USE_FAST_HASH is defined.
+// - Output is stable across runs and platforms of same endianness.
+// - Loads go through memcpy() so unaligned input is fine and the compiler can emit a single load.
+ImU64 ImHashData64(const void* data_p, size_t data_size, ImU64 seed)
+{
+    const ImU64 m = 0xC6A4A7935BD1E995ULL;
+    const int r = 47;
+    ImU64 h = seed ^ ((ImU64)data_size * m);
+    const unsigned char* data = (const unsigned char*)data_p;
+    const unsigned char* data_end_aligned = data + (data_size & ~(size_t)7);
+    for (; data != data_end_aligned; data += 8)
+    {
+        ImU64 k;
+        memcpy(&k, data, 8);
+        k *= m;
+        k ^= k >> r;
+        k *= m;
+        h ^= k;
+        h *= m;
+    }
+    if (size_t data_tail_size = data_size & 7)
+    {
+        ImU64 k = 0;
+        memcpy(&k, data, data_tail_size);
+        h ^= k;
+        h *= m;
+    }
+    h ^= h >> r;
+    h *= m;
+    h ^= h >> r;
+    return h;
+}
+
+#ifndef IMGUI_USE_FAST_HASH
+
 // CRC32 needs a 1KB lookup table (not cache friendly)
 // Although the code to generate the table is simple and shorter than the table itself, using a const table allows us to easily:
 // - avoid an unnecessary branch/memory tap, - keep the ImHashXXX functions usable by static constructors, - make it thread-safe.
@@ -1460,7 +1565,7 @@ static const ImU32 GCrc32LookupTable[256] =
 
 // Known size hash
 // It is ok to call ImHashData on a string with known length but the ### operator won't be supported.
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// Define IMGUI_USE_FAST_HASH in imconfig.h to use a faster word-at-a-time hash instead (IDs will be different).
 ImGuiID ImHashData(const void* data_p, size_t data_size, ImU32 seed)
 {
     ImU32 crc = ~seed;
@@ -1471,38 +1576,33 @@ ImGuiID ImHashData(const void* data_p, size_t data_size, ImU32 seed)
     return ~crc;
 }
 
+#else
+
+// Known size hash, word-at-a-time variant: ImHashData64() folded to 32 bits. Output differs from the default CRC32 hash.
+ImGuiID ImHashData(const void* data_p, size_t data_size, ImU32 seed)
+{
+    const ImU64 h = ImHashData64(data_p, data_size, seed);
+    return (ImGuiID)(h ^ (h >> 32));
+}
+
+#endif // #ifndef IMGUI_USE_FAST_HASH
+
 // Zero-terminated string hash, with support for ### to reset back to seed value
 // We support a syntax of "label###id" where only "###id" is included in the hash, and only "label" gets displayed.
 // Because this syntax is rarely used we are optimizing for the common case.
-// - If we reach ### in the string we discard the hash so far and reset to the seed.
-// - We don't do 'current += 2; continue;' after handling ### to keep the code smaller/faster (measured ~10% diff in Debug build)
-// FIXME-OPT: Replace with e.g. FNV1a hash? CRC32 pretty much randomly access 1KB. Need to do proper measurements.
+// - If we reach ### in the string we discard the hash so far and reset to the seed, which is the same as hashing from the last ### onward.
+// - We locate the end of the string and the last ### using strlen()/memchr() (typically vectorized by the C library),
+//   then hash the remaining span with ImHashData(). Result is identical to hashing byte-by-byte and resetting on each ###.
 ImGuiID ImHashStr(const char* data_p, size_t data_size, ImU32 seed)
 {
-    seed = ~seed;
-    ImU32 crc = seed;
-    const unsigned char* data = (const unsigned char*)data_p;
-    const ImU32* crc32_lut = GCrc32LookupTable;
-    if (data_size != 0)
-    {
-        while (data_size-- != 0)
-        {
-            unsigned char c = *data++;
-            if (c == '#' && data_size >= 2 && data[0] == '#' && data[1] == '#')
-                crc = seed;
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-        }
-    }
-    else
-    {
-        while (unsigned char c = *data++)
-        {
-            if (c == '#' && data[0] == '#' && data[1] == '#')
-                crc = seed;
-            crc = (crc >> 8) ^ crc32_lut[(crc & 0xFF) ^ c];
-        }
-    }
-    return ~crc;
+    if (data_size == 0)
+        data_size = strlen(data_p);
+    const char* data_begin = data_p;
+    const char* data_end = data_p + data_size;
+    for (const char* p = data_p; (p = (const char*)memchr(p, '#', (size_t)(data_end - p))) != NULL; p++)
+        if (data_end - p >= 3 && p[1] == '#' && p[2] == '#')
+            data_begin = p;
+    return ImHashData(data_begin, (size_t)(data_end - data_begin), seed);
 }
 
 //-----------------------------------------------------------------------------
@@ -1582,11 +1682,52 @@ void*   ImFileLoadToMemory(const char* filename, const char* mode, size_t* out_f
 // [SECTION] MISC HELPERS/UTILITIES (ImText* functions)
 //-----------------------------------------------------------------------------
 
+// Decode a well-formed 2 or 3 bytes UTF-8 sequence (Latin, Greek, Cyrillic, CJK...) with a few comparisons.
+// Return 0 for anything else (4 bytes sequences, invalid or truncated input): the caller uses the generic decoder, so results are identical.
+// Caller ensures in_text < in_text_end (when not NULL) and that in_text[0] is not ASCII.
+static inline int ImTextCharFromUtf8Common(unsigned int* out_char, const char* in_text, const char* in_text_end)
+{
+    const unsigned char* s = (const unsigned char*)in_text;
+    if (s[0] >= 0xC2 && s[0] <= 0xDF)
+    {
+        if ((in_text_end == NULL || in_text + 1 < in_text_end) && (s[1] & 0xC0) == 0x80)
+        {
+            *out_char = ((unsigned int)(s[0] & 0x1F) << 6) | (s[1] & 0x3F);
+            return 2;
+        }
+    }
+    else if (s[0] >= 0xE0 && s[0] <= 0xEF)
+    {
+        if ((in_text_end == NULL || in_text + 2 < in_text_end) && (s[1] & 0xC0) == 0x80 && (s[2] & 0xC0) == 0x80)
+        {
+            const unsigned int c = ((unsigned int)(s[0] & 0x0F) << 12) | ((unsigned int)(s[1] & 0x3F) << 6) | (s[2] & 0x3F);
+            if (c >= 0x800 && (c >> 11) != 0x1b) // Non-canonical encoding, surrogate half
+            {
+                *out_char = c;
+                return 3;
+            }
+        }
+    }
+    return 0;
+}
+
 // Convert UTF-8 to 32-bit character, process single character input.
 // A nearly-branchless UTF-8 decoder, based on work of Christopher Wellons (https://github.com/skeeto/branchless-utf8).
 // We handle UTF-8 decoding error by skipping forward.
 int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char* in_text_end)
 {
+    // Fast path for ASCII and well-formed 2-3 bytes sequences
+    if (in_text_end == NULL || in_text < in_text_end)
+    {
+        if ((unsigned char)*in_text < 0x80)
+        {
+            *out_char = (unsigned char)*in_text;
+            return 1;
+        }
+        if (int len = ImTextCharFromUtf8Common(out_char, in_text, in_text_end))
+            return len;
+    }
+
     static const char lengths[32] = { 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, 0, 0, 2, 2, 2, 2, 3, 3, 4, 0 };
     static const int masks[]  = { 0x00, 0x7f, 0x1f, 0x0f, 0x07 };
     static const uint32_t mins[] = { 0x400000, 0, 0x80, 0x800, 0x10000 };
@@ -1637,16 +1778,99 @@ int ImTextCharFromUtf8(unsigned int* out_char, const char* in_text, const char*
     return wanted;
 }
 
+// SSE2 helpers to process runs of ASCII characters 16 at a time.
+// They return the number of leading characters which are ASCII and not zero (16 when all of them are), other characters go through the scalar code.
+// Callers store all 16 converted characters (when there is room for them) and only advance by that count: following characters get overwritten.
+#ifdef IMGUI_ENABLE_SSE
+static inline int ImTextCountLeadingAsciiFromMask(int mask)
+{
+    return ImLowestBitIndex((unsigned int)mask | 0x10000);
+}
+
+// Load 16 UTF-8 bytes
+static inline int ImTextLoadAscii16(__m128i* out_bytes, const char* in_text)
+{
+    const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)in_text);
+    *out_bytes = v;
+    return ImTextCountLeadingAsciiFromMask(_mm_movemask_epi8(_mm_or_si128(v, _mm_cmpeq_epi8(v, _mm_setzero_si128()))));
+}
+
+// Load 16 characters as two vectors of 16-bit values. With 32-bit ImWchar, characters above 0xFFFF are not ASCII either.
+static inline int ImTextLoadAscii16W(__m128i* out_lo, __m128i* out_hi, const ImWchar* in_text)
+{
+    const __m128i zero = _mm_setzero_si128();
+#ifdef IMGUI_USE_WCHAR32
+    const __m128i v0 = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 0));
+    const __m128i v1 = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 4));
+    const __m128i v2 = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 8));
+    const __m128i v3 = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 12));
+    const __m128i high_mask = _mm_set1_epi32((int)0xFFFF0000);
+    const __m128i narrow = _mm_packs_epi16(
+        _mm_packs_epi32(_mm_cmpeq_epi32(_mm_and_si128(v0, high_mask), zero), _mm_cmpeq_epi32(_mm_and_si128(v1, high_mask), zero)),
+        _mm_packs_epi32(_mm_cmpeq_epi32(_mm_and_si128(v2, high_mask), zero), _mm_cmpeq_epi32(_mm_and_si128(v3, high_mask), zero)));
+    const int wide_mask = _mm_movemask_epi8(narrow) ^ 0xFFFF;
+    // Pack to 16-bit: bias values so signed saturation keeps the range 0..0xFFFF intact
+    const __m128i bias32 = _mm_set1_epi32(0x8000);
+    const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+    *out_lo = _mm_add_epi16(_mm_packs_epi32(_mm_sub_epi32(v0, bias32), _mm_sub_epi32(v1, bias32)), bias16);
+    *out_hi = _mm_add_epi16(_mm_packs_epi32(_mm_sub_epi32(v2, bias32), _mm_sub_epi32(v3, bias32)), bias16);
+#else
+    *out_lo = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 0));
+    *out_hi = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 8));
+    const int wide_mask = 0;
+#endif
+    const __m128i non_ascii_mask = _mm_set1_epi16((short)0xFF80);
+    const __m128i ascii_lo = _mm_andnot_si128(_mm_cmpeq_epi16(*out_lo, zero), _mm_cmpeq_epi16(_mm_and_si128(*out_lo, non_ascii_mask), zero));
+    const __m128i ascii_hi = _mm_andnot_si128(_mm_cmpeq_epi16(*out_hi, zero), _mm_cmpeq_epi16(_mm_and_si128(*out_hi, non_ascii_mask), zero));
+    const int non_ascii = (_mm_movemask_epi8(_mm_packs_epi16(ascii_lo, ascii_hi)) ^ 0xFFFF) | wide_mask;
+    return ImTextCountLeadingAsciiFromMask(non_ascii);
+}
+#endif
+
 int ImTextStrFromUtf8(ImWchar* buf, int buf_size, const char* in_text, const char* in_text_end, const char** in_text_remaining)
 {
     ImWchar* buf_out = buf;
     ImWchar* buf_end = buf + buf_size;
     while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
-        unsigned int c;
-        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
-        if (c == 0)
-            break;
+        unsigned int c = (unsigned char)*in_text;
+        if (c < 0x80)
+        {
+#ifdef IMGUI_ENABLE_SSE
+            // Convert runs of ASCII characters 16 at a time (at least 1 as in_text[0] is ASCII)
+            if (in_text_end != NULL && in_text_end - in_text >= 16 && buf_end - buf_out > 16)
+            {
+                __m128i v;
+                const int ascii_count = ImTextLoadAscii16(&v, in_text);
+                const __m128i zero = _mm_setzero_si128();
+#ifdef IMGUI_USE_WCHAR32
+                const __m128i lo = _mm_unpacklo_epi8(v, zero);
+                const __m128i hi = _mm_unpackhi_epi8(v, zero);
+                _mm_storeu_si128((__m128i*)(void*)(buf_out + 0), _mm_unpacklo_epi16(lo, zero));
+                _mm_storeu_si128((__m128i*)(void*)(buf_out + 4), _mm_unpackhi_epi16(lo, zero));
+                _mm_storeu_si128((__m128i*)(void*)(buf_out + 8), _mm_unpacklo_epi16(hi, zero));
+                _mm_storeu_si128((__m128i*)(void*)(buf_out + 12), _mm_unpackhi_epi16(hi, zero));
+#else
+                _mm_storeu_si128((__m128i*)(void*)(buf_out + 0), _mm_unpacklo_epi8(v, zero));
+                _mm_storeu_si128((__m128i*)(void*)(buf_out + 8), _mm_unpackhi_epi8(v, zero));
+#endif
+                in_text += ascii_count;
+                buf_out += ascii_count;
+                continue;
+            }
+#endif
+            in_text++;
+        }
+        else if (int c_len = ImTextCharFromUtf8Common(&c, in_text, in_text_end))
+        {
+            in_text += c_len;
+        }
+        else
+        {
+            in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+            if (c == 0)
+                break;
+        }
         *buf_out++ = (ImWchar)c;
     }
     *buf_out = 0;
@@ -1660,10 +1884,32 @@ int ImTextCountCharsFromUtf8(const char* in_text, const char* in_text_end)
     int char_count = 0;
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
-        unsigned int c;
-        in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
-        if (c == 0)
-            break;
+        unsigned int c = (unsigned char)*in_text;
+        if (c < 0x80)
+        {
+#ifdef IMGUI_ENABLE_SSE
+            // Count runs of ASCII characters 16 at a time (at least 1 as in_text[0] is ASCII)
+            if (in_text_end != NULL && in_text_end - in_text >= 16)
+            {
+                __m128i v;
+                const int ascii_count = ImTextLoadAscii16(&v, in_text);
+                in_text += ascii_count;
+                char_count += ascii_count;
+                continue;
+            }
+#endif
+            in_text++;
+        }
+        else if (int c_len = ImTextCharFromUtf8Common(&c, in_text, in_text_end))
+        {
+            in_text += c_len;
+        }
+        else
+        {
+            in_text += ImTextCharFromUtf8(&c, in_text, in_text_end);
+            if (c == 0)
+                break;
+        }
         char_count++;
     }
     return char_count;
@@ -1727,7 +1973,20 @@ int ImTextStrToUtf8(char* buf, int buf_size, const ImWchar* in_text, const ImWch
     const char* buf_end = buf + buf_size;
     while (buf_out < buf_end - 1 && (!in_text_end || in_text < in_text_end) && *in_text)
     {
-        unsigned int c = (unsigned int)(*in_text++);
+        unsigned int c = (unsigned int)(*in_text);
+#ifdef IMGUI_ENABLE_SSE
+        // Convert runs of ASCII characters 16 at a time (at least 1 as in_text[0] is ASCII)
+        if (c < 0x80 && in_text_end != NULL && in_text_end - in_text >= 16 && buf_end - buf_out > 16)
+        {
+            __m128i lo, hi;
+            const int ascii_count = ImTextLoadAscii16W(&lo, &hi, in_text);
+            _mm_storeu_si128((__m128i*)(void*)buf_out, _mm_packus_epi16(lo, hi));
+            in_text += ascii_count;
+            buf_out += ascii_count;
+            continue;
+        }
+#endif
+        in_text++;
         if (c < 0x80)
             *buf_out++ = (char)c;
         else
@@ -1740,6 +1999,54 @@ int ImTextStrToUtf8(char* buf, int buf_size, const ImWchar* in_text, const ImWch
 int ImTextCountUtf8BytesFromStr(const ImWchar* in_text, const ImWchar* in_text_end)
 {
     int bytes_count = 0;
+#ifdef IMGUI_ENABLE_SSE
+    // Process 16 characters at a time until reaching a zero: for characters up to 0xFFFF, bytes count is 1 + (c >= 0x80) + (c >= 0x800).
+    // The extra bytes are summed with _mm_sad_epu8().
+    if (in_text_end != NULL)
+    {
+        const __m128i zero = _mm_setzero_si128();
+        __m128i extra_bytes_acc = zero;
+        while (in_text_end - in_text >= 16)
+        {
+#ifdef IMGUI_USE_WCHAR32
+            __m128i v[4];
+            for (int n = 0; n < 4; n++)
+                v[n] = _mm_loadu_si128((const __m128i*)(const void*)(in_text + n * 4));
+            const __m128i high_mask = _mm_set1_epi32((int)0xFFFF0000);
+            const __m128i invalid = _mm_or_si128(_mm_or_si128(_mm_and_si128(v[0], high_mask), _mm_and_si128(v[1], high_mask)), _mm_or_si128(_mm_and_si128(v[2], high_mask), _mm_and_si128(v[3], high_mask)));
+            if (_mm_movemask_epi8(_mm_cmpeq_epi8(invalid, zero)) != 0xFFFF)
+            {
+                // Some characters are above 0xFFFF: count this block with the scalar code
+                const ImWchar* block_end = in_text + 16;
+                while (in_text < block_end && *in_text)
+                    bytes_count += ImTextCountUtf8BytesFromChar((unsigned int)*in_text++);
+                if (in_text < block_end)
+                    break;
+                continue;
+            }
+            const __m128i bias32 = _mm_set1_epi32(0x8000);
+            const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+            const __m128i lo = _mm_add_epi16(_mm_packs_epi32(_mm_sub_epi32(v[0], bias32), _mm_sub_epi32(v[1], bias32)), bias16);
+            const __m128i hi = _mm_add_epi16(_mm_packs_epi32(_mm_sub_epi32(v[2], bias32), _mm_sub_epi32(v[3], bias32)), bias16);
+#else
+            const __m128i lo = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 0));
+            const __m128i hi = _mm_loadu_si128((const __m128i*)(const void*)(in_text + 8));
+#endif
+            if (_mm_movemask_epi8(_mm_or_si128(_mm_cmpeq_epi16(lo, zero), _mm_cmpeq_epi16(hi, zero))) != 0)
+                break;
+            const __m128i mask_2 = _mm_set1_epi16((short)0xFF80);
+            const __m128i mask_3 = _mm_set1_epi16((short)0xF800);
+            const __m128i one = _mm_set1_epi16(1);
+            // ((c & mask) == 0) is -1 or 0, adding 1 gives 1 when c is above the threshold
+            const __m128i extra_lo = _mm_add_epi16(_mm_add_epi16(_mm_cmpeq_epi16(_mm_and_si128(lo, mask_2), zero), one), _mm_add_epi16(_mm_cmpeq_epi16(_mm_and_si128(lo, mask_3), zero), one));
+            const __m128i extra_hi = _mm_add_epi16(_mm_add_epi16(_mm_cmpeq_epi16(_mm_and_si128(hi, mask_2), zero), one), _mm_add_epi16(_mm_cmpeq_epi16(_mm_and_si128(hi, mask_3), zero), one));
+            extra_bytes_acc = _mm_add_epi64(extra_bytes_acc, _mm_sad_epu8(_mm_packus_epi16(extra_lo, extra_hi), zero));
+            in_text += 16;
+            bytes_count += 16;
+        }
+        bytes_count += _mm_cvtsi128_si32(extra_bytes_acc) + _mm_cvtsi128_si32(_mm_srli_si128(extra_bytes_acc, 8));
+    }
+#endif
     while ((!in_text_end || in_text < in_text_end) && *in_text)
     {
         unsigned int c = (unsigned int)(*in_text++);
@@ -1864,6 +2171,63 @@ static ImGuiStorage::ImGuiStoragePair* LowerBound(ImVector<ImGuiStorage::ImGuiSt
     return first;
 }
 
+// Hash index: linear probing over a power-of-two table of indices into Data[], kept at most half full.
+// Keys are usually already hashes, but user keys may be sequential so we scramble them first.
+static inline int HashIndexFirstSlot(ImGuiID key, int table_size)
+{
+    key ^= key >> 16;
+    key *= 0x45D9F3Bu;
+    key ^= key >> 16;
+    return (int)(key & (ImGuiID)(table_size - 1));
+}
+
+static int HashIndexFindSlot(const ImVector<ImGuiStorage::ImGuiStoragePair>& data, const ImVector<int>& hash_index, ImGuiID key)
+{
+    const int mask = hash_index.Size - 1;
+    for (int slot = HashIndexFirstSlot(key, hash_index.Size); ; slot = (slot + 1) & mask)
+    {
+        const int data_idx = hash_index.Data[slot];
+        if (data_idx == -1 || data.Data[data_idx].key == key)
+            return slot;
+    }
+}
+
+static void HashIndexRebuild(const ImVector<ImGuiStorage::ImGuiStoragePair>& data, ImVector<int>& hash_index)
+{
+    int table_size = 16;
+    while (table_size < data.Size * 2 + 2)
+        table_size *= 2;
+    hash_index.resize(table_size);
+    memset(hash_index.Data, 0xFF, (size_t)hash_index.size_in_bytes());
+    for (int data_idx = 0; data_idx < data.Size; data_idx++)
+    {
+        int slot = HashIndexFindSlot(data, hash_index, data.Data[data_idx].key);
+        if (hash_index.Data[slot] == -1) // Skip duplicate keys (only possible if user pushed to Data[] directly)
+            hash_index.Data[slot] = data_idx;
+    }
+}
+
+// Return index of pair in Data[] or -1
+static int HashIndexFind(const ImVector<ImGuiStorage::ImGuiStoragePair>& data, const ImVector<int>& hash_index, ImGuiID key)
+{
+    if (hash_index.Size == 0)
+        return -1;
+    return hash_index.Data[HashIndexFindSlot(data, hash_index, key)];
+}
+
+// Return pair matching 'key', inserting 'default_pair' if missing
+static ImGuiStorage::ImGuiStoragePair* HashIndexFindOrInsert(ImVector<ImGuiStorage::ImGuiStoragePair>& data, ImVector<int>& hash_index, const ImGuiStorage::ImGuiStoragePair& default_pair)
+{
+    if ((data.Size + 1) * 2 > hash_index.Size)
+        HashIndexRebuild(data, hash_index);
+    const int slot = HashIndexFindSlot(data, hash_index, default_pair.key);
+    if (hash_index.Data[slot] != -1)
+        return &data.Data[hash_index.Data[slot]];
+    hash_index.Data[slot] = data.Size;
+    data.push_back(default_pair);
+    return &data.back();
+}
+
 // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
 void ImGuiStorage::BuildSortByKey()
 {
@@ -1879,14 +2243,74 @@ void ImGuiStorage::BuildSortByKey()
     };
     if (Data.Size > 1)
         ImQsort(Data.Data, (size_t)Data.Size, sizeof(ImGuiStoragePair), StaticFunc::PairCompareByID);
+    if (UseHashIndex)
+    {
+        HashIndexRebuild(Data, HashIndex);
+        HashIndexDataSize = Data.Size;
+    }
+}
+
+void ImGuiStorage::SetUseHashIndex(bool use_hash_index)
+{
+    if (UseHashIndex == use_hash_index)
+        return;
+    UseHashIndex = use_hash_index;
+    if (use_hash_index)
+    {
+        HashIndexRebuild(Data, HashIndex);
+        HashIndexDataSize = Data.Size;
+    }
+    else
+    {
+        HashIndex.clear();
+        HashIndexDataSize = 0;
+        BuildSortByKey();
+    }
+}
+
+// Rebuild the hash index if pairs were added to or removed from Data[] without going through ImGuiStorage functions
+static void HashIndexValidate(ImGuiStorage* storage)
+{
+    if (storage->HashIndexDataSize == storage->Data.Size)
+        return;
+    HashIndexRebuild(storage->Data, storage->HashIndex);
+    storage->HashIndexDataSize = storage->Data.Size;
+}
+
+// Find pair matching 'key' or return NULL
+static ImGuiStorage::ImGuiStoragePair* FindPair(const ImGuiStorage* storage, ImGuiID key)
+{
+    ImVector<ImGuiStorage::ImGuiStoragePair>& data = const_cast<ImVector<ImGuiStorage::ImGuiStoragePair>&>(storage->Data);
+    if (storage->UseHashIndex)
+    {
+        HashIndexValidate(const_cast<ImGuiStorage*>(storage));
+        int data_idx = HashIndexFind(data, storage->HashIndex, key);
+        return (data_idx != -1) ? &data.Data[data_idx] : NULL;
+    }
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(data, key);
+    return (it == data.end() || it->key != key) ? NULL : it;
+}
+
+// Find pair matching 'default_pair.key', insert 'default_pair' if missing
+static ImGuiStorage::ImGuiStoragePair* FindOrInsertPair(ImGuiStorage* storage, const ImGuiStorage::ImGuiStoragePair& default_pair)
+{
+    if (storage->UseHashIndex)
+    {
+        HashIndexValidate(storage);
+        ImGuiStorage::ImGuiStoragePair* pair = HashIndexFindOrInsert(storage->Data, storage->HashIndex, default_pair);
+        storage->HashIndexDataSize = storage->Data.Size;
+        return pair;
+    }
+    ImGuiStorage::ImGuiStoragePair* it = LowerBound(storage->Data, default_pair.key);
+    if (it == storage->Data.end() || it->key != default_pair.key)
+        it = storage->Data.insert(it, default_pair);
+    return it;
 }
 
 int ImGuiStorage::GetInt(ImGuiID key, int default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_i;
+    ImGuiStoragePair* it = FindPair(this, key);
+    return it ? it->val_i : default_val;
 }
 
 bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
@@ -1896,27 +2320,20 @@ bool ImGuiStorage::GetBool(ImGuiID key, bool default_val) const
 
 float ImGuiStorage::GetFloat(ImGuiID key, float default_val) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return default_val;
-    return it->val_f;
+    ImGuiStoragePair* it = FindPair(this, key);
+    return it ? it->val_f : default_val;
 }
 
 void* ImGuiStorage::GetVoidPtr(ImGuiID key) const
 {
-    ImGuiStoragePair* it = LowerBound(const_cast<ImVector<ImGuiStoragePair>&>(Data), key);
-    if (it == Data.end() || it->key != key)
-        return NULL;
-    return it->val_p;
+    ImGuiStoragePair* it = FindPair(this, key);
+    return it ? it->val_p : NULL;
 }
 
 // References are only valid until a new value is added to the storage. Calling a Set***() function or a Get***Ref() function invalidates the pointer.
 int* ImGuiStorage::GetIntRef(ImGuiID key, int default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_i;
+    return &FindOrInsertPair(this, ImGuiStoragePair(key, default_val))->val_i;
 }
 
 bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
@@ -1926,30 +2343,18 @@ bool* ImGuiStorage::GetBoolRef(ImGuiID key, bool default_val)
 
 float* ImGuiStorage::GetFloatRef(ImGuiID key, float default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_f;
+    return &FindOrInsertPair(this, ImGuiStoragePair(key, default_val))->val_f;
 }
 
 void** ImGuiStorage::GetVoidPtrRef(ImGuiID key, void* default_val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-        it = Data.insert(it, ImGuiStoragePair(key, default_val));
-    return &it->val_p;
+    return &FindOrInsertPair(this, ImGuiStoragePair(key, default_val))->val_p;
 }
 
-// FIXME-OPT: Need a way to reuse the result of lower_bound when doing GetInt()/SetInt() - not too bad because it only happens on explicit interaction (maximum one a frame)
+// Inserting with the value directly avoids a second lookup when the key is missing.
 void ImGuiStorage::SetInt(ImGuiID key, int val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_i = val;
+    FindOrInsertPair(this, ImGuiStoragePair(key, val))->val_i = val;
 }
 
 void ImGuiStorage::SetBool(ImGuiID key, bool val)
@@ -1959,24 +2364,12 @@ void ImGuiStorage::SetBool(ImGuiID key, bool val)
 
 void ImGuiStorage::SetFloat(ImGuiID key, float val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_f = val;
+    FindOrInsertPair(this, ImGuiStoragePair(key, val))->val_f = val;
 }
 
 void ImGuiStorage::SetVoidPtr(ImGuiID key, void* val)
 {
-    ImGuiStoragePair* it = LowerBound(Data, key);
-    if (it == Data.end() || it->key != key)
-    {
-        Data.insert(it, ImGuiStoragePair(key, val));
-        return;
-    }
-    it->val_p = val;
+    FindOrInsertPair(this, ImGuiStoragePair(key, val))->val_p = val;
 }
 
 void ImGuiStorage::SetAllInt(int v)
@@ -1992,6 +2385,7 @@ void ImGuiStorage::SetAllInt(int v)
 // Helper: Parse and apply text filters. In format "aaaaa[,bbbb][,ccccc]"
 ImGuiTextFilter::ImGuiTextFilter(const char* default_filter)
 {
+    Generation = 0;
     if (default_filter)
     {
         ImStrncpy(InputBuf, default_filter, IM_ARRAYSIZE(InputBuf));
@@ -2034,6 +2428,8 @@ void ImGuiTextFilter::ImGuiTextRange::split(char separator, ImVector<ImGuiTextRa
 
 void ImGuiTextFilter::Build()
 {
+    Generation++;
+
     Filters.resize(0);
     ImGuiTextRange input_range(InputBuf, InputBuf + strlen(InputBuf));
     input_range.split(',', &Filters);
@@ -2059,7 +2455,9 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
         return true;
 
     if (text == NULL)
-        text = "";
+        text = text_end = "";
+    if (text_end == NULL)
+        text_end = text + strlen(text);
 
     for (int i = 0; i != Filters.Size; i++)
     {
@@ -2069,7 +2467,7 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
         if (f.b[0] == '-')
         {
             // Subtract
-            if (ImStristr(text, text_end, f.b + 1, f.e) != NULL)
+            if (f.b + 1 < f.e && ImStristr(text, text_end, f.b + 1, f.e) != NULL)
                 return false;
         }
         else
@@ -2087,6 +2485,42 @@ bool ImGuiTextFilter::PassFilter(const char* text, const char* text_end) const
     return false;
 }
 
+void ImGuiTextFilterIndex::InvalidateFrom(int idx)
+{
+    while (Items.Size > 0 && Items.back() >= idx)
+        Items.pop_back();
+    ItemsCount = ImMin(ItemsCount, idx);
+}
+
+void ImGuiTextFilterIndex::Update(const ImGuiTextFilter& filter, int items_count, void (*items_getter)(void* data, int idx, const char** out_text, const char** out_text_end), void* data)
+{
+    // Test everything again when the filter changed or when items were removed
+    if (Filter != &filter || FilterGeneration != filter.Generation || items_count < ItemsCount)
+    {
+        Items.resize(0);
+        ItemsCount = 0;
+        Filter = &filter;
+        FilterGeneration = filter.Generation;
+    }
+    PassAll = !filter.IsActive();
+    if (PassAll)
+    {
+        ItemsCount = items_count;
+        return;
+    }
+
+    // Only test new items
+    for (int idx = ItemsCount; idx < items_count; idx++)
+    {
+        const char* text = NULL;
+        const char* text_end = NULL;
+        items_getter(data, idx, &text, &text_end);
+        if (filter.PassFilter(text, text_end))
+            Items.push_back(idx);
+    }
+    ItemsCount = items_count;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImGuiTextBuffer
 //-----------------------------------------------------------------------------
@@ -2170,6 +2604,19 @@ static bool GetSkipItemForListClipping()
     return (g.CurrentTable ? g.CurrentTable->HostSkipItems : g.CurrentWindow->SkipItems);
 }
 
+// We create the union of the ClipRect and the NavScoringRect which at worst should be 1 page away from ClipRect
+static ImRect GetUnclippedRectForListClipping()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    ImRect unclipped_rect = window->ClipRect;
+    if (g.NavMoveRequest)
+        unclipped_rect.Add(g.NavScoringRect);
+    if (g.NavJustMovedToId && window->NavLastIds[0] == g.NavJustMovedToId)
+        unclipped_rect.Add(ImRect(window->Pos + window->NavRectRel[0].Min, window->Pos + window->NavRectRel[0].Max));
+    return unclipped_rect;
+}
+
 // Helper to calculate coarse clipping of large list of evenly sized items.
 // NB: Prefer using the ImGuiListClipper higher-level helper if you can! Read comments and instructions there on how those use this sort of pattern.
 // NB: 'items_count' is only used to clamp the result, if you don't know your count you can use INT_MAX
@@ -2190,13 +2637,7 @@ void ImGui::CalcListClipping(int items_count, float items_height, int* out_items
         return;
     }
 
-    // We create the union of the ClipRect and the NavScoringRect which at worst should be 1 page away from ClipRect
-    ImRect unclipped_rect = window->ClipRect;
-    if (g.NavMoveRequest)
-        unclipped_rect.Add(g.NavScoringRect);
-    if (g.NavJustMovedToId && window->NavLastIds[0] == g.NavJustMovedToId)
-        unclipped_rect.Add(ImRect(window->Pos + window->NavRectRel[0].Min, window->Pos + window->NavRectRel[0].Max));
-
+    const ImRect unclipped_rect = GetUnclippedRectForListClipping();
     const ImVec2 pos = window->DC.CursorPos;
     int start = (int)((unclipped_rect.Min.y - pos.y) / items_height);
     int end = (int)((unclipped_rect.Max.y - pos.y) / items_height);
@@ -2268,6 +2709,38 @@ void ImGuiListClipper::Begin(int items_count, float items_height)
     StepNo = 0;
     DisplayStart = -1;
     DisplayEnd = 0;
+    ItemsHeights = NULL;
+}
+
+void ImGuiListClipper::BeginVariableHeights(int items_count, ImGuiListItemHeights* items_heights)
+{
+    IM_ASSERT(items_count >= 0 && items_count < INT_MAX && items_heights != NULL);
+    Begin(items_count, 0.0f);
+    ItemsHeights = items_heights;
+    if (items_heights->Size() != items_count)
+        items_heights->Resize(items_count, items_heights->DefaultHeight > 0.0f ? items_heights->DefaultHeight : ImGui::GetTextLineHeightWithSpacing());
+}
+
+// Position of an item relative to StartPosY
+static float GetListClipperItemOffset(const ImGuiListClipper* clipper, int item_index)
+{
+    if (clipper->ItemsHeights != NULL)
+        return clipper->ItemsHeights->GetItemOffset(item_index) - clipper->ItemsHeights->GetItemOffset(clipper->ItemsFrozen);
+    return (item_index - clipper->ItemsFrozen) * clipper->ItemsHeight;
+}
+
+void ImGuiListClipper::ScrollToItem(int item_index, float center_y_ratio)
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiWindow* window = g.CurrentWindow;
+    IM_ASSERT(StepNo == 0 && item_index >= 0 && item_index < ItemsCount);
+    IM_ASSERT((ItemsHeights != NULL || ItemsHeight > 0.0f) && "Need variable heights or a known item height.");
+
+    // Same as SetScrollHereY() with the cursor on the item
+    const float item_pos_y = StartPosY + GetListClipperItemOffset(this, item_index);
+    const float item_height = ItemsHeights ? ItemsHeights->GetItemHeight(item_index) : ItemsHeight;
+    const float target_pos_y = ImLerp(item_pos_y - g.Style.ItemSpacing.y, item_pos_y + item_height, center_y_ratio);
+    ImGui::SetScrollFromPosY(target_pos_y - window->Pos.y, center_y_ratio);
 }
 
 void ImGuiListClipper::End()
@@ -2276,7 +2749,9 @@ void ImGuiListClipper::End()
         return;
 
     // In theory here we should assert that ImGui::GetCursorPosY() == StartPosY + DisplayEnd * ItemsHeight, but it feels saner to just seek at the end and not assert/crash the user.
-    if (ItemsCount < INT_MAX && DisplayStart >= 0)
+    if (ItemsHeights != NULL && DisplayStart >= 0)
+        SetCursorPosYAndSetupForPrevLine(StartPosY + GetListClipperItemOffset(this, ItemsCount), ItemsHeights->GetItemHeight(ItemsCount - 1));
+    else if (ItemsCount < INT_MAX && DisplayStart >= 0)
         SetCursorPosYAndSetupForPrevLine(StartPosY + (ItemsCount - ItemsFrozen) * ItemsHeight, ItemsHeight);
     ItemsCount = -1;
     StepNo = 3;
@@ -2312,6 +2787,24 @@ bool ImGuiListClipper::Step()
         }
 
         StartPosY = window->DC.CursorPos.y;
+        if (ItemsHeights != NULL)
+        {
+            // Variable heights: seek cursor to the first visible item
+            int start = g.LogEnabled ? 0 : ItemsHeights->FindItemAtOffset(GetUnclippedRectForListClipping().Min.y - StartPosY + ItemsHeights->GetItemOffset(ItemsFrozen));
+            if (g.NavMoveRequest && g.NavMoveClipDir == ImGuiDir_Up)
+                start--;
+            start = ImClamp(start, ItemsFrozen, ItemsCount);
+            if (start > ItemsFrozen)
+                SetCursorPosYAndSetupForPrevLine(StartPosY + GetListClipperItemOffset(this, start), ItemsHeights->GetItemHeight(start - 1));
+            DisplayStart = start;
+            DisplayEnd = start + 1;
+            ItemPosY = window->DC.CursorPos.y;
+            StepNo = 4;
+            if (DisplayStart < ItemsCount)
+                return true;
+            End();
+            return false;
+        }
         if (ItemsHeight <= 0.0f)
         {
             // Submit the first item so we can measure its height (generally it is 0..1)
@@ -2326,6 +2819,28 @@ bool ImGuiListClipper::Step()
         StepNo = 2;
     }
 
+    // Step 4: variable heights: store the height of the item we just submitted, then submit the next one if it is visible.
+    if (StepNo == 4)
+    {
+        const float item_pos_y = window->DC.CursorPos.y;
+        const float item_height = item_pos_y - ItemPosY;
+        IM_ASSERT(item_height >= 0.0f && "Cursor moved backward while submitting item!");
+        if (ItemsHeights->GetItemHeight(DisplayStart) != item_height)
+            ItemsHeights->SetItemHeight(DisplayStart, item_height);
+
+        // When performing a navigation request, ensure we have one item extra in the direction we are moving to
+        const float visible_max_y = GetUnclippedRectForListClipping().Max.y;
+        const bool visible = g.LogEnabled || item_pos_y < visible_max_y || (g.NavMoveRequest && g.NavMoveClipDir == ImGuiDir_Down && ItemPosY < visible_max_y);
+        DisplayStart++;
+        DisplayEnd = DisplayStart + 1;
+        ItemPosY = item_pos_y;
+        if (DisplayStart < ItemsCount && visible)
+            return true;
+        DisplayEnd = DisplayStart;
+        End();
+        return false;
+    }
+
     // Step 1: the clipper infer height from first element
     if (StepNo == 1)
     {
@@ -2385,6 +2900,79 @@ bool ImGuiListClipper::Step()
     return false;
 }
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImGuiListItemHeights
+//-----------------------------------------------------------------------------
+
+void ImGuiListItemHeights::Clear()
+{
+    Heights.clear();
+    Sums.clear();
+}
+
+void ImGuiListItemHeights::Resize(int items_count, float default_height)
+{
+    IM_ASSERT(items_count >= 0);
+    DefaultHeight = default_height;
+    if (items_count <= Heights.Size)
+    {
+        // Sums[n] only covers items up to n, so truncating the tree leaves it valid
+        Heights.resize(items_count);
+        Sums.resize(items_count);
+        return;
+    }
+    Heights.reserve(items_count);
+    Sums.reserve(items_count);
+    while (Heights.Size < items_count)
+    {
+        // New node covers the new item plus the nodes of its range, which are all already in the tree
+        const int i = Heights.Size + 1;
+        double sum = default_height;
+        for (int j = i - 1; j > i - (i & -i); j -= (j & -j))
+            sum += Sums[j - 1];
+        Heights.push_back(default_height);
+        Sums.push_back(sum);
+    }
+}
+
+void ImGuiListItemHeights::SetItemHeight(int item_index, float height)
+{
+    IM_ASSERT(item_index >= 0 && item_index < Heights.Size);
+    const double delta = (double)height - (double)Heights[item_index];
+    Heights[item_index] = height;
+    for (int i = item_index + 1; i <= Sums.Size; i += (i & -i))
+        Sums[i - 1] += delta;
+}
+
+float ImGuiListItemHeights::GetItemOffset(int item_index) const
+{
+    IM_ASSERT(item_index >= 0 && item_index <= Heights.Size);
+    double offset = 0.0;
+    for (int i = item_index; i > 0; i -= (i & -i))
+        offset += Sums[i - 1];
+    return (float)offset;
+}
+
+int ImGuiListItemHeights::FindItemAtOffset(float offset) const
+{
+    if (Heights.Size == 0 || offset <= 0.0f)
+        return 0;
+
+    // Descend the tree from its largest power of two, skipping all nodes which end before 'offset'
+    int item_count = 0;
+    double remaining = offset;
+    int step = 1;
+    while (step * 2 <= Sums.Size)
+        step *= 2;
+    for (; step > 0; step >>= 1)
+        if (item_count + step <= Sums.Size && Sums[item_count + step - 1] <= remaining)
+        {
+            item_count += step;
+            remaining -= Sums[item_count - 1];
+        }
+    return ImMin(item_count, Heights.Size - 1);
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] STYLING
 //-----------------------------------------------------------------------------
@@ -3000,6 +3588,7 @@ void ImGui::GcCompactTransientWindowBuffers(ImGuiWindow* window)
     window->MemoryDrawListVtxCapacity = window->DrawList->VtxBuffer.Capacity;
     window->IDStack.clear();
     window->DrawList->_ClearFreeMemory();
+    window->DrawListRetained.ClearFreeMemory();
     window->DC.ChildWindows.clear();
     window->DC.ItemWidthStack.clear();
     window->DC.TextWrapPosStack.clear();
@@ -3285,23 +3874,193 @@ float ImGui::CalcWrapWidthForPos(const ImVec2& pos, float wrap_pos_x)
     return ImMax(wrap_pos_x - pos.x, 1.0f);
 }
 
+static const char* const GMemCategoryNames[] = { "Other", "Window", "DrawList", "Table", "InputText", "Settings", "Font" };
+IM_STATIC_ASSERT(IM_ARRAYSIZE(GMemCategoryNames) == ImGuiMemCategory_COUNT);
+
+// Called by MemAlloc() for heap allocations made while the zero-allocation check is active
+static void DebugReportZeroAllocCheck(ImGuiContext* ctx, size_t size)
+{
+    ImGuiContext& g = *ctx;
+    ImGuiDebugAllocReport* report = &g.DebugZeroAllocCheckReports[g.DebugZeroAllocCheckCount % IM_ARRAYSIZE(g.DebugZeroAllocCheckReports)];
+    report->Frame = g.FrameCount;
+    report->Category = g.MemCategory;
+    report->WindowID = g.CurrentWindow ? g.CurrentWindow->ID : 0;
+    report->Size = size;
+    g.DebugZeroAllocCheckCount++;
+    if (g.DebugZeroAllocCheckLog)
+        IMGUI_DEBUG_LOG("Heap allocation of %d bytes after warm-up, category %s, window '%s'\n", (int)size, GMemCategoryNames[g.MemCategory], g.CurrentWindow ? g.CurrentWindow->Name : "NULL");
+    if (g.DebugZeroAllocCheckBreak)
+        IM_DEBUG_BREAK(); // Allocation after warm-up! Look up the call-stack to find the owner.
+}
+
+// ImFrameArena
+#define IM_FRAME_ARENA_BLOCK_SIZE_MIN       (16 * 1024)
+#define IM_FRAME_ARENA_ALLOC_SIZE_MAX       (64 * 1024)     // Larger transient allocations are made on the heap
+
+// The frame arena, allocation category and counters are not synchronized: they are only used by the thread calling NewFrame().
+// Other threads (e.g. recording a detached ImDrawList, or building fonts with ImFontAtlas::BuildParallelForFunc) allocate straight from the heap.
+// The address of a thread-local variable tells threads apart. Without compiler support for thread-local storage all threads are trusted to be the same.
+#ifdef IM_THREAD_LOCAL
+static IM_THREAD_LOCAL char                 GImMemThreadMarker = 0;
+static inline const void*                   GetMemThreadMarker()                    { return &GImMemThreadMarker; }
+#else
+static inline const void*                   GetMemThreadMarker()                    { return NULL; }
+#endif
+static inline bool                          IsMemOwnerThread(ImGuiContext* ctx)     { return ctx->MemOwnerThread == GetMemThreadMarker(); }
+
 // IM_ALLOC() == ImGui::MemAlloc()
 void* ImGui::MemAlloc(size_t size)
 {
-    if (ImGuiContext* ctx = GImGui)
+    ImGuiContext* ctx = GImGui;
+    if (ctx && IsMemOwnerThread(ctx))
+    {
+        // Transient allocation (see PushFrameArenaAllocator). Larger ones go to the heap so the arena doesn't keep them reserved forever.
+        if (ctx->FrameArenaAllocatorDepth > 0 && size <= IM_FRAME_ARENA_ALLOC_SIZE_MAX)
+        {
+            const int backup_depth = ctx->FrameArenaAllocatorDepth;
+            ctx->FrameArenaAllocatorDepth = 0; // Arena blocks are allocated from the heap
+            void* ptr = ctx->FrameArena.Alloc(size);
+            ctx->FrameArenaAllocatorDepth = backup_depth;
+            return ptr;
+        }
         ctx->IO.MetricsActiveAllocations++;
+        ImGuiMemCategoryStats* stats = &ctx->MemStats[ctx->MemCategory];
+        stats->AllocCount++;
+        stats->AllocCountThisFrame++;
+        stats->AllocBytes += size;
+        stats->AllocBytesThisFrame += size;
+        if (ctx->DebugZeroAllocCheckActive && ctx->FrameCount >= ctx->DebugZeroAllocCheckStartFrame)
+            DebugReportZeroAllocCheck(ctx, size);
+    }
     return GImAllocatorAllocFunc(size, GImAllocatorUserData);
 }
 
 // IM_FREE() == ImGui::MemFree()
 void ImGui::MemFree(void* ptr)
 {
-    if (ptr)
-        if (ImGuiContext* ctx = GImGui)
-            ctx->IO.MetricsActiveAllocations--;
+    ImGuiContext* ctx = GImGui;
+    if (ptr && ctx && IsMemOwnerThread(ctx))
+    {
+        if (ctx->FrameArena.Blocks != NULL && ctx->FrameArena.Contains(ptr))
+            return;
+        ctx->IO.MetricsActiveAllocations--;
+    }
     return GImAllocatorFreeFunc(ptr, GImAllocatorUserData);
 }
 
+ImGuiMemCategory ImGui::SetMemCategory(ImGuiMemCategory category)
+{
+    ImGuiContext* ctx = GImGui;
+    if (ctx == NULL || !IsMemOwnerThread(ctx))
+        return ImGuiMemCategory_Other;
+    ImGuiMemCategory backup_category = ctx->MemCategory;
+    ctx->MemCategory = category;
+    return backup_category;
+}
+
+// After 'warmup_frames' more frames (counting from the next NewFrame() call), a steady UI is expected to not make any heap allocation.
+// Allocations made past this point are recorded in g.DebugZeroAllocCheckReports[] and displayed in Metrics->Memory.
+void ImGui::DebugStartZeroAllocCheck(int warmup_frames, bool break_on_alloc, bool log_allocs)
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(warmup_frames >= 0);
+    g.DebugZeroAllocCheckActive = true;
+    g.DebugZeroAllocCheckBreak = break_on_alloc;
+    g.DebugZeroAllocCheckLog = log_allocs;
+    g.DebugZeroAllocCheckStartFrame = g.FrameCount + 1 + warmup_frames;
+    g.DebugZeroAllocCheckCount = 0;
+}
+
+const char* ImGui::GetMemCategoryName(ImGuiMemCategory category)
+{
+    IM_ASSERT(category >= 0 && category < ImGuiMemCategory_COUNT);
+    return GMemCategoryNames[category];
+}
+
+void ImGui::PushFrameArenaAllocator()
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(IsMemOwnerThread(&g) && "Frame arena can only be used by the thread calling NewFrame()!");
+    g.FrameArenaAllocatorDepth++;
+}
+
+void ImGui::PopFrameArenaAllocator()
+{
+    ImGuiContext& g = *GImGui;
+    IM_ASSERT(g.FrameArenaAllocatorDepth > 0 && "Calling PopFrameArenaAllocator() too many times!");
+    g.FrameArenaAllocatorDepth--;
+}
+
+// Header of each ImFrameArena block, followed by the allocated data
+struct ImFrameArenaBlock
+{
+    ImFrameArenaBlock*  Next;
+    size_t              Size;       // Usable size
+    size_t              UsedSize;
+};
+#define IM_FRAME_ARENA_BLOCK_HEADER_SIZE    ((sizeof(ImFrameArenaBlock) + 15) & ~(size_t)15)
+
+void* ImFrameArena::Alloc(size_t size)
+{
+    size = (size + 15) & ~(size_t)15;
+    ImFrameArenaBlock* block = Blocks;
+    if (block == NULL || block->UsedSize + size > block->Size)
+    {
+        // Double total capacity on each new block
+        const size_t block_size = ImMax(ImMax(size, (size_t)IM_FRAME_ARENA_BLOCK_SIZE_MIN), CapacitySize);
+        block = (ImFrameArenaBlock*)IM_ALLOC(IM_FRAME_ARENA_BLOCK_HEADER_SIZE + block_size);
+        block->Next = Blocks;
+        block->Size = block_size;
+        block->UsedSize = 0;
+        Blocks = block;
+        BlocksCount++;
+        CapacitySize += block_size;
+    }
+    void* ptr = (char*)block + IM_FRAME_ARENA_BLOCK_HEADER_SIZE + block->UsedSize;
+    block->UsedSize += size;
+    UsedSize += size;
+    PeakUsedSize = ImMax(PeakUsedSize, UsedSize);
+    return ptr;
+}
+
+bool ImFrameArena::Contains(const void* ptr) const
+{
+    for (const ImFrameArenaBlock* block = Blocks; block != NULL; block = block->Next)
+    {
+        const char* data = (const char*)block + IM_FRAME_ARENA_BLOCK_HEADER_SIZE;
+        if ((const char*)ptr >= data && (const char*)ptr < data + block->Size)
+            return true;
+    }
+    return false;
+}
+
+void ImFrameArena::Reset()
+{
+    if (BlocksCount > 1)
+    {
+        // Replace all blocks by a single one which would have fit all of them
+        const size_t capacity = CapacitySize;
+        const size_t peak_used_size = PeakUsedSize;
+        Clear();
+        PeakUsedSize = peak_used_size;
+        Alloc(capacity);
+    }
+    if (Blocks != NULL)
+        Blocks->UsedSize = 0;
+    UsedSize = 0;
+}
+
+void ImFrameArena::Clear()
+{
+    while (ImFrameArenaBlock* block = Blocks)
+    {
+        Blocks = block->Next;
+        IM_FREE(block);
+    }
+    BlocksCount = 0;
+    UsedSize = PeakUsedSize = CapacitySize = 0;
+}
+
 const char* ImGui::GetClipboardText()
 {
     ImGuiContext& g = *GImGui;
@@ -3354,6 +4113,7 @@ void ImGui::GetAllocatorFunctions(ImGuiMemAllocFunc** p_alloc_func, ImGuiMemFree
 ImGuiContext* ImGui::CreateContext(ImFontAtlas* shared_font_atlas)
 {
     ImGuiContext* ctx = IM_NEW(ImGuiContext)(shared_font_atlas);
+    ctx->MemOwnerThread = GetMemThreadMarker();
     if (GImGui == NULL)
         SetCurrentContext(ctx);
     Initialize(ctx);
@@ -3424,6 +4184,12 @@ int ImGui::GetFrameCount()
     return GImGui->FrameCount;
 }
 
+void ImGui::SetMaxWaitBeforeNextFrame(float seconds)
+{
+    ImGuiContext& g = *GImGui;
+    g.WaitBeforeNextFrame = ImMin(g.WaitBeforeNextFrame, ImMax(seconds, 0.0f));
+}
+
 static ImDrawList* GetViewportDrawList(ImGuiViewportP* viewport, size_t drawlist_no, const char* drawlist_name)
 {
     // Create the draw list on demand, because they are not frequently used for all viewports
@@ -3864,6 +4630,19 @@ void ImGui::NewFrame()
 
     CallContextHooks(&g, ImGuiContextHookType_NewFramePre);
 
+    // Release transient allocations, rotate per-frame allocation counters
+    IM_ASSERT(g.FrameArenaAllocatorDepth == 0 && "Missing PopFrameArenaAllocator()?");
+    g.MemOwnerThread = GetMemThreadMarker();
+    g.FrameArena.Reset();
+    for (int category_n = 0; category_n < ImGuiMemCategory_COUNT; category_n++)
+    {
+        ImGuiMemCategoryStats* stats = &g.MemStats[category_n];
+        stats->AllocCountLastFrame = stats->AllocCountThisFrame;
+        stats->AllocBytesLastFrame = stats->AllocBytesThisFrame;
+        stats->AllocCountThisFrame = 0;
+        stats->AllocBytesThisFrame = 0;
+    }
+
     // Check and assert for various common IO and Configuration mistakes
     ErrorCheckNewFrameSanityChecks();
 
@@ -3873,6 +4652,7 @@ void ImGui::NewFrame()
     g.Time += g.IO.DeltaTime;
     g.WithinFrameScope = true;
     g.FrameCount += 1;
+    g.WaitBeforeNextFrame = FLT_MAX;
     g.TooltipOverrideCount = 0;
     g.WindowsActiveCount = 0;
     g.MenusIdSubmittedThisFrame.resize(0);
@@ -3886,6 +4666,7 @@ void ImGui::NewFrame()
     UpdateViewportsNewFrame();
 
     // Setup current font and draw list shared data
+    g.IO.Fonts->UpdateGlyphCache();
     g.IO.Fonts->Locked = true;
     SetCurrentFont(GetDefaultFont());
     IM_ASSERT(g.Font->IsLoaded());
@@ -3998,6 +4779,9 @@ void ImGui::NewFrame()
     // Update legacy TAB focus
     UpdateTabFocus();
 
+    // Rotate text size cache counters, grow or release the cache
+    UpdateTextSizeCache();
+
     // Mark all windows as not visible and compact unused memory.
     IM_ASSERT(g.WindowsFocusOrder.Size == g.Windows.Size);
     const float memory_compact_start_time = (g.GcCompactAll || g.IO.ConfigMemoryCompactTimer < 0.0f) ? FLT_MAX : (float)g.Time - g.IO.ConfigMemoryCompactTimer;
@@ -4164,6 +4948,7 @@ void ImGui::Shutdown(ImGuiContext* context)
     g.Tables.Clear();
     g.CurrentTableStack.clear();
     g.DrawChannelsTempMergeBuffer.clear();
+    g.TablesTempBitArrays.clear();
 
     g.ClipboardHandlerData.clear();
     g.MenusIdSubmittedThisFrame.clear();
@@ -4181,6 +4966,8 @@ void ImGui::Shutdown(ImGuiContext* context)
         g.LogFile = NULL;
     }
     g.LogBuffer.clear();
+    g.FrameArena.Clear();
+    g.TextSizeCache.Clear();
 
     g.Initialized = false;
 }
@@ -4216,6 +5003,9 @@ static void AddWindowToSortBuffer(ImVector<ImGuiWindow*>* out_sorted_windows, Im
 
 static void AddDrawListToDrawData(ImVector<ImDrawList*>* out_list, ImDrawList* draw_list)
 {
+    // Copy in contents of draw lists submitted with ImDrawList::AddDrawListDeferred(), now that they are complete.
+    draw_list->_SpliceDeferredDrawLists();
+
     // Remove trailing command if unused.
     // Technically we could return directly instead of popping, but this make things looks neat in Metrics/Debugger window as well.
     draw_list->_PopUnusedDrawCmd();
@@ -4289,6 +5079,26 @@ void ImDrawDataBuilder::FlattenIntoSingleLayer()
     }
 }
 
+// Update ImDrawList::ContentGeneration. Unless the backend opted in with ImGuiBackendFlags_RendererHasContentHash, lists are always reported as changed.
+static void UpdateDrawListContentGeneration(ImDrawList* draw_list)
+{
+    ImGuiContext& g = *GImGui;
+    bool unchanged = false;
+    if (g.IO.BackendFlags & ImGuiBackendFlags_RendererHasContentHash)
+    {
+        const ImU64 hash = draw_list->_CalcContentHash();
+        unchanged = (draw_list->ContentGeneration != 0 && draw_list->_ContentHash == hash);
+        draw_list->_ContentHash = hash;
+    }
+    if (!unchanged)
+    {
+        if (++g.DrawListContentGeneration == 0) // Skip 0 on wrap-around, it means "never rendered"
+            g.DrawListContentGeneration++;
+        draw_list->ContentGeneration = g.DrawListContentGeneration;
+    }
+    draw_list->ContentUnchanged = unchanged;
+}
+
 static void SetupViewportDrawData(ImGuiViewportP* viewport, ImVector<ImDrawList*>* draw_lists)
 {
     ImGuiIO& io = ImGui::GetIO();
@@ -4296,14 +5106,19 @@ static void SetupViewportDrawData(ImGuiViewportP* viewport, ImVector<ImDrawList*
     draw_data->Valid = true;
     draw_data->CmdLists = (draw_lists->Size > 0) ? draw_lists->Data : NULL;
     draw_data->CmdListsCount = draw_lists->Size;
+    draw_data->CmdListsUnchangedCount = 0;
     draw_data->TotalVtxCount = draw_data->TotalIdxCount = 0;
     draw_data->DisplayPos = viewport->Pos;
     draw_data->DisplaySize = viewport->Size;
     draw_data->FramebufferScale = io.DisplayFramebufferScale;
     for (int n = 0; n < draw_lists->Size; n++)
     {
-        draw_data->TotalVtxCount += draw_lists->Data[n]->VtxBuffer.Size;
-        draw_data->TotalIdxCount += draw_lists->Data[n]->IdxBuffer.Size;
+        ImDrawList* draw_list = draw_lists->Data[n];
+        UpdateDrawListContentGeneration(draw_list);
+        if (draw_list->ContentUnchanged)
+            draw_data->CmdListsUnchangedCount++;
+        draw_data->TotalVtxCount += draw_list->VtxBuffer.Size;
+        draw_data->TotalIdxCount += draw_list->IdxBuffer.Size;
     }
 }
 
@@ -4327,6 +5142,81 @@ void ImGui::PopClipRect()
     window->ClipRect = window->DrawList->_ClipRectStack.back();
 }
 
+// Compute how long the application may wait for new inputs before the next frame would produce a different output.
+// - Any input received or held this frame requires frames to be processed (key repeat, dragging, etc.).
+// - Many interactions take a frame or two to settle (e.g. hovering uses last frame's window positions, focus changes, popups
+//   and auto-resizing windows appearing). We hash the interaction state and window layout and require two consecutive frames
+//   ended without inputs nor changes.
+// - Time based visuals request frames with SetMaxWaitBeforeNextFrame() (InputText() cursor blinking, tab bar scrolling, etc.).
+static void ImGui::UpdateWaitBeforeNextFrame()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiIO& io = g.IO;
+    float wait = g.WaitBeforeNextFrame;
+
+    bool has_inputs = (io.MouseDelta.x != 0.0f || io.MouseDelta.y != 0.0f || io.MouseWheel != 0.0f || io.MouseWheelH != 0.0f || io.InputQueueCharacters.Size > 0);
+    for (int n = 0; n < IM_ARRAYSIZE(io.MouseDown) && !has_inputs; n++)
+        has_inputs = io.MouseDown[n] || io.MouseReleased[n];
+    for (int n = 0; n < IM_ARRAYSIZE(io.KeysDown) && !has_inputs; n++)
+        has_inputs = io.KeysDown[n] || io.KeysDownDurationPrev[n] >= 0.0f;
+    for (int n = 0; n < IM_ARRAYSIZE(io.NavInputs) && !has_inputs; n++)
+        has_inputs = io.NavInputs[n] > 0.0f || io.NavInputsDownDurationPrev[n] >= 0.0f;
+
+    // Pending requests and animations
+    bool animating = g.NavInitRequest || g.NavMoveRequest || g.NavMoveRequestForward != ImGuiNavForward_None || g.NavNextActivateId != 0;
+    animating |= g.NavWindowingTarget != NULL || g.NavWindowingTargetAnim != NULL || (g.DimBgRatio > 0.0f && g.DimBgRatio < 1.0f);
+    animating |= g.DragDropActive || g.MovingWindow != NULL;
+    animating |= (g.HoveredId != 0 && g.HoveredIdTimer < 1.0f); // Hover feedback appearing after a delay (resize borders, tooltips of clipped tabs and headers..)
+
+    // Interaction state and layout of visible windows
+    struct { ImGuiID HoveredId, ActiveId, NavId; ImGuiWindow* HoveredWindow; ImGuiWindow* NavWindow; int OpenPopupCount; bool NavDisableHighlight, NavDisableMouseHover, MousePosValid; } state;
+    memset(&state, 0, sizeof(state)); // Clear padding
+    state.HoveredId = g.HoveredId;
+    state.ActiveId = g.ActiveId;
+    state.NavId = g.NavId;
+    state.HoveredWindow = g.HoveredWindow;
+    state.NavWindow = g.NavWindow;
+    state.OpenPopupCount = g.OpenPopupStack.Size;
+    state.NavDisableHighlight = g.NavDisableHighlight;
+    state.NavDisableMouseHover = g.NavDisableMouseHover;
+    state.MousePosValid = IsMousePosValid();
+    ImU32 state_hash = ImHashData(&state, sizeof(state));
+    for (int n = 0; n < g.Windows.Size; n++)
+    {
+        ImGuiWindow* window = g.Windows[n];
+        if (!window->Active && !window->WasActive)
+            continue;
+        if (window->Active && (window->ScrollTarget.x != FLT_MAX || window->ScrollTarget.y != FLT_MAX || window->AutoFitFramesX > 0 || window->AutoFitFramesY > 0 ||
+            window->HiddenFramesCanSkipItems > 0 || window->HiddenFramesCannotSkipItems > 0 || window->WantCollapseToggle))
+            animating = true;
+        struct { ImGuiWindow* Window; ImVec2 Pos, Size, ContentSize, Scroll; bool Active, Collapsed, Hidden; } window_state;
+        memset(&window_state, 0, sizeof(window_state));
+        window_state.Window = window;
+        window_state.Pos = window->Pos;
+        window_state.Size = window->Size;
+        window_state.ContentSize = window->ContentSize;
+        window_state.Scroll = window->Scroll;
+        window_state.Active = window->Active;
+        window_state.Collapsed = window->Collapsed;
+        window_state.Hidden = window->Hidden;
+        state_hash = ImHashData(&window_state, sizeof(window_state), state_hash);
+    }
+
+    if (has_inputs || animating || state_hash != g.WaitStateHash)
+        g.WaitStableFrames = 0;
+    else
+        g.WaitStableFrames++;
+    g.WaitStateHash = state_hash;
+    if (g.WaitStableFrames < 2)
+        wait = 0.0f;
+
+    // Save .ini settings when the timer elapses
+    if (g.SettingsDirtyTimer > 0.0f)
+        wait = ImMin(wait, g.SettingsDirtyTimer);
+
+    io.WaitBeforeNextFrame = wait;
+}
+
 // This is normally called by Render(). You may want to call it directly if you want to avoid calling Render() but the gain will be very minimal.
 void ImGui::EndFrame()
 {
@@ -4402,6 +5292,9 @@ void ImGui::EndFrame()
     // Unlock font atlas
     g.IO.Fonts->Locked = false;
 
+    // Compute io.WaitBeforeNextFrame (before clearing inputs)
+    UpdateWaitBeforeNextFrame();
+
     // Clear Input data for next frame
     g.IO.MouseWheel = g.IO.MouseWheelH = 0.0f;
     g.IO.InputQueueCharacters.resize(0);
@@ -4414,6 +5307,7 @@ void ImGui::Render()
 {
     ImGuiContext& g = *GImGui;
     IM_ASSERT(g.Initialized);
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_DrawList);
 
     if (g.FrameCountEnded != g.FrameCount)
         EndFrame();
@@ -4466,9 +5360,139 @@ void ImGui::Render()
         g.IO.MetricsRenderIndices += draw_data->TotalIdxCount;
     }
 
+    // Count draw calls for Metrics, before and after merging them (the merge scans vertices, so only do it while Metrics displays the result)
+    if (g.DebugMetricsDrawCallsFrame == g.FrameCount)
+    {
+        g.DebugMetricsDrawCalls = g.DebugMetricsDrawCallsMerged = g.DebugMetricsDrawListsCount = g.DebugMetricsDrawListsUnchanged = 0;
+        for (int n = 0; n < g.Viewports.Size; n++)
+        {
+            const ImDrawData* draw_data = &g.Viewports[n]->DrawDataP;
+            for (int list_n = 0; list_n < draw_data->CmdListsCount; list_n++)
+            {
+                const ImDrawList* draw_list = draw_data->CmdLists[list_n];
+                for (int cmd_n = 0; cmd_n < draw_list->CmdBuffer.Size; cmd_n++)
+                    if (draw_list->CmdBuffer[cmd_n].ElemCount > 0 || draw_list->CmdBuffer[cmd_n].UserCallback != NULL)
+                        g.DebugMetricsDrawCalls++;
+            }
+            ImDrawDataMergeFlags merge_flags = ImDrawDataMergeFlags_MergeCmds | ImDrawDataMergeFlags_MergeContainedClip;
+            if (sizeof(ImDrawIdx) == 4 || draw_data->TotalVtxCount <= (1 << 16))
+                merge_flags |= ImDrawDataMergeFlags_RebaseIndices;
+            g.DebugMetricsDrawCallsMerged += draw_data->MergeBuffers(NULL, NULL, NULL, merge_flags);
+            g.DebugMetricsDrawListsCount += draw_data->CmdListsCount;
+            g.DebugMetricsDrawListsUnchanged += draw_data->CmdListsUnchangedCount;
+        }
+    }
+
     CallContextHooks(&g, ImGuiContextHookType_RenderPost);
 }
 
+// Lookup or measure text with the text size cache (io.ConfigTextSizeCache)
+// Short strings are measured directly: this is cheaper than a lookup in a large table.
+static ImVec2 CalcTextSizeCached(ImFont* font, float font_size, float wrap_width, const char* text, const char* text_end)
+{
+    ImGuiContext& g = *GImGui;
+    if (text_end == NULL)
+        text_end = text + strlen(text);
+    const int text_len = (int)(text_end - text);
+    if (text_len < IM_TEXTSIZE_CACHE_MIN_TEXT_LEN)
+        return font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_end, NULL);
+
+    ImGuiTextSizeCache* cache = &g.TextSizeCache;
+    if (cache->Entries.Size == 0)
+    {
+        ImGuiTextSizeCacheEntry empty_entry;
+        memset(&empty_entry, 0, sizeof(empty_entry));
+        cache->Entries.resize(IM_TEXTSIZE_CACHE_MIN_ENTRIES, empty_entry);
+    }
+
+    // Text is not stored: entries match on a 64-bit hash of the text and on every other input.
+    // ImFont::GlyphsGeneration is part of the key so loading or evicting glyphs (e.g. ImFontAtlasFlags_DynamicGlyphs) invalidates previous results.
+    const unsigned int font_glyphs_generation = font->GlyphsGeneration;
+    const float key_floats[] = { font_size, wrap_width };
+    ImU64 hash = ImHashData64(key_floats, sizeof(key_floats), (ImU64)(size_t)font ^ ((ImU64)font_glyphs_generation << 32));
+    hash = ImHashData64(text, (size_t)text_len, hash);
+    if (hash == 0)
+        hash = 1;
+
+    ImGuiTextSizeCacheEntry* set = &cache->Entries[(int)(hash & (ImU64)(cache->Entries.Size - 1)) & ~(IM_TEXTSIZE_CACHE_WAYS - 1)];
+    ImGuiTextSizeCacheEntry* entry_lru = set;
+    for (int way_n = 0; way_n < IM_TEXTSIZE_CACHE_WAYS; way_n++)
+    {
+        ImGuiTextSizeCacheEntry* entry = &set[way_n];
+        if (entry->Hash == hash && entry->TextLen == text_len && entry->Font == font && entry->FontGlyphsGeneration == font_glyphs_generation && entry->FontSize == font_size && entry->WrapWidth == wrap_width)
+        {
+            entry->LastUsedFrame = g.FrameCount;
+            cache->HitCountThisFrame++;
+            return entry->Size;
+        }
+        if (entry_lru->Hash != 0 && (entry->Hash == 0 || entry->LastUsedFrame < entry_lru->LastUsedFrame))
+            entry_lru = entry;
+    }
+
+    // Miss: measure and replace least recently used entry of the set
+    cache->MissCountThisFrame++;
+    if (entry_lru->Hash != 0 && entry_lru->LastUsedFrame >= g.FrameCount - 1)
+        cache->EvictRecentCountThisFrame++;
+    entry_lru->Hash = hash;
+    entry_lru->TextLen = text_len;
+    entry_lru->Font = font;
+    entry_lru->FontGlyphsGeneration = font_glyphs_generation;
+    entry_lru->FontSize = font_size;
+    entry_lru->WrapWidth = wrap_width;
+    entry_lru->Size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_end, NULL);
+    entry_lru->LastUsedFrame = g.FrameCount;
+    return entry_lru->Size;
+}
+
+// Rotate counters, grow table when it is too small for the working set, release it when disabled.
+void ImGui::UpdateTextSizeCache()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTextSizeCache* cache = &g.TextSizeCache;
+    if (!g.IO.ConfigTextSizeCache)
+    {
+        if (cache->Entries.Size > 0)
+            cache->Clear();
+        return;
+    }
+    cache->HitCount += (ImU64)cache->HitCountThisFrame;
+    cache->MissCount += (ImU64)cache->MissCountThisFrame;
+    cache->HitCountLastFrame = cache->HitCountThisFrame;
+    cache->MissCountLastFrame = cache->MissCountThisFrame;
+    cache->EvictRecentCountLastFrame = cache->EvictRecentCountThisFrame;
+    cache->HitCountThisFrame = cache->MissCountThisFrame = cache->EvictRecentCountThisFrame = 0;
+
+    if (cache->EvictRecentCountLastFrame <= cache->Entries.Size / 16 || cache->Entries.Size >= IM_TEXTSIZE_CACHE_MAX_ENTRIES)
+        return;
+
+    // Grow to twice the number of lookups made last frame, and reinsert entries (each new set receives entries from a single old set so none are lost)
+    const int new_size = ImClamp(ImUpperPowerOfTwo((cache->HitCountLastFrame + cache->MissCountLastFrame) * 2), cache->Entries.Size * 2, IM_TEXTSIZE_CACHE_MAX_ENTRIES);
+    ImVector<ImGuiTextSizeCacheEntry> old_entries;
+    old_entries.swap(cache->Entries);
+    ImGuiTextSizeCacheEntry empty_entry;
+    memset(&empty_entry, 0, sizeof(empty_entry));
+    cache->Entries.resize(new_size, empty_entry);
+    for (int n = 0; n < old_entries.Size; n++)
+    {
+        const ImGuiTextSizeCacheEntry* old_entry = &old_entries[n];
+        if (old_entry->Hash == 0)
+            continue;
+        ImGuiTextSizeCacheEntry* set = &cache->Entries[(int)(old_entry->Hash & (ImU64)(cache->Entries.Size - 1)) & ~(IM_TEXTSIZE_CACHE_WAYS - 1)];
+        for (int way_n = 0; way_n < IM_TEXTSIZE_CACHE_WAYS; way_n++)
+            if (set[way_n].Hash == 0)
+            {
+                set[way_n] = *old_entry;
+                break;
+            }
+    }
+}
+
+void ImGui::ClearTextSizeCache()
+{
+    ImGuiContext& g = *GImGui;
+    g.TextSizeCache.Clear();
+}
+
 // Calculate text size. Text can be multi-line. Optionally ignore text after a ## marker.
 // CalcTextSize("") should return ImVec2(0.0f, g.FontSize)
 ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_text_after_double_hash, float wrap_width)
@@ -4485,7 +5509,7 @@ ImVec2 ImGui::CalcTextSize(const char* text, const char* text_end, bool hide_tex
     const float font_size = g.FontSize;
     if (text == text_display_end)
         return ImVec2(0.0f, font_size);
-    ImVec2 text_size = font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
+    ImVec2 text_size = g.IO.ConfigTextSizeCache ? CalcTextSizeCached(font, font_size, wrap_width, text, text_display_end) : font->CalcTextSizeA(font_size, FLT_MAX, wrap_width, text, text_display_end, NULL);
 
     // Round
     // FIXME: This has been here since Dec 2015 (7b0bf230) but down the line we want this out.
@@ -5647,6 +6671,7 @@ void ImGui::UpdateWindowParentAndRootLinks(ImGuiWindow* window, ImGuiWindowFlags
 bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 {
     ImGuiContext& g = *GImGui;
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Window);
     const ImGuiStyle& style = g.Style;
     IM_ASSERT(name != NULL && name[0] != '\0');     // Window name required
     IM_ASSERT(g.WithinFrameScope);                  // Forgot to call ImGui::NewFrame()
@@ -5786,6 +6811,15 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
         window->HasCloseButton = (p_open != NULL);
         window->ClipRect = ImVec4(-FLT_MAX, -FLT_MAX, +FLT_MAX, +FLT_MAX);
         window->IDStack.resize(1);
+        if (flags & ImGuiWindowFlags_RetainGeometry)
+        {
+            window->DrawList->_Retained = &window->DrawListRetained;
+        }
+        else if (window->DrawList->_Retained != NULL)
+        {
+            window->DrawList->_Retained = NULL;
+            window->DrawListRetained.ClearFreeMemory();
+        }
         window->DrawList->_ResetForNewFrame();
         window->DC.CurrentTableIdx = -1;
 
@@ -6074,6 +7108,8 @@ bool ImGui::Begin(const char* name, bool* p_open, ImGuiWindowFlags flags)
 
         // Setup draw list and outer clipping rectangle
         IM_ASSERT(window->DrawList->CmdBuffer.Size == 1 && window->DrawList->CmdBuffer[0].ElemCount == 0);
+        if (window->DrawList->_Retained != NULL)
+            ImDrawListRetainedBegin(window->DrawList, window->Pos);
         window->DrawList->PushTextureID(g.Font->ContainerAtlas->TexID);
         PushClipRect(host_rect.Min, host_rect.Max, false);
 
@@ -6306,6 +7342,8 @@ void ImGui::End()
     if (window->DC.CurrentColumns)
         EndColumns();
     PopClipRect();   // Inner window clip rectangle
+    if (window->DrawList->_Retained != NULL)
+        ImDrawListRetainedEnd(window->DrawList);
 
     // Stop logging
     if (!(window->Flags & ImGuiWindowFlags_ChildWindow))    // FIXME: add more options for scope of logging
@@ -10228,6 +11266,7 @@ void ImGui::MarkIniSettingsDirty(ImGuiWindow* window)
 ImGuiWindowSettings* ImGui::CreateNewWindowSettings(const char* name)
 {
     ImGuiContext& g = *GImGui;
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Settings);
 
 #if !IMGUI_DEBUG_INI_SETTINGS
     // Skip to the "###" marker if any. We don't skip past to match the behavior of GetID()
@@ -10297,6 +11336,7 @@ void ImGui::LoadIniSettingsFromMemory(const char* ini_data, size_t ini_size)
 {
     ImGuiContext& g = *GImGui;
     IM_ASSERT(g.Initialized);
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Settings);
     //IM_ASSERT(!g.WithinFrameScope && "Cannot be called between NewFrame() and EndFrame()");
     //IM_ASSERT(g.SettingsLoaded == false && g.FrameCount == 0);
 
@@ -10383,6 +11423,7 @@ void ImGui::SaveIniSettingsToDisk(const char* ini_filename)
 const char* ImGui::SaveIniSettingsToMemory(size_t* out_size)
 {
     ImGuiContext& g = *GImGui;
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Settings);
     g.SettingsDirtyTimer = 0.0f;
     g.SettingsIniData.Buf.resize(0);
     g.SettingsIniData.Buf.push_back(0);
@@ -10781,6 +11822,14 @@ void ImGui::ShowMetricsWindow(bool* p_open)
     Text("Dear ImGui %s", GetVersion());
     Text("Application average %.3f ms/frame (%.1f FPS)", 1000.0f / io.Framerate, io.Framerate);
     Text("%d vertices, %d indices (%d triangles)", io.MetricsRenderVertices, io.MetricsRenderIndices, io.MetricsRenderIndices / 3);
+    {
+        // Counted by Render() at the end of this frame, so the values displayed are those of the previous frame
+        g.DebugMetricsDrawCallsFrame = g.FrameCount;
+        Text("%d draw calls, %d if merged across draw lists", g.DebugMetricsDrawCalls, g.DebugMetricsDrawCallsMerged);
+        SameLine(); MetricsHelpMarker("Number of draw commands of the last frame, and after merging them with ImDrawData::MergeBuffers() using ImDrawDataMergeFlags_MergeCmds | ImDrawDataMergeFlags_MergeContainedClip.");
+        if (io.BackendFlags & ImGuiBackendFlags_RendererHasContentHash)
+            Text("%d/%d draw lists unchanged since last rendered", g.DebugMetricsDrawListsUnchanged, g.DebugMetricsDrawListsCount);
+    }
     Text("%d active windows (%d visible)", io.MetricsActiveWindows, io.MetricsRenderWindows);
     Text("%d active allocations", io.MetricsActiveAllocations);
     //SameLine(); if (SmallButton("GC")) { g.GcCompactAll = true; }
@@ -11027,6 +12076,100 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         TreePop();
     }
 
+    // Details for Memory
+    if (TreeNode("Memory", "Memory: %d active allocations", g.IO.MetricsActiveAllocations))
+    {
+        if (BeginTable("##MemStats", 5, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_SizingFixedFit))
+        {
+            TableSetupColumn("Category");
+            TableSetupColumn("Allocs (last frame)");
+            TableSetupColumn("Bytes (last frame)");
+            TableSetupColumn("Allocs (total)");
+            TableSetupColumn("Bytes (total)");
+            TableHeadersRow();
+            for (int category_n = 0; category_n < ImGuiMemCategory_COUNT; category_n++)
+            {
+                const ImGuiMemCategoryStats* stats = &g.MemStats[category_n];
+                TableNextColumn(); TextUnformatted(GMemCategoryNames[category_n]);
+                TableNextColumn(); Text("%d", stats->AllocCountLastFrame);
+                TableNextColumn(); Text("%d", (int)stats->AllocBytesLastFrame);
+                TableNextColumn(); Text("%d", stats->AllocCount);
+                TableNextColumn(); Text("%d", (int)stats->AllocBytes);
+            }
+            EndTable();
+        }
+        const ImFrameArena* arena = &g.FrameArena;
+        BulletText("Frame arena: %d/%d bytes used, peak %d bytes, %d block(s)", (int)arena->UsedSize, (int)arena->CapacitySize, (int)arena->PeakUsedSize, arena->BlocksCount);
+
+        // Zero-allocation check
+        static bool break_on_alloc = false;
+        if (g.DebugZeroAllocCheckActive)
+        {
+            if (SmallButton("Stop"))
+                DebugStopZeroAllocCheck();
+            SameLine();
+            if (g.FrameCount < g.DebugZeroAllocCheckStartFrame)
+                Text("Zero-allocation check: warming up...");
+            else
+                Text("Zero-allocation check: %d allocation(s) since frame %d", g.DebugZeroAllocCheckCount, g.DebugZeroAllocCheckStartFrame);
+        }
+        else
+        {
+            if (SmallButton("Start"))
+                DebugStartZeroAllocCheck(2, break_on_alloc, true);
+            SameLine();
+            Text("Zero-allocation check");
+            SameLine();
+            Checkbox("Break on allocation", &break_on_alloc);
+        }
+        const int reports_count = ImMin(g.DebugZeroAllocCheckCount, IM_ARRAYSIZE(g.DebugZeroAllocCheckReports));
+        for (int n = 0; n < reports_count; n++)
+        {
+            const ImGuiDebugAllocReport* report = &g.DebugZeroAllocCheckReports[(g.DebugZeroAllocCheckCount - 1 - n) % IM_ARRAYSIZE(g.DebugZeroAllocCheckReports)];
+            ImGuiWindow* report_window = report->WindowID ? FindWindowByID(report->WindowID) : NULL;
+            BulletText("Frame %d: %d bytes, category %s, window '%s'", report->Frame, (int)report->Size, GMemCategoryNames[report->Category], report_window ? report_window->Name : "NULL");
+        }
+
+        // Largest buffers, by owner
+        if (TreeNode("Buffers"))
+        {
+            DebugNodeMemoryBuffers();
+            TreePop();
+        }
+        TreePop();
+    }
+
+    // Details for Text size cache
+    ImGuiTextSizeCache* text_size_cache = &g.TextSizeCache;
+    const int text_size_lookups_last_frame = text_size_cache->HitCountLastFrame + text_size_cache->MissCountLastFrame;
+    if (TreeNode("TextSizeCache", "Text size cache: %s, %.1f%% hit rate", g.IO.ConfigTextSizeCache ? "enabled" : "disabled", text_size_lookups_last_frame ? 100.0f * text_size_cache->HitCountLastFrame / text_size_lookups_last_frame : 0.0f))
+    {
+        Checkbox("io.ConfigTextSizeCache", &g.IO.ConfigTextSizeCache);
+        SameLine();
+        if (SmallButton("Clear"))
+            ClearTextSizeCache();
+        int entries_used = 0;
+        for (int n = 0; n < text_size_cache->Entries.Size; n++)
+            if (text_size_cache->Entries[n].Hash != 0)
+                entries_used++;
+        const ImU64 lookups_total = text_size_cache->HitCount + text_size_cache->MissCount;
+        BulletText("Entries: %d/%d used, %d bytes", entries_used, text_size_cache->Entries.Size, (int)text_size_cache->Entries.size_in_bytes());
+        BulletText("Last frame: %d hits, %d misses, %d recent entries evicted", text_size_cache->HitCountLastFrame, text_size_cache->MissCountLastFrame, text_size_cache->EvictRecentCountLastFrame);
+        BulletText("Total: %.1f%% hit rate over %d lookups", lookups_total ? (double)text_size_cache->HitCount * 100.0 / (double)lookups_total : 0.0, (int)lookups_total);
+        TreePop();
+    }
+
+    // Details for InputText() undo history
+    ImGuiInputTextUndoStack* undo_stack = &g.InputTextState.Undo;
+    if (TreeNode("InputTextUndo", "InputText undo history: %d records, %d/%d bytes", undo_stack->Records.Size - undo_stack->FirstRecord, undo_stack->GetMemoryUsage(), g.IO.ConfigInputTextUndoMemoryMax))
+    {
+        BulletText("Widget: 0x%08X", g.InputTextState.ID);
+        BulletText("Records: %d can be undone, %d can be redone", g.InputTextState.GetUndoAvailCount(), g.InputTextState.GetRedoAvailCount());
+        BulletText("Discarded: %d records, %d bytes of text (not removed yet)", undo_stack->FirstRecord, undo_stack->GetTextOffset());
+        BulletText("Memory: %d bytes of text, %d bytes of records (%d bytes allocated)", undo_stack->Text.Size, undo_stack->Records.Size * (int)sizeof(ImGuiInputTextUndoRecord), (int)(undo_stack->Text.capacity() + undo_stack->Records.capacity() * sizeof(ImGuiInputTextUndoRecord)));
+        TreePop();
+    }
+
     // Misc Details
     if (TreeNode("Internal state"))
     {
@@ -11060,6 +12203,14 @@ void ImGui::ShowMetricsWindow(bool* p_open)
         Text("NavWindowingTarget: '%s'", g.NavWindowingTarget ? g.NavWindowingTarget->Name : "NULL");
         Unindent();
 
+        Text("IDLE");
+        Indent();
+        if (g.IO.WaitBeforeNextFrame == FLT_MAX)
+            Text("WaitBeforeNextFrame: FLT_MAX, StableFrames: %d", g.WaitStableFrames);
+        else
+            Text("WaitBeforeNextFrame: %.3f sec, StableFrames: %d", g.IO.WaitBeforeNextFrame, g.WaitStableFrames);
+        Unindent();
+
         TreePop();
     }
 
@@ -11261,10 +12412,139 @@ void ImGui::DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList* out_draw_list, co
     out_draw_list->Flags = backup_flags;
 }
 
+// Helper for DebugNodeMemoryBuffers()
+struct ImGuiMetricsBufferInfo
+{
+    const char* Owner;
+    const char* Name;
+    int         Size;       // In bytes
+    int         Capacity;   // In bytes
+};
+
+template<typename T>
+static void MetricsAddBufferInfo(ImVector<ImGuiMetricsBufferInfo>* out, const char* owner, const char* name, const ImVector<T>& buf)
+{
+    if (buf.Capacity == 0)
+        return;
+    ImGuiMetricsBufferInfo info = { owner, name, buf.size_in_bytes(), buf.Capacity * (int)sizeof(T) };
+    out->push_back(info);
+}
+
+static int IMGUI_CDECL MetricsBufferInfoComparerByCapacity(const void* lhs, const void* rhs)
+{
+    return ((const ImGuiMetricsBufferInfo*)rhs)->Capacity - ((const ImGuiMetricsBufferInfo*)lhs)->Capacity;
+}
+
+// List heap buffers owned by the context, windows, tables and viewports, largest first.
+// The list is built in the frame arena so that inspecting memory doesn't allocate.
+void ImGui::DebugNodeMemoryBuffers()
+{
+    ImGuiContext& g = *GImGui;
+    ImVector<ImGuiMetricsBufferInfo> infos;
+    PushFrameArenaAllocator();
+    // Upper bound matching the MetricsAddBufferInfo() calls below: 25 for the context, 2 + 3 per draw list for each viewport, 12 per window, 3 per table.
+    const int viewport_entries = 2 + 3 * IM_ARRAYSIZE(g.Viewports[0]->DrawLists);
+    infos.reserve(25 + g.Viewports.Size * viewport_entries + g.Windows.Size * 12 + g.Tables.GetSize() * 3);
+    MetricsAddBufferInfo(&infos, "Context", "Windows", g.Windows);
+    MetricsAddBufferInfo(&infos, "Context", "WindowsFocusOrder", g.WindowsFocusOrder);
+    MetricsAddBufferInfo(&infos, "Context", "WindowsTempSortBuffer", g.WindowsTempSortBuffer);
+    MetricsAddBufferInfo(&infos, "Context", "WindowsById", g.WindowsById.Data);
+    MetricsAddBufferInfo(&infos, "Context", "WindowsById.HashIndex", g.WindowsById.HashIndex);
+    MetricsAddBufferInfo(&infos, "Context", "OpenPopupStack", g.OpenPopupStack);
+    MetricsAddBufferInfo(&infos, "Context", "Tables", g.Tables.Buf);
+    MetricsAddBufferInfo(&infos, "Context", "TablesLastTimeActive", g.TablesLastTimeActive);
+    MetricsAddBufferInfo(&infos, "Context", "DrawChannelsTempMergeBuffer", g.DrawChannelsTempMergeBuffer);
+    MetricsAddBufferInfo(&infos, "Context", "TablesTempBitArrays", g.TablesTempBitArrays);
+    MetricsAddBufferInfo(&infos, "Context", "TabBars", g.TabBars.Buf);
+    MetricsAddBufferInfo(&infos, "Context", "ShrinkWidthBuffer", g.ShrinkWidthBuffer);
+    MetricsAddBufferInfo(&infos, "Context", "InputTextState.TextW", g.InputTextState.TextW);
+    MetricsAddBufferInfo(&infos, "Context", "InputTextState.TextA", g.InputTextState.TextA);
+    MetricsAddBufferInfo(&infos, "Context", "InputTextState.InitialTextA", g.InputTextState.InitialTextA);
+    MetricsAddBufferInfo(&infos, "Context", "InputTextState.LineStartsW", g.InputTextState.LineStartsW);
+    MetricsAddBufferInfo(&infos, "Context", "InputTextState.LineStartsA", g.InputTextState.LineStartsA);
+    MetricsAddBufferInfo(&infos, "Context", "InputTextState.Undo.Records", g.InputTextState.Undo.Records);
+    MetricsAddBufferInfo(&infos, "Context", "InputTextState.Undo.Text", g.InputTextState.Undo.Text);
+    MetricsAddBufferInfo(&infos, "Context", "ClipboardHandlerData", g.ClipboardHandlerData);
+    MetricsAddBufferInfo(&infos, "Context", "MenusIdSubmittedThisFrame", g.MenusIdSubmittedThisFrame);
+    MetricsAddBufferInfo(&infos, "Context", "SettingsIniData", g.SettingsIniData.Buf);
+    MetricsAddBufferInfo(&infos, "Context", "SettingsWindows", g.SettingsWindows.Buf);
+    MetricsAddBufferInfo(&infos, "Context", "SettingsTables", g.SettingsTables.Buf);
+    MetricsAddBufferInfo(&infos, "Context", "LogBuffer", g.LogBuffer.Buf);
+    for (int viewport_n = 0; viewport_n < g.Viewports.Size; viewport_n++)
+    {
+        ImGuiViewportP* viewport = g.Viewports[viewport_n];
+        MetricsAddBufferInfo(&infos, "Viewport", "DrawDataBuilder.Layers[0]", viewport->DrawDataBuilder.Layers[0]);
+        MetricsAddBufferInfo(&infos, "Viewport", "DrawDataBuilder.Layers[1]", viewport->DrawDataBuilder.Layers[1]);
+        for (int layer_n = 0; layer_n < IM_ARRAYSIZE(viewport->DrawLists); layer_n++)
+            if (ImDrawList* draw_list = viewport->DrawLists[layer_n])
+            {
+                const char* owner = (layer_n == 0) ? "Viewport Background" : "Viewport Foreground";
+                MetricsAddBufferInfo(&infos, owner, "DrawList->VtxBuffer", draw_list->VtxBuffer);
+                MetricsAddBufferInfo(&infos, owner, "DrawList->IdxBuffer", draw_list->IdxBuffer);
+                MetricsAddBufferInfo(&infos, owner, "DrawList->CmdBuffer", draw_list->CmdBuffer);
+            }
+    }
+    for (int window_n = 0; window_n < g.Windows.Size; window_n++)
+    {
+        ImGuiWindow* window = g.Windows[window_n];
+        MetricsAddBufferInfo(&infos, window->Name, "DrawList->VtxBuffer", window->DrawList->VtxBuffer);
+        MetricsAddBufferInfo(&infos, window->Name, "DrawList->IdxBuffer", window->DrawList->IdxBuffer);
+        MetricsAddBufferInfo(&infos, window->Name, "DrawList->CmdBuffer", window->DrawList->CmdBuffer);
+        MetricsAddBufferInfo(&infos, window->Name, "DrawList->_Path", window->DrawList->_Path);
+        MetricsAddBufferInfo(&infos, window->Name, "DrawList->_Splitter", window->DrawList->_Splitter._Channels);
+        MetricsAddBufferInfo(&infos, window->Name, "IDStack", window->IDStack);
+        MetricsAddBufferInfo(&infos, window->Name, "StateStorage", window->StateStorage.Data);
+        MetricsAddBufferInfo(&infos, window->Name, "StateStorage.HashIndex", window->StateStorage.HashIndex);
+        MetricsAddBufferInfo(&infos, window->Name, "ColumnsStorage", window->ColumnsStorage);
+        MetricsAddBufferInfo(&infos, window->Name, "DC.ChildWindows", window->DC.ChildWindows);
+        MetricsAddBufferInfo(&infos, window->Name, "DC.ItemWidthStack", window->DC.ItemWidthStack);
+        MetricsAddBufferInfo(&infos, window->Name, "DC.TextWrapPosStack", window->DC.TextWrapPosStack);
+    }
+    for (int table_n = 0; table_n < g.Tables.GetSize(); table_n++)
+    {
+        ImGuiTable* table = g.Tables.GetByIndex(table_n);
+        const char* owner = table->OuterWindow ? table->OuterWindow->Name : "Table";
+        MetricsAddBufferInfo(&infos, owner, "Table->ColumnsNames", table->ColumnsNames.Buf);
+        MetricsAddBufferInfo(&infos, owner, "Table->SortSpecsMulti", table->SortSpecsMulti);
+        MetricsAddBufferInfo(&infos, owner, "Table->DrawSplitter", table->DrawSplitter._Channels);
+    }
+    PopFrameArenaAllocator();
+    ImQsort(infos.Data, (size_t)infos.Size, sizeof(ImGuiMetricsBufferInfo), MetricsBufferInfoComparerByCapacity);
+
+    int total_size = 0, total_capacity = 0;
+    for (int n = 0; n < infos.Size; n++)
+    {
+        total_size += infos[n].Size;
+        total_capacity += infos[n].Capacity;
+    }
+    Text("%d buffers: %d bytes used, %d bytes reserved", infos.Size, total_size, total_capacity);
+    if (BeginTable("##Buffers", 4, ImGuiTableFlags_Borders | ImGuiTableFlags_RowBg | ImGuiTableFlags_ScrollY | ImGuiTableFlags_SizingFixedFit, ImVec2(0.0f, GetTextLineHeightWithSpacing() * 16)))
+    {
+        TableSetupScrollFreeze(0, 1);
+        TableSetupColumn("Owner");
+        TableSetupColumn("Buffer");
+        TableSetupColumn("Used");
+        TableSetupColumn("Reserved");
+        TableHeadersRow();
+        ImGuiListClipper clipper;
+        clipper.Begin(infos.Size);
+        while (clipper.Step())
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+            {
+                const ImGuiMetricsBufferInfo* info = &infos[n];
+                TableNextColumn(); TextUnformatted(info->Owner);
+                TableNextColumn(); TextUnformatted(info->Name);
+                TableNextColumn(); Text("%d", info->Size);
+                TableNextColumn(); Text("%d", info->Capacity);
+            }
+        EndTable();
+    }
+}
+
 // [DEBUG] Display contents of ImGuiStorage
 void ImGui::DebugNodeStorage(ImGuiStorage* storage, const char* label)
 {
-    if (!TreeNode(label, "%s: %d entries, %d bytes", label, storage->Data.Size, storage->Data.size_in_bytes()))
+    if (!TreeNode(label, "%s: %d entries, %d bytes%s", label, storage->Data.Size, storage->Data.size_in_bytes() + storage->HashIndex.size_in_bytes(), storage->UseHashIndex ? " (hash index)" : ""))
         return;
     for (int n = 0; n < storage->Data.Size; n++)
     {
@@ -11354,6 +12634,12 @@ void ImGui::DebugNodeWindow(ImGuiWindow* window, const char* label)
 
     ImGuiWindowFlags flags = window->Flags;
     DebugNodeDrawList(window, window->DrawList, "DrawList");
+    if (window->DrawList->_Retained != NULL)
+    {
+        const ImDrawListRetained* retained = window->DrawList->_Retained;
+        BulletText("RetainGeometry: reused %d/%d frames (%.1f%%), last frame reused %d/%d primitives", retained->FramesReused, retained->FramesCount,
+            retained->FramesCount > 0 ? retained->FramesReused * 100.0f / retained->FramesCount : 0.0f, retained->LastPrimsReused, retained->LastPrimsCount);
+    }
     BulletText("Pos: (%.1f,%.1f), Size: (%.1f,%.1f), ContentSize (%.1f,%.1f) Ideal (%.1f,%.1f)", window->Pos.x, window->Pos.y, window->Size.x, window->Size.y, window->ContentSize.x, window->ContentSize.y, window->ContentSizeIdeal.x, window->ContentSizeIdeal.y);
     BulletText("Flags: 0x%08X (%s%s%s%s%s%s%s%s%s..)", flags,
         (flags & ImGuiWindowFlags_ChildWindow)  ? "Child " : "",      (flags & ImGuiWindowFlags_Tooltip)     ? "Tooltip "   : "",  (flags & ImGuiWindowFlags_Popup) ? "Popup " : "",
@@ -11407,6 +12693,7 @@ void ImGui::ShowMetricsWindow(bool*) {}
 void ImGui::DebugNodeColumns(ImGuiOldColumns*) {}
 void ImGui::DebugNodeDrawList(ImGuiWindow*, const ImDrawList*, const char*) {}
 void ImGui::DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList*, const ImDrawList*, const ImDrawCmd*, bool, bool) {}
+void ImGui::DebugNodeMemoryBuffers() {}
 void ImGui::DebugNodeStorage(ImGuiStorage*, const char*) {}
 void ImGui::DebugNodeTabBar(ImGuiTabBar*, const char*) {}
 void ImGui::DebugNodeWindow(ImGuiWindow*, const char*) {}
@@ -122,11 +122,13 @@ struct ImDrawChannel;               // Temporary storage to output draw commands
 struct ImDrawCmd;                   // A single draw command within a parent ImDrawList (generally maps to 1 GPU draw call, unless it is a callback)
 struct ImDrawData;                  // All draw command lists required to render the frame + pos/size coordinates to use for the projection matrix.
 struct ImDrawList;                  // A single draw command list (generally one per window, conceptually you may see this as a dynamic "mesh" builder)
+struct ImDrawListRetained;          // Retained geometry of a draw list (see ImGuiWindowFlags_RetainGeometry)
 struct ImDrawListSharedData;        // Data shared among multiple draw lists (typically owned by parent ImGui context, but you may create one yourself)
 struct ImDrawListSplitter;          // Helper to split a draw list into different layers which can be drawn into out of order, then flattened back.
 struct ImDrawVert;                  // A single vertex (pos + uv + col = 20 bytes by default. Override layout with IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
 struct ImFont;                      // Runtime data for a single font within a parent ImFontAtlas
 struct ImFontAtlas;                 // Runtime data for multiple fonts, bake multiple fonts into a single texture, TTF/OTF font loader
+struct ImFontAtlasGlyphCache;       // Opaque storage for glyphs rasterized on demand (see ImFontAtlasFlags_DynamicGlyphs)
 struct ImFontBuilderIO;             // Opaque interface to a font builder (stb_truetype or FreeType).
 struct ImFontConfig;                // Configuration data when adding a font or merging fonts
 struct ImFontGlyph;                 // A single font glyph (code point + coordinates within in ImFontAtlas + offset)
@@ -136,6 +138,7 @@ struct ImGuiContext;                // Dear ImGui context (opaque structure, unl
 struct ImGuiIO;                     // Main configuration and I/O between your application and ImGui
 struct ImGuiInputTextCallbackData;  // Shared state of InputText() when using custom ImGuiInputTextCallback (rare/advanced use)
 struct ImGuiListClipper;            // Helper to manually clip large list of items
+struct ImGuiListItemHeights;        // Helper to store the height of each item of a large list, for ImGuiListClipper with variable heights
 struct ImGuiOnceUponAFrame;         // Helper for running a block of code not more than once a frame, used by IMGUI_ONCE_UPON_A_FRAME macro
 struct ImGuiPayload;                // User data payload for drag and drop operations
 struct ImGuiSizeCallbackData;       // Callback data when using SetNextWindowSizeConstraints() (rare/advanced use)
@@ -145,6 +148,7 @@ struct ImGuiTableSortSpecs;         // Sorting specifications for a table (often
 struct ImGuiTableColumnSortSpecs;   // Sorting specification for one column of a table
 struct ImGuiTextBuffer;             // Helper to hold and append into a text buffer (~string builder)
 struct ImGuiTextFilter;             // Helper to parse and apply text filters (e.g. "aaaaa[,bbbbb][,ccccc]")
+struct ImGuiTextFilterIndex;        // Helper to cache the results of a text filter over a large list of items, for ImGuiListClipper
 struct ImGuiViewport;               // A Platform Window (always only one in 'master' branch), in the future may represent Platform Monitor
 
 // Enums/Flags (declared as int for compatibility with old C++, to allow using as flags and to not pollute the top of this file)
@@ -163,6 +167,7 @@ typedef int ImGuiSortDirection;     // -> enum ImGuiSortDirection_   // Enum: A
 typedef int ImGuiStyleVar;          // -> enum ImGuiStyleVar_        // Enum: A variable identifier for styling
 typedef int ImGuiTableBgTarget;     // -> enum ImGuiTableBgTarget_   // Enum: A color target for TableSetBgColor()
 typedef int ImDrawCornerFlags;      // -> enum ImDrawCornerFlags_    // Flags: for ImDrawList::AddRect(), AddRectFilled() etc.
+typedef int ImDrawDataMergeFlags;   // -> enum ImDrawDataMergeFlags_ // Flags: for ImDrawData::MergeBuffers()
 typedef int ImDrawListFlags;        // -> enum ImDrawListFlags_      // Flags: for ImDrawList
 typedef int ImFontAtlasFlags;       // -> enum ImFontAtlasFlags_     // Flags: for ImFontAtlas build
 typedef int ImGuiBackendFlags;      // -> enum ImGuiBackendFlags_    // Flags: for io.BackendFlags
@@ -196,6 +201,8 @@ typedef int (*ImGuiInputTextCallback)(ImGuiInputTextCallbackData* data);    // C
 typedef void (*ImGuiSizeCallback)(ImGuiSizeCallbackData* data);             // Callback function for ImGui::SetNextWindowSizeConstraints()
 typedef void* (ImGuiMemAllocFunc)(size_t sz, void* user_data);              // Function signature for ImGui::SetAllocatorFunctions()
 typedef void (ImGuiMemFreeFunc)(void* ptr, void* user_data);                // Function signature for ImGui::SetAllocatorFunctions()
+typedef void (*ImFontAtlasJobFunc)(void* job_data, int job_index);          // Job run by ImFontAtlas::BuildParallelForFunc
+typedef void (*ImFontAtlasParallelForFunc)(ImFontAtlasJobFunc job_func, void* job_data, int jobs_count, void* user_data); // Dispatcher for ImFontAtlas::BuildParallelForFunc
 
 // Character types
 // (we generally use UTF-8 encoded string in the API. This is storage specifically for a decoded character used for keyboard input and display)
@@ -691,12 +698,15 @@ namespace ImGui
     //                          TableNextColumn()      -> Text("Hello 0") -> TableNextColumn()      -> Text("Hello 1")  // OK: TableNextColumn() automatically gets to next row!
     //        TableNextRow()                           -> Text("Hello 0")                                               // Not OK! Missing TableSetColumnIndex() or TableNextColumn()! Text will not appear!
     //        --------------------------------------------------------------------------------------------------------
+    //    - With ScrollX and many columns, use TableNextRow() + 'while (TableNextVisibleColumn()) { int n = TableGetColumnIndex(); ... }'
+    //      to only visit columns in sight: this is the horizontal equivalent of ImGuiListClipper, and can be combined with it.
     // - 5. Call EndTable()
     IMGUI_API bool          BeginTable(const char* str_id, int column, ImGuiTableFlags flags = 0, const ImVec2& outer_size = ImVec2(0.0f, 0.0f), float inner_width = 0.0f);
     IMGUI_API void          EndTable();                                 // only call EndTable() if BeginTable() returns true!
     IMGUI_API void          TableNextRow(ImGuiTableRowFlags row_flags = 0, float min_row_height = 0.0f); // append into the first cell of a new row.
     IMGUI_API bool          TableNextColumn();                          // append into the next column (or first column of next row if currently in last column). Return true when column is visible.
     IMGUI_API bool          TableSetColumnIndex(int column_n);          // append into the specified column. Return true when column is visible.
+    IMGUI_API bool          TableNextVisibleColumn();                   // append into the next column of current row which is visible (or measuring its width), skipping clipped/hidden columns. Return false when none are left in the row.
     // Tables: Headers & Columns declaration
     // - Use TableSetupColumn() to specify label, resizing policy, default width/weight, id, various other flags etc.
     // - Use TableHeadersRow() to create a header row and automatically submit a TableHeader() for each column.
@@ -806,6 +816,7 @@ namespace ImGui
     IMGUI_API bool          IsRectVisible(const ImVec2& rect_min, const ImVec2& rect_max);      // test if rectangle (in screen space) is visible / not clipped. to perform coarse clipping on user's side.
     IMGUI_API double        GetTime();                                                          // get global imgui time. incremented by io.DeltaTime every frame.
     IMGUI_API int           GetFrameCount();                                                    // get global imgui frame count. incremented by 1 every frame.
+    IMGUI_API void          SetMaxWaitBeforeNextFrame(float seconds);                           // request another frame within 'seconds' even if no inputs are received (e.g. your own animations: pass 0.0f every frame while animating). see io.WaitBeforeNextFrame.
     IMGUI_API ImDrawList*   GetBackgroundDrawList();                                            // this draw list will be the first rendering one. Useful to quickly draw shapes/text behind dear imgui contents.
     IMGUI_API ImDrawList*   GetForegroundDrawList();                                            // this draw list will be the last rendered one. Useful to quickly draw shapes/text over dear imgui contents.
     IMGUI_API ImDrawListSharedData* GetDrawListSharedData();                                    // you may use this when creating your own ImDrawList instances.
@@ -910,6 +921,7 @@ enum ImGuiWindowFlags_
     ImGuiWindowFlags_NoNavInputs            = 1 << 18,  // No gamepad/keyboard navigation within the window
     ImGuiWindowFlags_NoNavFocus             = 1 << 19,  // No focusing toward this window with gamepad/keyboard navigation (e.g. skipped by CTRL+TAB)
     ImGuiWindowFlags_UnsavedDocument        = 1 << 20,  // Append '*' to title without affecting the ID, as a convenience to avoid using the ### operator. When used in a tab/docking context, tab is selected on closure and closure is deferred by one frame to allow code to cancel the closure (with a confirmation popup, etc.) without flicker.
+    ImGuiWindowFlags_RetainGeometry         = 1 << 21,  // Reuse last frame's vertices/indices for the parts of the window drawing exactly the same primitives as last frame (e.g. static contents). Window may move. Uses twice the draw list memory. See Metrics->Windows for hit rates.
     ImGuiWindowFlags_NoNav                  = ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
     ImGuiWindowFlags_NoDecoration           = ImGuiWindowFlags_NoTitleBar | ImGuiWindowFlags_NoResize | ImGuiWindowFlags_NoScrollbar | ImGuiWindowFlags_NoCollapse,
     ImGuiWindowFlags_NoInputs               = ImGuiWindowFlags_NoMouseInputs | ImGuiWindowFlags_NoNavInputs | ImGuiWindowFlags_NoNavFocus,
@@ -1379,7 +1391,8 @@ enum ImGuiBackendFlags_
     ImGuiBackendFlags_HasGamepad            = 1 << 0,   // Backend Platform supports gamepad and currently has one connected.
     ImGuiBackendFlags_HasMouseCursors       = 1 << 1,   // Backend Platform supports honoring GetMouseCursor() value to change the OS cursor shape.
     ImGuiBackendFlags_HasSetMousePos        = 1 << 2,   // Backend Platform supports io.WantSetMousePos requests to reposition the OS mouse position (only used if ImGuiConfigFlags_NavEnableSetMousePos is set).
-    ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3    // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasVtxOffset  = 1 << 3,   // Backend Renderer supports ImDrawCmd::VtxOffset. This enables output of large meshes (64K+ vertices) while still using 16-bit indices.
+    ImGuiBackendFlags_RendererHasContentHash = 1 << 4   // Backend Renderer uses ImDrawList::ContentGeneration to skip uploading unchanged draw lists. Render() will hash the contents of each draw list.
 };
 
 // Enumeration for PushStyleColor() / PopStyleColor()
@@ -1779,6 +1792,8 @@ struct ImGuiIO
     bool        ConfigWindowsResizeFromEdges;   // = true           // Enable resizing of windows from their edges and from the lower-left corner. This requires (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors) because it needs mouse cursor feedback. (This used to be a per-window ImGuiWindowFlags_ResizeFromAnySide flag)
     bool        ConfigWindowsMoveFromTitleBarOnly; // = false       // Enable allowing to move windows only when clicking on their title bar. Does not apply to windows without a title bar.
     float       ConfigMemoryCompactTimer;       // = 60.0f          // Timer (in seconds) to free transient windows/tables memory buffers when unused. Set to -1.0f to disable.
+    bool        ConfigTextSizeCache;            // = false          // [BETA] Cache results of CalcTextSize() by font, size, wrap width and text. Avoids measuring the same labels every frame in large UI. Check hit rate in Metrics->Text size cache.
+    int         ConfigInputTextUndoMemoryMax;   // = 16 MB          // Maximum memory used by the undo history of the active InputText() (in bytes). Oldest edits are discarded beyond it. Check usage in Metrics->InputText undo history.
 
     //------------------------------------------------------------------
     // Platform Functions
@@ -1837,6 +1852,7 @@ struct ImGuiIO
     bool        WantSaveIniSettings;            // When manual .ini load/save is active (io.IniFilename == NULL), this will be set to notify your application that you can call SaveIniSettingsToMemory() and save yourself. Important: clear io.WantSaveIniSettings yourself after saving!
     bool        NavActive;                      // Keyboard/Gamepad navigation is currently allowed (will handle ImGuiKey_NavXXX events) = a window is focused and it doesn't use the ImGuiWindowFlags_NoNavInputs flag.
     bool        NavVisible;                     // Keyboard/Gamepad navigation is visible and allowed (will handle ImGuiKey_NavXXX events).
+    float       WaitBeforeNextFrame;            // Set by EndFrame(): time in seconds the application may wait for new inputs before running another frame. 0.0f while something is animating or the UI hasn't settled after an input, FLT_MAX when idle. Use to sleep precisely (e.g. glfwWaitEventsTimeout()) instead of polling. See SetMaxWaitBeforeNextFrame().
     float       Framerate;                      // Application framerate estimate, in frame per second. Solely for convenience. Rolling average estimation based on io.DeltaTime over 120 frames.
     int         MetricsRenderVertices;          // Vertices output during last call to Render()
     int         MetricsRenderIndices;           // Indices output during last call to Render() = number of triangles * 3
@@ -2061,6 +2077,38 @@ struct ImGuiTextFilter
     char                    InputBuf[256];
     ImVector<ImGuiTextRange>Filters;
     int                     CountGrep;
+    int                     Generation;     // Incremented by every call to Build(), so cached results (e.g. ImGuiTextFilterIndex) can tell when the filter changed
+};
+
+// Helper: Cache the results of an ImGuiTextFilter over a large list of items (e.g. the lines of a log) and give random access to the items passing the filter, so they can be displayed with ImGuiListClipper.
+// - Each item is tested once: Update() only tests the items added at the end of the list since the previous call, until the filter changes (another filter, or its Generation) which restarts from the first item.
+//   If the list shrinks, everything is tested again. Call InvalidateFrom() if you modify items (e.g. appending text to the last line of a log),
+//   or Clear() if you remove items otherwise (e.g. removing lines at the front of the log).
+// - When the filter is not active, no memory is used: every item passes.
+// Usage:
+//   static ImGuiTextFilter filter;
+//   static ImGuiTextFilterIndex filter_index;
+//   filter.Draw();
+//   filter_index.Update(filter, lines_count, LinesGetter, &my_data);      // void LinesGetter(void* data, int idx, const char** out_text, const char** out_text_end)
+//   ImGuiListClipper clipper;
+//   clipper.Begin(filter_index.Size());
+//   while (clipper.Step())
+//       for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
+//           ImGui::TextUnformatted(lines[filter_index.GetItemIndex(n)]);
+struct ImGuiTextFilterIndex
+{
+    ImVector<int>       Items;              // Indices of the items passing the filter, in increasing order (unused when PassAll is set)
+    int                 ItemsCount;         // Number of items of the list which have been tested
+    const ImGuiTextFilter* Filter;          // Filter the results were computed with
+    int                 FilterGeneration;   // ImGuiTextFilter::Generation the results were computed with
+    bool                PassAll;            // Filter isn't active: every item passes
+
+    ImGuiTextFilterIndex()                  { Clear(); }
+    void                Clear()             { Items.clear(); ItemsCount = 0; Filter = NULL; FilterGeneration = -1; PassAll = false; }
+    int                 Size() const        { return PassAll ? ItemsCount : Items.Size; }     // Number of items passing the filter
+    int                 GetItemIndex(int n) const { return PassAll ? n : Items[n]; }        // Index in the list of the n-th item passing the filter
+    IMGUI_API void      InvalidateFrom(int idx);                                            // Forget results of items >= idx, they will be tested again by the next Update()
+    IMGUI_API void      Update(const ImGuiTextFilter& filter, int items_count, void (*items_getter)(void* data, int idx, const char** out_text, const char** out_text_end), void* data); // items_getter may leave *out_text_end to NULL for zero-terminated text
 };
 
 // Helper: Growable text buffer for logging/accumulating text
@@ -2088,6 +2136,7 @@ struct ImGuiTextBuffer
 // Typically you don't have to worry about this since a storage is held within each Window.
 // We use it to e.g. store collapse state for a tree (Int 0/1)
 // This is optimized for efficient lookup (dichotomy into a contiguous buffer) and rare insertion (typically tied to user interactions aka max once a frame)
+// With SetUseHashIndex(true), lookups and insertions use a hash table instead and pairs are not sorted (better for storages holding many keys).
 // You can use it as custom user storage for temporary values. Declare your own storage if, for example:
 // - You want to manipulate the open/close state of a particular sub-tree in your interface (tree node uses Int 0/1 to store their state).
 // - You want to store custom debug data easily without adding or editing structures in your code (probably not efficient, but convenient)
@@ -2105,11 +2154,16 @@ struct ImGuiStorage
     };
 
     ImVector<ImGuiStoragePair>      Data;
+    ImVector<int>                   HashIndex;      // Open addressing table of indices into Data[], only used when UseHashIndex is set (-1 = empty slot)
+    int                             HashIndexDataSize; // Data.Size when HashIndex was last updated: the index is rebuilt if pairs were added/removed directly in Data[]
+    bool                            UseHashIndex;   // See SetUseHashIndex()
+
+    ImGuiStorage()      { HashIndexDataSize = 0; UseHashIndex = false; }
 
-    // - Get***() functions find pair, never add/allocate. Pairs are sorted so a query is O(log N)
+    // - Get***() functions find pair, never add/allocate (except to rebuild a stale hash index). Pairs are sorted so a query is O(log N), or O(1) with the hash index.
     // - Set***() functions find pair, insertion on demand if missing.
-    // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair.
-    void                Clear() { Data.clear(); }
+    // - Sorted insertion is costly, paid once. A typical frame shouldn't need to insert any new pair. Insertion with the hash index is O(1).
+    void                Clear() { Data.clear(); HashIndex.clear(); HashIndexDataSize = 0; }
     IMGUI_API int       GetInt(ImGuiID key, int default_val = 0) const;
     IMGUI_API void      SetInt(ImGuiID key, int val);
     IMGUI_API bool      GetBool(ImGuiID key, bool default_val = false) const;
@@ -2132,7 +2186,15 @@ struct ImGuiStorage
     IMGUI_API void      SetAllInt(int val);
 
     // For quicker full rebuild of a storage (instead of an incremental one), you may add all your contents and then sort once.
+    // (when using a hash index, this also rebuilds the index so you may push to Data[] directly and call this once)
     IMGUI_API void      BuildSortByKey();
+
+    // Optional: index pairs with an open addressing hash table: queries and insertions become O(1) instead of O(log N) + O(N) insertion.
+    // - Recommended for storages holding many thousands of keys, e.g. the state storage of a window with a huge tree: ImGui::GetStateStorage()->SetUseHashIndex(true).
+    // - Pairs in Data[] are kept in insertion order instead of being sorted by key. Extra memory cost is 8 to 16 bytes per pair.
+    // - Pairs added to or removed from Data[] directly are detected by size and cause a full rebuild of the index on the next query. Don't change the
+    //   keys of existing pairs in Data[] directly (or call BuildSortByKey() afterwards), the index can't detect it.
+    IMGUI_API void      SetUseHashIndex(bool use_hash_index);
 };
 
 // Helper: Manually clip large list of items.
@@ -2163,6 +2225,8 @@ struct ImGuiListClipper
     int     ItemsFrozen;
     float   ItemsHeight;
     float   StartPosY;
+    ImGuiListItemHeights* ItemsHeights;     // Variable height mode
+    float   ItemPosY;                       // Variable height mode: position of item DisplayStart
 
     IMGUI_API ImGuiListClipper();
     IMGUI_API ~ImGuiListClipper();
@@ -2173,11 +2237,40 @@ struct ImGuiListClipper
     IMGUI_API void End();                                               // Automatically called on the last call of Step() that returns false.
     IMGUI_API bool Step();                                              // Call until it returns false. The DisplayStart/DisplayEnd fields will be set and you can process/draw those items.
 
+    // Variable height mode: items may have different heights, stored in 'items_heights' which persists across frames (see ImGuiListItemHeights).
+    // Visible items are returned one at a time (DisplayEnd == DisplayStart + 1) so the clipper can measure and store the height of each of them.
+    IMGUI_API void BeginVariableHeights(int items_count, ImGuiListItemHeights* items_heights);
+    IMGUI_API void ScrollToItem(int item_index, float center_y_ratio = 0.5f); // Call between Begin() and the first Step() to scroll to an item which may not be submitted this frame, like SetScrollHereY() would. center_y_ratio: 0.0f top, 0.5f center, 1.0f bottom.
+
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
     inline ImGuiListClipper(int items_count, float items_height = -1.0f) { memset(this, 0, sizeof(*this)); ItemsCount = -1; Begin(items_count, items_height); } // [removed in 1.79]
 #endif
 };
 
+// Helper: Heights of the items of a list, for ImGuiListClipper::BeginVariableHeights()
+// - Heights are the distance between the start of an item and the start of the next one (so they include ItemSpacing.y, or the row height in a table).
+// - Unknown heights use the default height: the clipper measures visible items and updates their height as you scroll through the list.
+//   If you know the height of your items you can call SetItemHeight() for them beforehand, so the scrollbar is exact from the start.
+// - Heights are stored in a Fenwick tree (binary indexed tree) of partial sums, so finding the item at a given position,
+//   the position of a given item or changing the height of an item are all O(log N). Memory usage is 12 bytes per item.
+//   Partial sums use double precision so repeatedly updating heights doesn't accumulate errors.
+struct ImGuiListItemHeights
+{
+    ImVector<float>     Heights;        // Height of each item
+    ImVector<double>    Sums;           // [Internal] Fenwick tree: Sums[n] is the sum of Heights[] in the range ((n + 1) - lowest_bit(n + 1), n]
+    float               DefaultHeight;  // Height of newly added items
+
+    ImGuiListItemHeights()              { DefaultHeight = 0.0f; }
+    int             Size() const        { return Heights.Size; }
+    float           GetItemHeight(int item_index) const { return Heights[item_index]; }
+    float           GetTotalHeight() const              { return GetItemOffset(Heights.Size); }
+    IMGUI_API void  Clear();
+    IMGUI_API void  Resize(int items_count, float default_height);  // Add or remove items at the end of the list. Heights of existing items are preserved. O(log N) per item added.
+    IMGUI_API void  SetItemHeight(int item_index, float height);    // O(log N)
+    IMGUI_API float GetItemOffset(int item_index) const;            // Sum of the heights of items before 'item_index'. O(log N)
+    IMGUI_API int   FindItemAtOffset(float offset) const;           // Index of the item covering 'offset' (clamped to the list). O(log N)
+};
+
 // Helpers macros to generate 32-bit encoded colors
 #ifdef IMGUI_USE_BGRA_PACKED_COLOR
 #define IM_COL32_R_SHIFT    16
@@ -2245,6 +2338,11 @@ typedef void (*ImDrawCallback)(const ImDrawList* parent_list, const ImDrawCmd* c
 // It is not done by default because they are many perfectly useful way of altering render state for imgui contents (e.g. changing shader/blending settings before an Image call).
 #define ImDrawCallback_ResetRenderState     (ImDrawCallback)(-1)
 
+// Special Draw callback value used as a placeholder by ImDrawList::AddDrawListDeferred().
+// It is replaced by the contents of the deferred draw list during ImGui::Render(), so renderer backends never see it
+// (unless you render your own ImDrawList which you haven't passed through ImDrawList::_SpliceDeferredDrawLists()).
+#define ImDrawCallback_SpliceDrawList       (ImDrawCallback)(-2)
+
 // Typically, 1 command = 1 GPU draw call (unless command is a callback)
 // - VtxOffset/IdxOffset: When 'io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset' is enabled,
 //   those fields allow us to render meshes larger than 64K vertices while keeping 16-bit indices.
@@ -2353,6 +2451,11 @@ enum ImDrawListFlags_
 // In single viewport mode, top-left is == GetMainViewport()->Pos (generally 0,0), bottom-right is == GetMainViewport()->Pos+Size (generally io.DisplaySize).
 // You are totally free to apply whatever transformation matrix to want to the data (depending on the use of the transformation you may want to apply it to ClipRect as well!)
 // Important: Primitives are always added to the list and not culled (culling is done at higher-level by ImGui:: functions), if you use this API a lot consider coarse culling your drawn objects.
+// Skipping uploads: with 'io.BackendFlags |= ImGuiBackendFlags_RendererHasContentHash', a renderer may keep GPU buffers per ImDrawList* and only re-upload
+// them when ContentGeneration differs from the value it cached. Generations are unique within a context, so a new list allocated at the address of a
+// destroyed one never matches a stale cache entry. User callbacks are hashed by address: if they depend on other state, handle it on your side.
+// Render() hashes the whole contents of every list each frame (it is not updated incrementally as primitives are added), which costs about as much as
+// one copy of the draw data. This is only worth it when uploading or rendering is more expensive than that (e.g. software or remote renderers).
 struct ImDrawList
 {
     // This is what you have to render
@@ -2360,6 +2463,8 @@ struct ImDrawList
     ImVector<ImDrawIdx>     IdxBuffer;          // Index buffer. Each command consume ImDrawCmd::ElemCount of those
     ImVector<ImDrawVert>    VtxBuffer;          // Vertex buffer.
     ImDrawListFlags         Flags;              // Flags, you may poke into these to adjust anti-aliasing settings per-primitive.
+    unsigned int            ContentGeneration;  // [Read-only] Set by Render(). Changes whenever the contents (CmdBuffer, IdxBuffer, VtxBuffer) differ from the last time this list was rendered. Only stays the same when ImGuiBackendFlags_RendererHasContentHash is set.
+    bool                    ContentUnchanged;   // [Read-only] Set by Render(). == (ContentGeneration is the same as the last time this list was rendered).
 
     // [Internal, used while building lists]
     unsigned int            _VtxCurrentIdx;     // [Internal] generally == VtxBuffer.Size unless we are past 64K vertices, in which case this gets reset to 0.
@@ -2373,6 +2478,8 @@ struct ImDrawList
     ImDrawCmdHeader         _CmdHeader;         // [Internal] template of active commands. Fields should match those of CmdBuffer.back().
     ImDrawListSplitter      _Splitter;          // [Internal] for channels api (note: prefer using your own persistent instance of ImDrawListSplitter!)
     float                   _FringeScale;       // [Internal] anti-alias fringe is scaled by this value, this helps to keep things sharp while zooming at vertex buffer content
+    ImDrawListRetained*     _Retained;          // [Internal] retained geometry state, set by owner window using ImGuiWindowFlags_RetainGeometry
+    ImU64                   _ContentHash;       // [Internal] hash of contents when last rendered, see ContentGeneration
 
     // If you want to create ImDrawList instances, pass them ImGui::GetDrawListSharedData() or create and use your own ImDrawListSharedData (so you can use ImDrawList without ImGui)
     ImDrawList(const ImDrawListSharedData* shared_data) { memset(this, 0, sizeof(*this)); _Data = shared_data; }
@@ -2435,6 +2542,23 @@ struct ImDrawList
     IMGUI_API void  AddCallback(ImDrawCallback callback, void* callback_data);  // Your rendering function must check for 'UserCallback' in ImDrawCmd and call the function instead of rendering triangles.
     IMGUI_API void  AddDrawCmd();                                               // This is useful if you need to forcefully create a new draw call (to allow for dependent rendering / blending). Otherwise primitives are merged into the same draw-call as much as possible
     IMGUI_API ImDrawList* CloneOutput() const;                                  // Create a clone of the CmdBuffer/IdxBuffer/VtxBuffer.
+    IMGUI_API void  AddDrawList(const ImDrawList* draw_list);                   // Append the output of another draw list. Clip rectangles are intersected with the current one, TextureId are preserved.
+    IMGUI_API void  AddDrawListDeferred(const ImDrawList* draw_list);           // Reserve a spot for the output of another draw list, which is copied in during ImGui::Render(). 'draw_list' needs to stay valid until then.
+
+    // Advanced: Multi-threaded recording
+    // - ImGui:: functions and a window draw list may only be used from the thread calling NewFrame()/Render(), but a detached ImDrawList
+    //   can be recorded on another thread then spliced into a window draw list with AddDrawList() or AddDrawListDeferred(), e.g.:
+    //     ImDrawList* dl = IM_NEW(ImDrawList)(ImGui::GetDrawListSharedData());   // Persistent, created once
+    //     dl->_ResetForNewFrame(); dl->PushClipRectFullScreen(); dl->PushTextureID(io.Fonts->TexID);
+    //     [worker thread] dl->AddRectFilled(...); dl->AddText(font, font_size, ...);
+    //     ImGui::GetWindowDrawList()->AddDrawListDeferred(dl);                    // While the worker is still running
+    //     [wait for worker to finish] ImGui::Render();
+    // - Record between NewFrame() and Render(): ImDrawListSharedData and the font atlas are only read from, but are updated by NewFrame().
+    // - Pass the ImFont explicitly to AddText(): the default font in ImDrawListSharedData may be changed by PushFont() on the main thread.
+    // - Vertices are rebased using ImDrawCmd::VtxOffset if the backend supports it (ImGuiBackendFlags_RendererHasVtxOffset), otherwise indices are rewritten.
+    // - Memory allocated by worker threads goes through ImGui::MemAlloc(): your allocator needs to be thread-safe. Allocations from threads other than
+    //   the one which called CreateContext() or last called NewFrame() go straight to the heap and are not counted in io.MetricsActiveAllocations and Metrics->Memory, so the count
+    //   becomes imprecise if memory is freed on another thread than it was allocated on (prefer reusing persistent draw lists, which stop allocating).
 
     // Advanced: Channels
     // - Use to split render into layers. By switching channels to can render out-of-order (e.g. submit FG primitives before BG primitives)
@@ -2467,12 +2591,23 @@ struct ImDrawList
     IMGUI_API void  _ResetForNewFrame();
     IMGUI_API void  _ClearFreeMemory();
     IMGUI_API void  _PopUnusedDrawCmd();
+    IMGUI_API void  _SpliceDeferredDrawLists();
+    IMGUI_API ImU64 _CalcContentHash() const;
     IMGUI_API void  _OnChangedClipRect();
     IMGUI_API void  _OnChangedTextureID();
     IMGUI_API void  _OnChangedVtxOffset();
     IMGUI_API int   _CalcCircleAutoSegmentCount(float radius) const;
 };
 
+// Flags for ImDrawData::MergeBuffers()
+enum ImDrawDataMergeFlags_
+{
+    ImDrawDataMergeFlags_None               = 0,
+    ImDrawDataMergeFlags_RebaseIndices      = 1 << 0,   // Add vertex offsets to the indices themselves so every output command has VtxOffset == 0. For renderers without ImGuiBackendFlags_RendererHasVtxOffset, and required for MergeCmds to merge across draw lists. With 16-bit indices this requires TotalVtxCount <= 64K.
+    ImDrawDataMergeFlags_MergeCmds          = 1 << 1,   // Merge consecutive commands using the same texture and clip rectangle into a single draw call, including across draw lists.
+    ImDrawDataMergeFlags_MergeContainedClip = 1 << 2    // With MergeCmds: also merge commands with different clip rectangles when the geometry of one is fully contained in the clip rectangle of the other, so clipping doesn't change the output (scans vertex positions).
+};
+
 // All draw data to render a Dear ImGui frame
 // (NB: the style and the naming convention here is a little inconsistent, we currently preserve them for backward compatibility purpose,
 // as this is one of the oldest structure exposed by the library! Basically, ImDrawList == CmdList)
@@ -2486,12 +2621,14 @@ struct ImDrawData
     ImVec2          DisplayPos;             // Top-left position of the viewport to render (== top-left of the orthogonal projection matrix to use) (== GetMainViewport()->Pos for the main viewport, == (0.0) in most single-viewport applications)
     ImVec2          DisplaySize;            // Size of the viewport to render (== GetMainViewport()->Size for the main viewport, == io.DisplaySize in most single-viewport applications)
     ImVec2          FramebufferScale;       // Amount of pixels for each unit of DisplaySize. Based on io.DisplayFramebufferScale. Generally (1,1) on normal display, (2,2) on OSX with Retina display.
+    int             CmdListsUnchangedCount; // Number of ImDrawList with ContentUnchanged == true. Always 0 unless ImGuiBackendFlags_RendererHasContentHash is set.
 
     // Functions
     ImDrawData()    { Clear(); }
     void Clear()    { memset(this, 0, sizeof(*this)); }     // The ImDrawList are owned by ImGuiContext!
     IMGUI_API void  DeIndexAllBuffers();                    // Helper to convert all buffers from indexed to non-indexed, in case you cannot render indexed. Note: this is slow and most likely a waste of resources. Always prefer indexed rendering!
     IMGUI_API void  ScaleClipRects(const ImVec2& fb_scale); // Helper to scale the ClipRect field of each ImDrawCmd. Use if your final output buffer is at a different scale than Dear ImGui expects, or if there is a difference between your window resolution and framebuffer resolution.
+    IMGUI_API int   MergeBuffers(ImDrawVert* vtx_dst, ImDrawIdx* idx_dst, ImVector<ImDrawCmd>* out_cmds, ImDrawDataMergeFlags flags = 0) const; // Helper to write the vertices/indices of all lists contiguously into a single destination (e.g. mapped GPU buffers of TotalVtxCount/TotalIdxCount elements) and output all commands with offsets rebased on it, so the frame can be uploaded and drawn with fewer calls. Return number of output commands. See comments in imgui_draw.cpp.
 };
 
 //-----------------------------------------------------------------------------
@@ -2566,13 +2703,21 @@ struct ImFontAtlasCustomRect
     bool IsPacked() const           { return X != 0xFFFF; }
 };
 
+// Region of the atlas texture modified after Build(), see ImFontAtlas::TexDirtyRects.
+struct ImFontAtlasDirtyRect
+{
+    unsigned short  X, Y;
+    unsigned short  Width, Height;
+};
+
 // Flags for ImFontAtlas build
 enum ImFontAtlasFlags_
 {
     ImFontAtlasFlags_None               = 0,
     ImFontAtlasFlags_NoPowerOfTwoHeight = 1 << 0,   // Don't round the height to next power of two
     ImFontAtlasFlags_NoMouseCursors     = 1 << 1,   // Don't build software mouse cursors into the atlas (save a little texture memory)
-    ImFontAtlasFlags_NoBakedLines       = 1 << 2    // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_NoBakedLines       = 1 << 2,   // Don't build thick line textures into the atlas (save a little texture memory). The AntiAliasedLinesUseTex features uses them, otherwise they will be rendered using polygons (more expensive for CPU/GPU).
+    ImFontAtlasFlags_DynamicGlyphs      = 1 << 3    // Only rasterize U+0000..U+00FF in Build(). Other glyphs of the requested ranges are rasterized on first use into a reserved area of the texture (see TexGlyphCacheHeight), evicting least recently used glyphs when full. Your backend needs to upload TexDirtyRects[] before rendering. Keep input and texture data alive (don't call ClearInputData()/ClearTexData()). stb_truetype builder only.
 };
 
 // Load and rasterize multiple TTF/OTF fonts into a same texture. The font atlas will build a single texture holding:
@@ -2592,6 +2737,11 @@ enum ImFontAtlasFlags_
 //   You can set font_cfg->FontDataOwnedByAtlas=false to keep ownership of your data and it won't be freed,
 // - Even though many functions are suffixed with "TTF", OTF data is supported just as well.
 // - This is an old API and it is currently awkward for those and and various other reasons! We will address them in the future!
+// Dynamic glyphs (Flags |= ImFontAtlasFlags_DynamicGlyphs):
+// - Large ranges (e.g. GetGlyphRangesChineseFull()) are not rasterized in Build(). Instead ImFont::FindGlyph() queues missing glyphs
+//   and returns the fallback glyph, and the next ImGui::NewFrame() calls UpdateGlyphCache() to rasterize them into the texture.
+// - Modified regions are appended to TexDirtyRects[]: upload them (reading from GetTexDataAsXXX() pixels) then clear the array.
+// - Queuing glyphs is not thread-safe: don't render text with such atlas from multiple threads at the same time.
 struct ImFontAtlas
 {
     IMGUI_API ImFontAtlas();
@@ -2615,9 +2765,21 @@ struct ImFontAtlas
     IMGUI_API bool              Build();                    // Build pixels data. This is called automatically for you by the GetTexData*** functions.
     IMGUI_API void              GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 1 byte per-pixel
     IMGUI_API void              GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel = NULL);  // 4 bytes-per-pixel
+    IMGUI_API void              UpdateGlyphCache();         // Rasterize glyphs queued since last call, appending to TexDirtyRects[]. Called by ImGui::NewFrame() (ImFontAtlasFlags_DynamicGlyphs only).
     bool                        IsBuilt() const             { return Fonts.Size > 0 && (TexPixelsAlpha8 != NULL || TexPixelsRGBA32 != NULL); }
     void                        SetTexID(ImTextureID id)    { TexID = id; }
 
+    // Build cache: save the output of Build() (texture, glyphs, lookup tables, custom rectangles) and load it back on a later run to skip rasterization.
+    // The cache is keyed on the font data and all ImFontConfig/atlas inputs: loading fails and leaves the atlas untouched if anything changed, call Build() then.
+    // e.g.  if (!io.Fonts->LoadBuildCacheFromDisk("fonts.cache")) { io.Fonts->Build(); io.Fonts->SaveBuildCacheToDisk("fonts.cache"); }
+    // The format is a flat blob of 4-byte aligned sections (native endianness), LoadBuildCacheFromMemory() can read it directly from a memory-mapped file.
+    // Not supported with ImFontAtlasFlags_DynamicGlyphs. If you change FontBuilderIO to a custom builder, use separate cache files.
+    IMGUI_API ImU32             GetBuildCacheKey() const;
+    IMGUI_API bool              SaveBuildCacheToMemory(ImVector<unsigned char>* out_data) const;   // Atlas needs to be built.
+    IMGUI_API bool              LoadBuildCacheFromMemory(const void* data, size_t data_size);      // Return false if the data is invalid or was built from different inputs.
+    IMGUI_API bool              SaveBuildCacheToDisk(const char* filename) const;
+    IMGUI_API bool              LoadBuildCacheFromDisk(const char* filename);
+
     //-------------------------------------------
     // Glyph Ranges
     //-------------------------------------------
@@ -2661,6 +2823,9 @@ struct ImFontAtlas
     ImTextureID                 TexID;              // User data to refer to the texture once it has been uploaded to user's graphic systems. It is passed back to you during rendering via the ImDrawCmd structure.
     int                         TexDesiredWidth;    // Texture width desired by user before Build(). Must be a power-of-two. If have many glyphs your graphics API have texture size restrictions you may want to increase texture width to decrease height.
     int                         TexGlyphPadding;    // Padding between glyphs within texture in pixels. Defaults to 1. If your rendering method doesn't rely on bilinear filtering you may set this to 0.
+    int                         TexGlyphCacheHeight;// Minimum height of the texture area reserved for glyphs rasterized on demand with ImFontAtlasFlags_DynamicGlyphs. Defaults to 512.
+    ImFontAtlasParallelForFunc  BuildParallelForFunc;       // Optional dispatcher used by Build() to rasterize glyphs in parallel. Must call job_func(job_data, n) once for each n in [0, jobs_count), from any threads, and return once all calls have completed. Output is identical to the single-threaded build.
+    void*                       BuildParallelForUserData;   // Passed as 'user_data' to BuildParallelForFunc.
 
     // [Internal]
     // NB: Access texture data via GetTexData*() calls! Which will setup a default font for you.
@@ -2674,10 +2839,12 @@ struct ImFontAtlas
     ImVector<ImFontAtlasCustomRect> CustomRects;    // Rectangles for packing custom texture data into the atlas.
     ImVector<ImFontConfig>      ConfigData;         // Configuration data
     ImVec4                      TexUvLines[IM_DRAWLIST_TEX_LINES_WIDTH_MAX + 1];  // UVs for baked anti-aliased lines
+    ImVector<ImFontAtlasDirtyRect> TexDirtyRects;   // Regions of the texture modified since Build() by UpdateGlyphCache(). Backend uploads them then clears the array.
 
     // [Internal] Font builder
     const ImFontBuilderIO*      FontBuilderIO;      // Opaque interface to a font builder (default to stb_truetype, can be changed to use FreeType by defining IMGUI_ENABLE_FREETYPE).
     unsigned int                FontBuilderFlags;   // Shared flags (for all fonts) for custom font builder. THIS IS BUILD IMPLEMENTATION DEPENDENT. Per-font override is also available in ImFontConfig.
+    ImFontAtlasGlyphCache*      GlyphCache;         // Glyphs rasterized on demand (ImFontAtlasFlags_DynamicGlyphs), created by Build()
 
     // [Internal] Packing data
     int                         PackIdMouseCursors; // Custom texture rectangle ID for white pixel and mouse cursors
@@ -2714,6 +2881,8 @@ struct ImFont
     float                       Ascent, Descent;    // 4+4   // out //            // Ascent: distance from top to bottom of e.g. 'A' [0..FontSize]
     int                         MetricsTotalSurface;// 4     // out //            // Total surface in pixels to get an idea of the font rasterization/texture cost (not exact, we approximate the cost of padding between glyphs)
     ImU8                        Used4kPagesMap[(IM_UNICODE_CODEPOINT_MAX+1)/4096/8]; // 2 bytes if ImWchar=ImWchar16, 34 bytes if ImWchar==ImWchar32. Store 1-bit for each block of 4K codepoints that has one active glyph. This is mainly used to facilitate iterations across all used codepoints.
+    ImVector<int>               GlyphsLastUsedFrame;// 12-16 // out //            // ImFontAtlasFlags_DynamicGlyphs: Glyphs[] index -> last frame the glyph was returned by FindGlyph(), for eviction.
+    unsigned int                GlyphsGeneration;   // 4     // out //            // Unique value updated whenever glyphs or their advances change (build, remap, glyphs loaded or evicted with ImFontAtlasFlags_DynamicGlyphs), so cached text measurements can tell when they are stale.
 
     // Methods
     IMGUI_API ImFont();
@@ -2735,6 +2904,7 @@ struct ImFont
     IMGUI_API void              BuildLookupTable();
     IMGUI_API void              ClearOutputData();
     IMGUI_API void              GrowIndex(int new_size);
+    IMGUI_API void              UpdateGlyphsGeneration();
     IMGUI_API void              AddGlyph(const ImFontConfig* src_cfg, ImWchar c, float x0, float y0, float x1, float y1, float u0, float v0, float u1, float v1, float advance_x);
     IMGUI_API void              AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst = true); // Makes 'dst' character/glyph points to 'src' character/glyph. Currently needs to be called AFTER fonts have been built.
     IMGUI_API void              SetGlyphVisible(ImWchar c, bool visible);
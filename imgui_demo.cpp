@@ -449,10 +449,11 @@ void ImGui::ShowDemoWindow(bool* p_open)
 
             // Make a local copy to avoid modifying actual backend flags.
             ImGuiBackendFlags backend_flags = io.BackendFlags;
-            ImGui::CheckboxFlags("io.BackendFlags: HasGamepad",           &backend_flags, ImGuiBackendFlags_HasGamepad);
-            ImGui::CheckboxFlags("io.BackendFlags: HasMouseCursors",      &backend_flags, ImGuiBackendFlags_HasMouseCursors);
-            ImGui::CheckboxFlags("io.BackendFlags: HasSetMousePos",       &backend_flags, ImGuiBackendFlags_HasSetMousePos);
-            ImGui::CheckboxFlags("io.BackendFlags: RendererHasVtxOffset", &backend_flags, ImGuiBackendFlags_RendererHasVtxOffset);
+            ImGui::CheckboxFlags("io.BackendFlags: HasGamepad",             &backend_flags, ImGuiBackendFlags_HasGamepad);
+            ImGui::CheckboxFlags("io.BackendFlags: HasMouseCursors",        &backend_flags, ImGuiBackendFlags_HasMouseCursors);
+            ImGui::CheckboxFlags("io.BackendFlags: HasSetMousePos",         &backend_flags, ImGuiBackendFlags_HasSetMousePos);
+            ImGui::CheckboxFlags("io.BackendFlags: RendererHasVtxOffset",   &backend_flags, ImGuiBackendFlags_RendererHasVtxOffset);
+            ImGui::CheckboxFlags("io.BackendFlags: RendererHasContentHash", &backend_flags, ImGuiBackendFlags_RendererHasContentHash);
             ImGui::TreePop();
             ImGui::Separator();
         }
@@ -1549,6 +1550,10 @@ static void ShowDemoWindowWidgets()
         static bool animate = true;
         ImGui::Checkbox("Animate", &animate);
 
+        // Request frames while animating, for applications sleeping while idle (see io.WaitBeforeNextFrame)
+        if (animate)
+            ImGui::SetMaxWaitBeforeNextFrame(0.0f);
+
         static float arr[] = { 0.6f, 0.1f, 1.0f, 0.5f, 0.92f, 0.1f, 0.2f };
         ImGui::PlotLines("Frame Times", arr, IM_ARRAYSIZE(arr));
 
@@ -3075,6 +3080,50 @@ static void ShowDemoWindowLayout()
 
         ImGui::TreePop();
     }
+
+    if (ImGui::TreeNode("Clipper with variable heights"))
+    {
+        HelpMarker(
+            "Using ImGuiListClipper::BeginVariableHeights() to only submit the visible items of a list where items have different heights.\n"
+            "Heights are stored in a ImGuiListItemHeights which persists across frames: "
+            "items are measured as they become visible and the scrollbar is adjusted accordingly.");
+        static ImGuiListItemHeights heights;
+        static int items_count = 1000000;
+        static int scroll_to_item = 500000;
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+        ImGui::DragInt("Items", &items_count, 1000.0f, 0, 10000000);
+        ImGui::SetNextItemWidth(ImGui::GetFontSize() * 8);
+        ImGui::InputInt("##scroll_to_item", &scroll_to_item);
+        scroll_to_item = IM_CLAMP(scroll_to_item, 0, IM_MAX(items_count - 1, 0));
+        ImGui::SameLine();
+        bool scroll_to = ImGui::Button("Scroll to item");
+
+        int submitted_count = 0;
+        ImGui::BeginChild("##items", ImVec2(0, ImGui::GetFontSize() * 20), true);
+        ImGuiListClipper clipper;
+        clipper.BeginVariableHeights(items_count, &heights);
+        if (scroll_to && items_count > 0)
+            clipper.ScrollToItem(scroll_to_item, 0.0f);
+        while (clipper.Step())
+            for (int i = clipper.DisplayStart; i < clipper.DisplayEnd; i++)
+            {
+                // Every 7th item wraps a long text, every 10th item is a tree node which can be opened
+                submitted_count++;
+                if (i % 7 == 0)
+                    ImGui::TextWrapped("Item %d: The quick brown fox jumps over the lazy dog. The quick brown fox jumps over the lazy dog.", i);
+                else if (i % 10 == 0 && ImGui::TreeNode((void*)(intptr_t)i, "Item %d", i))
+                {
+                    ImGui::Text("Blah blah");
+                    ImGui::Text("Blah blah");
+                    ImGui::TreePop();
+                }
+                else if (i % 10 != 0)
+                    ImGui::Text("Item %d", i);
+            }
+        ImGui::EndChild();
+        ImGui::Text("%d items submitted, total height %.0f", submitted_count, heights.GetTotalHeight());
+        ImGui::TreePop();
+    }
 }
 
 static void ShowDemoWindowPopups()
@@ -4151,6 +4200,36 @@ static void ShowDemoWindowTables()
             }
             ImGui::EndTable();
         }
+
+        ImGui::Spacing();
+        ImGui::TextUnformatted("Many columns + ScrollX");
+        ImGui::SameLine();
+        HelpMarker(
+            "Tables may have up to IMGUI_TABLE_MAX_COLUMNS columns.\n"
+            "Using TableNextVisibleColumn() we only submit columns which are in sight, the same way ImGuiListClipper "
+            "only submits rows which are in sight, so the cost of a row scales with visible rather than total columns.");
+        const int columns_count3 = 1000;
+        if (ImGui::BeginTable("table3", columns_count3, flags, outer_size))
+        {
+            ImGui::TableSetupScrollFreeze(freeze_cols, freeze_rows);
+            for (int column = 0; column < columns_count3; column++)
+            {
+                char label[16];
+                sprintf(label, "Col %d", column);
+                ImGui::TableSetupColumn(label, column == 0 ? ImGuiTableColumnFlags_NoHide : ImGuiTableColumnFlags_None);
+            }
+            ImGui::TableHeadersRow();
+            ImGuiListClipper clipper;
+            clipper.Begin(1000);
+            while (clipper.Step())
+                for (int row = clipper.DisplayStart; row < clipper.DisplayEnd; row++)
+                {
+                    ImGui::TableNextRow();
+                    while (ImGui::TableNextVisibleColumn())
+                        ImGui::Text("Hello %d,%d", ImGui::TableGetColumnIndex(), row);
+                }
+            ImGui::EndTable();
+        }
         ImGui::TreePop();
     }
 
@@ -5664,6 +5743,7 @@ void ImGui::ShowAboutWindow(bool* p_open)
         if (io.BackendFlags & ImGuiBackendFlags_HasMouseCursors)        ImGui::Text(" HasMouseCursors");
         if (io.BackendFlags & ImGuiBackendFlags_HasSetMousePos)         ImGui::Text(" HasSetMousePos");
         if (io.BackendFlags & ImGuiBackendFlags_RendererHasVtxOffset)   ImGui::Text(" RendererHasVtxOffset");
+        if (io.BackendFlags & ImGuiBackendFlags_RendererHasContentHash) ImGui::Text(" RendererHasContentHash");
         ImGui::Separator();
         ImGui::Text("io.Fonts: %d fonts, Flags: 0x%08X, TexSize: %d,%d", io.Fonts->Fonts.Size, io.Fonts->Flags, io.Fonts->TexWidth, io.Fonts->TexHeight);
         ImGui::Text("io.DisplaySize: %.2f,%.2f", io.DisplaySize.x, io.DisplaySize.y);
@@ -6569,6 +6649,7 @@ struct ExampleAppLog
 {
     ImGuiTextBuffer     Buf;
     ImGuiTextFilter     Filter;
+    ImGuiTextFilterIndex FilterIndex; // Lines passing the filter. Only new lines are tested every frame, until the filter is modified.
     ImVector<int>       LineOffsets; // Index to lines offset. We maintain this with AddLog() calls.
     bool                AutoScroll;  // Keep scrolling if already at the bottom.
 
@@ -6583,11 +6664,20 @@ struct ExampleAppLog
         Buf.clear();
         LineOffsets.clear();
         LineOffsets.push_back(0);
+        FilterIndex.Clear();
+    }
+
+    static void GetLine(void* data, int line_no, const char** out_text, const char** out_text_end)
+    {
+        ExampleAppLog* log = (ExampleAppLog*)data;
+        *out_text = log->Buf.begin() + log->LineOffsets[line_no];
+        *out_text_end = (line_no + 1 < log->LineOffsets.Size) ? (log->Buf.begin() + log->LineOffsets[line_no + 1] - 1) : log->Buf.end();
     }
 
     void    AddLog(const char* fmt, ...) IM_FMTARGS(2)
     {
         int old_size = Buf.size();
+        FilterIndex.InvalidateFrom(LineOffsets.Size - 1); // Text is appended to the last line
         va_list args;
         va_start(args, fmt);
         Buf.appendfv(fmt, args);
@@ -6631,50 +6721,33 @@ struct ExampleAppLog
             ImGui::LogToClipboard();
 
         ImGui::PushStyleVar(ImGuiStyleVar_ItemSpacing, ImVec2(0, 0));
-        const char* buf = Buf.begin();
-        const char* buf_end = Buf.end();
-        if (Filter.IsActive())
-        {
-            // In this example we don't use the clipper when Filter is enabled.
-            // This is because we don't have a random access on the result on our filter.
-            // A real application processing logs with ten of thousands of entries may want to store the result of
-            // search/filter.. especially if the filtering function is not trivial (e.g. reg-exp).
-            for (int line_no = 0; line_no < LineOffsets.Size; line_no++)
-            {
-                const char* line_start = buf + LineOffsets[line_no];
-                const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
-                if (Filter.PassFilter(line_start, line_end))
-                    ImGui::TextUnformatted(line_start, line_end);
-            }
-        }
-        else
+        // The simplest and easy way to display the entire buffer:
+        //   ImGui::TextUnformatted(buf_begin, buf_end);
+        // And it'll just work. TextUnformatted() has specialization for large blob of text and will fast-forward
+        // to skip non-visible lines. Here we instead demonstrate using the clipper to only process lines that are
+        // within the visible area.
+        // If you have tens of thousands of items and their processing cost is non-negligible, coarse clipping them
+        // on your side is recommended. Using ImGuiListClipper requires
+        // - A) random access into your data
+        // - B) items all being the  same height,
+        // both of which we can handle since we an array pointing to the beginning of each line of text.
+        // When using the filter, ImGuiTextFilterIndex gives us random access into the lines passing the filter
+        // (and when the filter is not active, it simply returns all lines). It remembers which lines passed, so
+        // only lines added since the last frame are tested, which matters with tens of thousands of entries.
+        FilterIndex.Update(Filter, LineOffsets.Size, GetLine, this);
+        ImGuiListClipper clipper;
+        clipper.Begin(FilterIndex.Size());
+        while (clipper.Step())
         {
-            // The simplest and easy way to display the entire buffer:
-            //   ImGui::TextUnformatted(buf_begin, buf_end);
-            // And it'll just work. TextUnformatted() has specialization for large blob of text and will fast-forward
-            // to skip non-visible lines. Here we instead demonstrate using the clipper to only process lines that are
-            // within the visible area.
-            // If you have tens of thousands of items and their processing cost is non-negligible, coarse clipping them
-            // on your side is recommended. Using ImGuiListClipper requires
-            // - A) random access into your data
-            // - B) items all being the  same height,
-            // both of which we can handle since we an array pointing to the beginning of each line of text.
-            // When using the filter (in the block of code above) we don't have random access into the data to display
-            // anymore, which is why we don't use the clipper. Storing or skimming through the search result would make
-            // it possible (and would be recommended if you want to search through tens of thousands of entries).
-            ImGuiListClipper clipper;
-            clipper.Begin(LineOffsets.Size);
-            while (clipper.Step())
+            for (int n = clipper.DisplayStart; n < clipper.DisplayEnd; n++)
             {
-                for (int line_no = clipper.DisplayStart; line_no < clipper.DisplayEnd; line_no++)
-                {
-                    const char* line_start = buf + LineOffsets[line_no];
-                    const char* line_end = (line_no + 1 < LineOffsets.Size) ? (buf + LineOffsets[line_no + 1] - 1) : buf_end;
-                    ImGui::TextUnformatted(line_start, line_end);
-                }
+                const char* line_start;
+                const char* line_end;
+                GetLine(this, FilterIndex.GetItemIndex(n), &line_start, &line_end);
+                ImGui::TextUnformatted(line_start, line_end);
             }
-            clipper.End();
         }
+        clipper.End();
         ImGui::PopStyleVar();
 
         if (AutoScroll && ImGui::GetScrollY() >= ImGui::GetScrollMaxY())
@@ -8,6 +8,7 @@ Index of this file:
 // [SECTION] STB libraries implementation
 // [SECTION] Style functions
 // [SECTION] ImDrawList
+// [SECTION] ImDrawList retained geometry
 // [SECTION] ImDrawListSplitter
 // [SECTION] ImDrawData
 // [SECTION] Helpers ShadeVertsXXX functions
@@ -138,8 +139,29 @@ namespace IMGUI_STB_NAMESPACE
 #ifdef  IMGUI_ENABLE_STB_TRUETYPE
 #ifndef STB_TRUETYPE_IMPLEMENTATION                         // in case the user already have an implementation in the _same_ compilation unit (e.g. unity builds)
 #ifndef IMGUI_DISABLE_STB_TRUETYPE_IMPLEMENTATION           // in case the user already have an implementation in another compilation unit
-#define STBTT_malloc(x,u)   ((void)(u), IM_ALLOC(x))
-#define STBTT_free(x,u)     ((void)(u), IM_FREE(x))
+// Rasterization jobs dispatched by ImFontAtlas::BuildParallelForFunc set a non-NULL stbtt_fontinfo::userdata so their allocations
+// go straight to the allocator functions: ImGui::MemAlloc() updates per-context statistics which are not thread-safe.
+static void* ImFontAtlasBuildStbttAlloc(size_t sz, void* user_data)
+{
+    if (user_data == NULL)
+        return IM_ALLOC(sz);
+    ImGuiMemAllocFunc* alloc_func; ImGuiMemFreeFunc* free_func; void* alloc_user_data;
+    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &alloc_user_data);
+    return alloc_func(sz, alloc_user_data);
+}
+static void ImFontAtlasBuildStbttFree(void* ptr, void* user_data)
+{
+    if (user_data == NULL)
+    {
+        IM_FREE(ptr);
+        return;
+    }
+    ImGuiMemAllocFunc* alloc_func; ImGuiMemFreeFunc* free_func; void* alloc_user_data;
+    ImGui::GetAllocatorFunctions(&alloc_func, &free_func, &alloc_user_data);
+    free_func(ptr, alloc_user_data);
+}
+#define STBTT_malloc(x,u)   ImFontAtlasBuildStbttAlloc(x,u)
+#define STBTT_free(x,u)     ImFontAtlasBuildStbttFree(x,u)
 #define STBTT_assert(x)     do { IM_ASSERT(x); } while(0)
 #define STBTT_fmod(x,y)     ImFmod(x,y)
 #define STBTT_sqrt(x)       ImSqrt(x)
@@ -388,6 +410,28 @@ void ImDrawListSharedData::SetCircleTessellationMaxError(float max_error)
     }
 }
 
+// Retained geometry hooks (see ImGuiWindowFlags_RetainGeometry and the ImDrawList retained geometry section below)
+enum ImDrawListRetainedPrimType
+{
+    ImDrawListRetainedPrimType_SharedData,
+    ImDrawListRetainedPrimType_CmdHeader,
+    ImDrawListRetainedPrimType_UntrackedWrite,
+    ImDrawListRetainedPrimType_Polyline,
+    ImDrawListRetainedPrimType_ConvexPolyFilled,
+    ImDrawListRetainedPrimType_RectFilled,
+    ImDrawListRetainedPrimType_RectFilledMultiColor,
+    ImDrawListRetainedPrimType_Text,
+    ImDrawListRetainedPrimType_Image,
+    ImDrawListRetainedPrimType_ImageQuad,
+    ImDrawListRetainedPrimType_ShadeVertsLinearColorGradient,
+    ImDrawListRetainedPrimType_ShadeVertsLinearUV
+};
+static void ImDrawListRetainedNewFrame(ImDrawList* draw_list);
+static bool ImDrawListRetainedPrimBegin(ImDrawList* draw_list, ImU64 prim_hash);
+static void ImDrawListRetainedPrimEnd(ImDrawList* draw_list);
+static bool ImDrawListRetainedOnChangedCmdHeader(ImDrawList* draw_list);
+static void ImDrawListRetainedOnUntrackedWrite(ImDrawList* draw_list);
+
 // Initialize before use in a new frame. We always have a command ready in the buffer.
 void ImDrawList::_ResetForNewFrame()
 {
@@ -397,6 +441,10 @@ void ImDrawList::_ResetForNewFrame()
     IM_ASSERT(IM_OFFSETOF(ImDrawCmd, TextureId) == sizeof(ImVec4));
     IM_ASSERT(IM_OFFSETOF(ImDrawCmd, VtxOffset) == sizeof(ImVec4) + sizeof(ImTextureID));
 
+    // Keep last frame's output aside before clearing
+    if (_Retained != NULL)
+        ImDrawListRetainedNewFrame(this);
+
     CmdBuffer.resize(0);
     IdxBuffer.resize(0);
     VtxBuffer.resize(0);
@@ -447,6 +495,11 @@ void ImDrawList::AddDrawCmd()
     draw_cmd.IdxOffset = IdxBuffer.Size;
 
     IM_ASSERT(draw_cmd.ClipRect.x <= draw_cmd.ClipRect.z && draw_cmd.ClipRect.y <= draw_cmd.ClipRect.w);
+    if (CmdBuffer.Size == CmdBuffer.Capacity)
+    {
+        ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_DrawList);
+        CmdBuffer.reserve(CmdBuffer._grow_capacity(CmdBuffer.Size + 1));
+    }
     CmdBuffer.push_back(draw_cmd);
 }
 
@@ -463,6 +516,9 @@ void ImDrawList::_PopUnusedDrawCmd()
 
 void ImDrawList::AddCallback(ImDrawCallback callback, void* callback_data)
 {
+    if (_Retained != NULL)
+        ImDrawListRetainedOnUntrackedWrite(this);
+
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     IM_ASSERT(curr_cmd->UserCallback == NULL);
     if (curr_cmd->ElemCount != 0)
@@ -485,6 +541,10 @@ void ImDrawList::AddCallback(ImDrawCallback callback, void* callback_data)
 // The cost of figuring out if a new command has to be added or if we can merge is paid in those Update** functions only.
 void ImDrawList::_OnChangedClipRect()
 {
+    // While replaying retained geometry the commands are rebuilt later on
+    if (_Retained != NULL && ImDrawListRetainedOnChangedCmdHeader(this))
+        return;
+
     // If current command is used with different settings we need to add a new command
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     if (curr_cmd->ElemCount != 0 && memcmp(&curr_cmd->ClipRect, &_CmdHeader.ClipRect, sizeof(ImVec4)) != 0)
@@ -507,6 +567,10 @@ void ImDrawList::_OnChangedClipRect()
 
 void ImDrawList::_OnChangedTextureID()
 {
+    // While replaying retained geometry the commands are rebuilt later on
+    if (_Retained != NULL && ImDrawListRetainedOnChangedCmdHeader(this))
+        return;
+
     // If current command is used with different settings we need to add a new command
     ImDrawCmd* curr_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     if (curr_cmd->ElemCount != 0 && curr_cmd->TextureId != _CmdHeader.TextureId)
@@ -542,6 +606,169 @@ void ImDrawList::_OnChangedVtxOffset()
     curr_cmd->VtxOffset = _CmdHeader.VtxOffset;
 }
 
+// Append the commands of 'src' into 'out_cmd_buffer'/'out_idx_buffer', and its vertices at the end of dst->VtxBuffer.
+// Vertices are rebased using ImDrawCmd::VtxOffset when the backend allows it, otherwise indices are rewritten.
+// The first command may only be merged into out_cmd_buffer[merge_min_cmd_n] or later (commands before it are not the preceding output).
+static void ImDrawListAppendOutput(ImDrawList* dst, ImVector<ImDrawCmd>* out_cmd_buffer, ImVector<ImDrawIdx>* out_idx_buffer, const ImDrawList* src, const ImVec4& clip_rect, int merge_min_cmd_n)
+{
+    IM_ASSERT(src != dst);
+    const unsigned int vtx_base = (unsigned int)dst->VtxBuffer.Size;
+    const bool use_vtx_offset = (dst->Flags & ImDrawListFlags_AllowVtxOffset) != 0;
+    if (src->VtxBuffer.Size > 0)
+    {
+        dst->VtxBuffer.resize(dst->VtxBuffer.Size + src->VtxBuffer.Size);
+        memcpy(dst->VtxBuffer.Data + vtx_base, src->VtxBuffer.Data, (size_t)src->VtxBuffer.Size * sizeof(ImDrawVert));
+    }
+    if (!use_vtx_offset && sizeof(ImDrawIdx) == 2)
+        IM_ASSERT(dst->VtxBuffer.Size <= (1 << 16) && "Too many vertices in ImDrawList using 16-bit indices. Set ImGuiBackendFlags_RendererHasVtxOffset or use 32-bit indices.");
+
+    for (int cmd_n = 0; cmd_n < src->CmdBuffer.Size; cmd_n++)
+    {
+        const ImDrawCmd* src_cmd = &src->CmdBuffer.Data[cmd_n];
+        if (src_cmd->ElemCount == 0 && src_cmd->UserCallback == NULL)
+            continue;
+
+        // Clip to the destination clipping rectangle, skipping commands which are fully clipped.
+        ImDrawCmd cmd = *src_cmd;
+        cmd.ClipRect = ImVec4(ImMax(src_cmd->ClipRect.x, clip_rect.x), ImMax(src_cmd->ClipRect.y, clip_rect.y), ImMin(src_cmd->ClipRect.z, clip_rect.z), ImMin(src_cmd->ClipRect.w, clip_rect.w));
+        if (cmd.ClipRect.x >= cmd.ClipRect.z || cmd.ClipRect.y >= cmd.ClipRect.w)
+        {
+            if (cmd.UserCallback == NULL)
+                continue;
+            cmd.ClipRect.z = ImMax(cmd.ClipRect.x, cmd.ClipRect.z);
+            cmd.ClipRect.w = ImMax(cmd.ClipRect.y, cmd.ClipRect.w);
+        }
+
+        cmd.IdxOffset = (unsigned int)out_idx_buffer->Size;
+        if (cmd.ElemCount > 0)
+        {
+            out_idx_buffer->resize(out_idx_buffer->Size + (int)cmd.ElemCount);
+            const ImDrawIdx* src_idx = src->IdxBuffer.Data + src_cmd->IdxOffset;
+            ImDrawIdx* dst_idx = out_idx_buffer->Data + cmd.IdxOffset;
+            if (use_vtx_offset)
+            {
+                cmd.VtxOffset = vtx_base + src_cmd->VtxOffset;
+                memcpy(dst_idx, src_idx, (size_t)cmd.ElemCount * sizeof(ImDrawIdx));
+            }
+            else
+            {
+                const unsigned int idx_base = vtx_base + src_cmd->VtxOffset;
+                cmd.VtxOffset = 0;
+                for (unsigned int idx_n = 0; idx_n < cmd.ElemCount; idx_n++)
+                    dst_idx[idx_n] = (ImDrawIdx)(src_idx[idx_n] + idx_base);
+            }
+        }
+
+        // Merge with previous command when possible
+        ImDrawCmd* prev_cmd = out_cmd_buffer->Size > merge_min_cmd_n ? &out_cmd_buffer->back() : NULL;
+        if (prev_cmd && cmd.UserCallback == NULL && prev_cmd->UserCallback == NULL && ImDrawCmd_HeaderCompare(&cmd, prev_cmd) == 0 && prev_cmd->IdxOffset + prev_cmd->ElemCount == cmd.IdxOffset)
+            prev_cmd->ElemCount += cmd.ElemCount;
+        else
+            out_cmd_buffer->push_back(cmd);
+    }
+}
+
+// Restore the write state after vertices/indices were appended behind our back, and open a new command.
+static void ImDrawListResetWriteState(ImDrawList* draw_list)
+{
+    if (draw_list->Flags & ImDrawListFlags_AllowVtxOffset)
+    {
+        draw_list->_CmdHeader.VtxOffset = (unsigned int)draw_list->VtxBuffer.Size;
+        draw_list->_VtxCurrentIdx = 0;
+    }
+    else
+    {
+        draw_list->_VtxCurrentIdx = (unsigned int)draw_list->VtxBuffer.Size;
+    }
+    draw_list->_VtxWritePtr = draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size;
+    draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+    draw_list->AddDrawCmd();
+}
+
+// Append the output of another draw list (e.g. recorded on a worker thread) at the current position.
+// The source draw list is only read from and may be reset/reused right after the call.
+void ImDrawList::AddDrawList(const ImDrawList* draw_list)
+{
+    if (_Retained != NULL)
+        ImDrawListRetainedOnUntrackedWrite(this);
+    _PopUnusedDrawCmd();
+    ImDrawListAppendOutput(this, &CmdBuffer, &IdxBuffer, draw_list, _CmdHeader.ClipRect, 0);
+    ImDrawListResetWriteState(this);
+}
+
+// Same as AddDrawList() but only record a placeholder command: the contents are copied by _SpliceDeferredDrawLists(), called by ImGui::Render().
+// This allows another thread to keep recording into 'draw_list' while the main thread keeps submitting windows.
+void ImDrawList::AddDrawListDeferred(const ImDrawList* draw_list)
+{
+    IM_ASSERT(draw_list != this);
+    AddCallback(ImDrawCallback_SpliceDrawList, (void*)draw_list);
+}
+
+// Replace placeholders added by AddDrawListDeferred() with the contents of their draw lists.
+// Vertices are appended at the end of VtxBuffer so existing commands stay valid. Commands and indices following the first placeholder are
+// rebuilt at the end of CmdBuffer/IdxBuffer then moved over the old ones, so no temporary buffer is needed once capacity has grown.
+void ImDrawList::_SpliceDeferredDrawLists()
+{
+    int first_cmd_n = 0;
+    while (first_cmd_n < CmdBuffer.Size && CmdBuffer.Data[first_cmd_n].UserCallback != ImDrawCallback_SpliceDrawList)
+        first_cmd_n++;
+    if (first_cmd_n == CmdBuffer.Size)
+        return;
+    IM_ASSERT(_Splitter._Count <= 1 && "Cannot splice deferred draw lists while channels are split!");
+
+    const int old_cmd_count = CmdBuffer.Size;
+    const int old_idx_count = IdxBuffer.Size;
+    const int first_idx_n = (int)CmdBuffer.Data[first_cmd_n].IdxOffset;
+    for (int cmd_n = first_cmd_n; cmd_n < old_cmd_count; cmd_n++)
+    {
+        ImDrawCmd cmd = CmdBuffer.Data[cmd_n]; // Copy as CmdBuffer may be reallocated
+        if (cmd.UserCallback == ImDrawCallback_SpliceDrawList)
+        {
+            ImDrawListAppendOutput(this, &CmdBuffer, &IdxBuffer, (const ImDrawList*)cmd.UserCallbackData, cmd.ClipRect, old_cmd_count);
+            continue;
+        }
+        if (cmd.ElemCount == 0 && cmd.UserCallback == NULL)
+            continue;
+        const unsigned int src_idx_offset = cmd.IdxOffset;
+        cmd.IdxOffset = (unsigned int)IdxBuffer.Size;
+        if (cmd.ElemCount > 0)
+        {
+            IdxBuffer.resize(IdxBuffer.Size + (int)cmd.ElemCount);
+            memcpy(IdxBuffer.Data + cmd.IdxOffset, IdxBuffer.Data + src_idx_offset, (size_t)cmd.ElemCount * sizeof(ImDrawIdx));
+        }
+        CmdBuffer.push_back(cmd);
+    }
+
+    // Move new commands and indices over the old ones
+    const int new_cmd_count = CmdBuffer.Size - old_cmd_count;
+    const int new_idx_count = IdxBuffer.Size - old_idx_count;
+    memmove(CmdBuffer.Data + first_cmd_n, CmdBuffer.Data + old_cmd_count, (size_t)new_cmd_count * sizeof(ImDrawCmd));
+    if (new_idx_count > 0)
+        memmove(IdxBuffer.Data + first_idx_n, IdxBuffer.Data + old_idx_count, (size_t)new_idx_count * sizeof(ImDrawIdx));
+    CmdBuffer.resize(first_cmd_n + new_cmd_count);
+    IdxBuffer.resize(first_idx_n + new_idx_count);
+    for (int cmd_n = first_cmd_n; cmd_n < CmdBuffer.Size; cmd_n++)
+        CmdBuffer.Data[cmd_n].IdxOffset -= (unsigned int)(old_idx_count - first_idx_n);
+    ImDrawListResetWriteState(this);
+}
+
+// Hash contents that are visible to the renderer backend, used by ImGui::Render() to set ContentGeneration.
+// Commands are hashed field by field as copying ImDrawCmd by value doesn't guarantee that padding bytes are preserved.
+ImU64 ImDrawList::_CalcContentHash() const
+{
+    ImU64 hash = ImHashData64(VtxBuffer.Data, (size_t)VtxBuffer.Size * sizeof(ImDrawVert), 0);
+    hash = ImHashData64(IdxBuffer.Data, (size_t)IdxBuffer.Size * sizeof(ImDrawIdx), hash);
+    for (const ImDrawCmd* cmd = CmdBuffer.begin(); cmd != CmdBuffer.end(); cmd++)
+    {
+        hash = ImHashData64(&cmd->ClipRect, sizeof(cmd->ClipRect), hash);
+        hash = ImHashData64(&cmd->TextureId, sizeof(cmd->TextureId), hash);
+        hash = ImHashData64(&cmd->VtxOffset, sizeof(unsigned int) * 3, hash); // VtxOffset, IdxOffset, ElemCount
+        hash = ImHashData64(&cmd->UserCallback, sizeof(cmd->UserCallback), hash);
+        hash = ImHashData64(&cmd->UserCallbackData, sizeof(cmd->UserCallbackData), hash);
+    }
+    return hash;
+}
+
 int ImDrawList::_CalcCircleAutoSegmentCount(float radius) const
 {
     // Automatic segment count
@@ -603,6 +830,9 @@ void ImDrawList::PopTextureID()
 // submit the intermediate results. PrimUnreserve() can be used to release unused allocations.
 void ImDrawList::PrimReserve(int idx_count, int vtx_count)
 {
+    if (_Retained != NULL)
+        ImDrawListRetainedOnUntrackedWrite(this);
+
     // Large mesh support (when enabled)
     IM_ASSERT_PARANOID(idx_count >= 0 && vtx_count >= 0);
     if (sizeof(ImDrawIdx) == 2 && (_VtxCurrentIdx + vtx_count >= (1 << 16)) && (Flags & ImDrawListFlags_AllowVtxOffset))
@@ -617,7 +847,16 @@ void ImDrawList::PrimReserve(int idx_count, int vtx_count)
     ImDrawCmd* draw_cmd = &CmdBuffer.Data[CmdBuffer.Size - 1];
     draw_cmd->ElemCount += idx_count;
 
+    // Grow buffers ahead of resize(), so allocations are attributed to draw lists in Metrics
     int vtx_buffer_old_size = VtxBuffer.Size;
+    if (vtx_buffer_old_size + vtx_count > VtxBuffer.Capacity || IdxBuffer.Size + idx_count > IdxBuffer.Capacity)
+    {
+        ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_DrawList);
+        if (vtx_buffer_old_size + vtx_count > VtxBuffer.Capacity)
+            VtxBuffer.reserve(VtxBuffer._grow_capacity(vtx_buffer_old_size + vtx_count));
+        if (IdxBuffer.Size + idx_count > IdxBuffer.Capacity)
+            IdxBuffer.reserve(IdxBuffer._grow_capacity(IdxBuffer.Size + idx_count));
+    }
     VtxBuffer.resize(vtx_buffer_old_size + vtx_count);
     _VtxWritePtr = VtxBuffer.Data + vtx_buffer_old_size;
 
@@ -689,11 +928,52 @@ void ImDrawList::PrimQuadUV(const ImVec2& a, const ImVec2& b, const ImVec2& c, c
 
 // TODO: Thickness anti-aliased lines cap are missing their AA fringe.
 // We avoid using the ImVec2 math operators here to reduce cost to a minimum for debug/non-inlined builds.
+#ifdef IMGUI_ENABLE_SSE
+// SSE2 versions of IM_NORMALIZE2F_OVER_ZERO() and IM_FIXNORMAL2F() processing two ImVec2 (x0,y0,x1,y1) at a time.
+// We use IEEE sqrt/div (no rsqrt/rcp approximations) and evaluate in the same order, so results are bitwise identical to the scalar code.
+static inline __m128 ImSseNormalize2fOverZero(__m128 v)
+{
+    const __m128 v_sq = _mm_mul_ps(v, v);
+    const __m128 d2 = _mm_add_ps(v_sq, _mm_shuffle_ps(v_sq, v_sq, _MM_SHUFFLE(2, 3, 0, 1)));
+    const __m128 inv_len = _mm_div_ps(_mm_set1_ps(1.0f), _mm_sqrt_ps(d2));
+    const __m128 mask = _mm_cmpgt_ps(d2, _mm_setzero_ps());
+    return _mm_or_ps(_mm_and_ps(mask, _mm_mul_ps(v, inv_len)), _mm_andnot_ps(mask, v));
+}
+
+static inline __m128 ImSseFixNormal2f(__m128 v)
+{
+    const __m128 v_sq = _mm_mul_ps(v, v);
+    __m128 d2 = _mm_add_ps(v_sq, _mm_shuffle_ps(v_sq, v_sq, _MM_SHUFFLE(2, 3, 0, 1)));
+    const __m128 mask = _mm_cmplt_ps(d2, _mm_set1_ps(0.5f));
+    d2 = _mm_or_ps(_mm_and_ps(mask, _mm_set1_ps(0.5f)), _mm_andnot_ps(mask, d2));
+    return _mm_mul_ps(v, _mm_div_ps(_mm_set1_ps(1.0f), d2));
+}
+
+// Average normals n[0]+n[1] and n[1]+n[2], then fix them (see IM_FIXNORMAL2F)
+static inline __m128 ImSsePolylineAverageNormals(const ImVec2* normals)
+{
+    const __m128 n_a = _mm_loadu_ps(&normals[0].x);
+    const __m128 n_b = _mm_loadu_ps(&normals[1].x);
+    return ImSseFixNormal2f(_mm_mul_ps(_mm_add_ps(n_a, n_b), _mm_set1_ps(0.5f)));
+}
+#endif
+
 void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32 col, bool closed, float thickness)
 {
     if (points_count < 2)
         return;
 
+    if (_Retained != NULL)
+    {
+        ImDrawListRetainedHasher hasher(this, ImDrawListRetainedPrimType_Polyline);
+        hasher.AddPoints(points, points_count);
+        hasher.AddU32(col);
+        hasher.AddU32(closed ? 1 : 0);
+        hasher.AddFloat(thickness);
+        if (ImDrawListRetainedPrimBegin(this, hasher.Hash))
+            return;
+    }
+
     const ImVec2 opaque_uv = _Data->TexUvWhitePixel;
     const int count = closed ? points_count : points_count - 1; // The number of line segments we need to draw
     const bool thick_line = (thickness > _FringeScale);
@@ -727,7 +1007,18 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
         ImVec2* temp_points = temp_normals + points_count;
 
         // Calculate normals (tangents) for each line segment
-        for (int i1 = 0; i1 < count; i1++)
+        int i1 = 0;
+#ifdef IMGUI_ENABLE_SSE
+        // Two segments per iteration, the closing segment of a closed line (which wraps around) is left to the scalar loop
+        const __m128 normal_sign_mask = _mm_castsi128_ps(_mm_set_epi32((int)0x80000000, 0, (int)0x80000000, 0));
+        for (; i1 + 2 < points_count; i1 += 2)
+        {
+            __m128 d = _mm_sub_ps(_mm_loadu_ps(&points[i1 + 1].x), _mm_loadu_ps(&points[i1].x));
+            d = ImSseNormalize2fOverZero(d);
+            _mm_storeu_ps(&temp_normals[i1].x, _mm_xor_ps(_mm_shuffle_ps(d, d, _MM_SHUFFLE(2, 3, 0, 1)), normal_sign_mask)); // (dy, -dx)
+        }
+#endif
+        for (; i1 < count; i1++)
         {
             const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1;
             float dx = points[i2].x - points[i1].x;
@@ -761,14 +1052,25 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[(points_count-1)*2+1] = points[points_count-1] - temp_normals[points_count-1] * half_draw_size;
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
+            // Generate the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            // FIXME-OPT: Possibly remove the temporary buffer.
+            i1 = 0;
+#ifdef IMGUI_ENABLE_SSE
+            const __m128 half_draw_size_4 = _mm_set1_ps(half_draw_size);
+            for (; i1 + 2 < points_count; i1 += 2)
+            {
+                const __m128 dm = _mm_mul_ps(ImSsePolylineAverageNormals(&temp_normals[i1]), half_draw_size_4);
+                const __m128 p = _mm_loadu_ps(&points[i1 + 1].x);
+                const __m128 out_0 = _mm_add_ps(p, dm);
+                const __m128 out_1 = _mm_sub_ps(p, dm);
+                _mm_storeu_ps(&temp_points[(i1 + 1) * 2].x, _mm_movelh_ps(out_0, out_1));
+                _mm_storeu_ps(&temp_points[(i1 + 2) * 2].x, _mm_movehl_ps(out_1, out_0));
+            }
+#endif
+            for (; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : i1 + 1; // i2 is the second point of the line segment
-                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
 
                 // Average normals
                 float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
@@ -783,7 +1085,13 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 out_vtx[0].y = points[i2].y + dm_y;
                 out_vtx[1].x = points[i2].x - dm_x;
                 out_vtx[1].y = points[i2].y - dm_y;
+            }
 
+            // Generate the indices to form a number of triangles for each line segment
+            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
+            for (i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            {
+                const unsigned int idx2 = ((i1 + 1) == points_count) ? _VtxCurrentIdx : (idx1 + (use_texture ? 2 : 3)); // Vertex index for end of segment
                 if (use_texture)
                 {
                     // Add indices for two triangles
@@ -857,14 +1165,32 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 temp_points[points_last * 4 + 3] = points[points_last] - temp_normals[points_last] * (half_inner_thickness + AA_SIZE);
             }
 
-            // Generate the indices to form a number of triangles for each line segment, and the vertices for the line edges
+            // Generate the vertices for the line edges
             // This takes points n and n+1 and writes into n+1, with the first point in a closed line being generated from the final one (as n+1 wraps)
-            // FIXME-OPT: Merge the different loops, possibly remove the temporary buffer.
-            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
-            for (int i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            // FIXME-OPT: Possibly remove the temporary buffer.
+            i1 = 0;
+#ifdef IMGUI_ENABLE_SSE
+            const __m128 half_outer_thickness_4 = _mm_set1_ps(half_inner_thickness + AA_SIZE);
+            const __m128 half_inner_thickness_4 = _mm_set1_ps(half_inner_thickness);
+            for (; i1 + 2 < points_count; i1 += 2)
+            {
+                const __m128 dm = ImSsePolylineAverageNormals(&temp_normals[i1]);
+                const __m128 dm_out = _mm_mul_ps(dm, half_outer_thickness_4);
+                const __m128 dm_in = _mm_mul_ps(dm, half_inner_thickness_4);
+                const __m128 p = _mm_loadu_ps(&points[i1 + 1].x);
+                const __m128 out_0 = _mm_add_ps(p, dm_out);
+                const __m128 out_1 = _mm_add_ps(p, dm_in);
+                const __m128 out_2 = _mm_sub_ps(p, dm_in);
+                const __m128 out_3 = _mm_sub_ps(p, dm_out);
+                _mm_storeu_ps(&temp_points[(i1 + 1) * 4 + 0].x, _mm_movelh_ps(out_0, out_1));
+                _mm_storeu_ps(&temp_points[(i1 + 1) * 4 + 2].x, _mm_movelh_ps(out_2, out_3));
+                _mm_storeu_ps(&temp_points[(i1 + 2) * 4 + 0].x, _mm_movehl_ps(out_1, out_0));
+                _mm_storeu_ps(&temp_points[(i1 + 2) * 4 + 2].x, _mm_movehl_ps(out_3, out_2));
+            }
+#endif
+            for (; i1 < count; i1++) // i1 is the first point of the line segment
             {
                 const int i2 = (i1 + 1) == points_count ? 0 : (i1 + 1); // i2 is the second point of the line segment
-                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
 
                 // Average normals
                 float dm_x = (temp_normals[i1].x + temp_normals[i2].x) * 0.5f;
@@ -885,8 +1211,13 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
                 out_vtx[2].y = points[i2].y - dm_in_y;
                 out_vtx[3].x = points[i2].x - dm_out_x;
                 out_vtx[3].y = points[i2].y - dm_out_y;
+            }
 
-                // Add indexes
+            // Generate the indices to form a number of triangles for each line segment
+            unsigned int idx1 = _VtxCurrentIdx; // Vertex index for start of line segment
+            for (i1 = 0; i1 < count; i1++) // i1 is the first point of the line segment
+            {
+                const unsigned int idx2 = (i1 + 1) == points_count ? _VtxCurrentIdx : (idx1 + 4); // Vertex index for end of segment
                 _IdxWritePtr[0]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[1]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[2]  = (ImDrawIdx)(idx1 + 2);
                 _IdxWritePtr[3]  = (ImDrawIdx)(idx1 + 2); _IdxWritePtr[4]  = (ImDrawIdx)(idx2 + 2); _IdxWritePtr[5]  = (ImDrawIdx)(idx2 + 1);
                 _IdxWritePtr[6]  = (ImDrawIdx)(idx2 + 1); _IdxWritePtr[7]  = (ImDrawIdx)(idx1 + 1); _IdxWritePtr[8]  = (ImDrawIdx)(idx1 + 0);
@@ -941,6 +1272,9 @@ void ImDrawList::AddPolyline(const ImVec2* points, const int points_count, ImU32
             _VtxCurrentIdx += 4;
         }
     }
+
+    if (_Retained != NULL)
+        ImDrawListRetainedPrimEnd(this);
 }
 
 // We intentionally avoid using ImVec2 and its math operators here to reduce cost to a minimum for debug/non-inlined builds.
@@ -949,6 +1283,15 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
     if (points_count < 3)
         return;
 
+    if (_Retained != NULL)
+    {
+        ImDrawListRetainedHasher hasher(this, ImDrawListRetainedPrimType_ConvexPolyFilled);
+        hasher.AddPoints(points, points_count);
+        hasher.AddU32(col);
+        if (ImDrawListRetainedPrimBegin(this, hasher.Hash))
+            return;
+    }
+
     const ImVec2 uv = _Data->TexUvWhitePixel;
 
     if (Flags & ImDrawListFlags_AntiAliasedFill)
@@ -1023,6 +1366,9 @@ void ImDrawList::AddConvexPolyFilled(const ImVec2* points, const int points_coun
         }
         _VtxCurrentIdx += (ImDrawIdx)vtx_count;
     }
+
+    if (_Retained != NULL)
+        ImDrawListRetainedPrimEnd(this);
 }
 
 void ImDrawList::PathArcToFast(const ImVec2& center, float radius, int a_min_of_12, int a_max_of_12)
@@ -1219,8 +1565,19 @@ void ImDrawList::AddRectFilled(const ImVec2& p_min, const ImVec2& p_max, ImU32 c
     }
     else
     {
+        if (_Retained != NULL)
+        {
+            ImDrawListRetainedHasher hasher(this, ImDrawListRetainedPrimType_RectFilled);
+            hasher.AddPos(p_min);
+            hasher.AddPos(p_max);
+            hasher.AddU32(col);
+            if (ImDrawListRetainedPrimBegin(this, hasher.Hash))
+                return;
+        }
         PrimReserve(6, 4);
         PrimRect(p_min, p_max, col);
+        if (_Retained != NULL)
+            ImDrawListRetainedPrimEnd(this);
     }
 }
 
@@ -1230,6 +1587,19 @@ void ImDrawList::AddRectFilledMultiColor(const ImVec2& p_min, const ImVec2& p_ma
     if (((col_upr_left | col_upr_right | col_bot_right | col_bot_left) & IM_COL32_A_MASK) == 0)
         return;
 
+    if (_Retained != NULL)
+    {
+        ImDrawListRetainedHasher hasher(this, ImDrawListRetainedPrimType_RectFilledMultiColor);
+        hasher.AddPos(p_min);
+        hasher.AddPos(p_max);
+        hasher.AddU32(col_upr_left);
+        hasher.AddU32(col_upr_right);
+        hasher.AddU32(col_bot_right);
+        hasher.AddU32(col_bot_left);
+        if (ImDrawListRetainedPrimBegin(this, hasher.Hash))
+            return;
+    }
+
     const ImVec2 uv = _Data->TexUvWhitePixel;
     PrimReserve(6, 4);
     PrimWriteIdx((ImDrawIdx)(_VtxCurrentIdx)); PrimWriteIdx((ImDrawIdx)(_VtxCurrentIdx + 1)); PrimWriteIdx((ImDrawIdx)(_VtxCurrentIdx + 2));
@@ -1238,6 +1608,9 @@ void ImDrawList::AddRectFilledMultiColor(const ImVec2& p_min, const ImVec2& p_ma
     PrimWriteVtx(ImVec2(p_max.x, p_min.y), uv, col_upr_right);
     PrimWriteVtx(p_max, uv, col_bot_right);
     PrimWriteVtx(ImVec2(p_min.x, p_max.y), uv, col_bot_left);
+
+    if (_Retained != NULL)
+        ImDrawListRetainedPrimEnd(this);
 }
 
 void ImDrawList::AddQuad(const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, ImU32 col, float thickness)
@@ -1410,7 +1783,40 @@ void ImDrawList::AddText(const ImFont* font, float font_size, const ImVec2& pos,
         clip_rect.z = ImMin(clip_rect.z, cpu_fine_clip_rect->z);
         clip_rect.w = ImMin(clip_rect.w, cpu_fine_clip_rect->w);
     }
+
+    if (_Retained != NULL)
+    {
+        ImDrawListRetainedHasher hasher(this, ImDrawListRetainedPrimType_Text);
+        hasher.AddData(&font, sizeof(font));
+        hasher.AddFloat(font_size);
+        hasher.AddPos(pos);
+        hasher.AddU32(col);
+        hasher.AddData(text_begin, (size_t)(text_end - text_begin));
+        hasher.AddFloat(wrap_width);
+        hasher.AddRect(clip_rect);
+        hasher.AddU32(cpu_fine_clip_rect != NULL ? 1 : 0);
+        if (ImDrawListRetainedPrimBegin(this, hasher.Hash))
+        {
+            // Glyphs rasterized on demand are evicted when not looked up for a while: keep the ones we are still displaying
+            if (font->ContainerAtlas->GlyphCache != NULL)
+                for (const char* s = text_begin; s < text_end; )
+                {
+                    unsigned int c = (unsigned int)*s;
+                    if (c < 0x80)
+                        s += 1;
+                    else
+                        s += ImTextCharFromUtf8(&c, s, text_end);
+                    if (c != '\n' && c != '\r')
+                        font->FindGlyph((ImWchar)c);
+                }
+            return;
+        }
+    }
+
     font->RenderText(this, font_size, pos, col, clip_rect, text_begin, text_end, wrap_width, cpu_fine_clip_rect != NULL);
+
+    if (_Retained != NULL)
+        ImDrawListRetainedPrimEnd(this);
 }
 
 void ImDrawList::AddText(const ImVec2& pos, ImU32 col, const char* text_begin, const char* text_end)
@@ -1423,6 +1829,19 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, cons
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
+    if (_Retained != NULL)
+    {
+        ImDrawListRetainedHasher hasher(this, ImDrawListRetainedPrimType_Image);
+        hasher.AddData(&user_texture_id, sizeof(user_texture_id));
+        hasher.AddPos(p_min);
+        hasher.AddPos(p_max);
+        hasher.AddData(&uv_min, sizeof(ImVec2));
+        hasher.AddData(&uv_max, sizeof(ImVec2));
+        hasher.AddU32(col);
+        if (ImDrawListRetainedPrimBegin(this, hasher.Hash))
+            return;
+    }
+
     const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
     if (push_texture_id)
         PushTextureID(user_texture_id);
@@ -1432,6 +1851,9 @@ void ImDrawList::AddImage(ImTextureID user_texture_id, const ImVec2& p_min, cons
 
     if (push_texture_id)
         PopTextureID();
+
+    if (_Retained != NULL)
+        ImDrawListRetainedPrimEnd(this);
 }
 
 void ImDrawList::AddImageQuad(ImTextureID user_texture_id, const ImVec2& p1, const ImVec2& p2, const ImVec2& p3, const ImVec2& p4, const ImVec2& uv1, const ImVec2& uv2, const ImVec2& uv3, const ImVec2& uv4, ImU32 col)
@@ -1439,6 +1861,23 @@ void ImDrawList::AddImageQuad(ImTextureID user_texture_id, const ImVec2& p1, con
     if ((col & IM_COL32_A_MASK) == 0)
         return;
 
+    if (_Retained != NULL)
+    {
+        ImDrawListRetainedHasher hasher(this, ImDrawListRetainedPrimType_ImageQuad);
+        hasher.AddData(&user_texture_id, sizeof(user_texture_id));
+        hasher.AddPos(p1);
+        hasher.AddPos(p2);
+        hasher.AddPos(p3);
+        hasher.AddPos(p4);
+        hasher.AddData(&uv1, sizeof(ImVec2));
+        hasher.AddData(&uv2, sizeof(ImVec2));
+        hasher.AddData(&uv3, sizeof(ImVec2));
+        hasher.AddData(&uv4, sizeof(ImVec2));
+        hasher.AddU32(col);
+        if (ImDrawListRetainedPrimBegin(this, hasher.Hash))
+            return;
+    }
+
     const bool push_texture_id = user_texture_id != _CmdHeader.TextureId;
     if (push_texture_id)
         PushTextureID(user_texture_id);
@@ -1448,6 +1887,9 @@ void ImDrawList::AddImageQuad(ImTextureID user_texture_id, const ImVec2& p1, con
 
     if (push_texture_id)
         PopTextureID();
+
+    if (_Retained != NULL)
+        ImDrawListRetainedPrimEnd(this);
 }
 
 void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_min, const ImVec2& p_max, const ImVec2& uv_min, const ImVec2& uv_max, ImU32 col, float rounding, ImDrawCornerFlags rounding_corners)
@@ -1476,6 +1918,295 @@ void ImDrawList::AddImageRounded(ImTextureID user_texture_id, const ImVec2& p_mi
 }
 
 
+//-----------------------------------------------------------------------------
+// [SECTION] ImDrawList retained geometry
+//-----------------------------------------------------------------------------
+// See ImGuiWindowFlags_RetainGeometry and the comments above ImDrawListRetained.
+// Primitives call ImDrawListRetainedPrimBegin()/ImDrawListRetainedPrimEnd() around their output, nested primitives are not tracked.
+// Writes we can't hash (PrimReserve() outside of a primitive, callbacks, AddDrawList()) stop replaying but are hashed as a marker.
+// Splitting channels stops recording until the end of the frame, so only the contents submitted before are reused.
+//-----------------------------------------------------------------------------
+
+void ImDrawListRetained::ClearFreeMemory()
+{
+    CmdBuffer.clear();
+    IdxBuffer.clear();
+    VtxBuffer.clear();
+    Prims.clear();
+    PrimsNext.clear();
+    PrimsCount = PrimDepth = 0;
+    Active = Replaying = Recording = Recorded = PrimsValid = EndValid = false;
+    FramesCount = FramesReused = LastPrimsCount = LastPrimsReused = 0;
+}
+
+static inline ImU64 ImDrawListRetainedHashCombine(ImU64 hash, ImU64 prim_hash)
+{
+    hash = (hash ^ prim_hash) * 0x9E3779B97F4A7C15ULL;
+    return hash ^ (hash >> 32);
+}
+
+// Called by _ResetForNewFrame(): keep last frame's output aside, it becomes the source of the primitives we will skip
+static void ImDrawListRetainedNewFrame(ImDrawList* draw_list)
+{
+    ImDrawListRetained* r = draw_list->_Retained;
+    r->PrimsValid = r->Recorded;
+    r->Active = r->Replaying = r->Recording = r->Recorded = false;
+    if (!r->PrimsValid)
+        return;
+    r->CmdBuffer.swap(draw_list->CmdBuffer);
+    r->IdxBuffer.swap(draw_list->IdxBuffer);
+    r->VtxBuffer.swap(draw_list->VtxBuffer);
+    r->Prims.swap(r->PrimsNext);
+    r->PrevOrigin = r->Origin;
+}
+
+static void ImDrawListRetainedGetState(const ImDrawList* draw_list, ImU64 hash, ImDrawListRetainedPrim* out_prim)
+{
+    out_prim->Hash = hash;
+    out_prim->VtxSize = draw_list->VtxBuffer.Size;
+    out_prim->IdxSize = draw_list->IdxBuffer.Size;
+    out_prim->CmdSize = draw_list->CmdBuffer.Size;
+    out_prim->CmdIdxOffset = draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1].IdxOffset;
+    out_prim->VtxCurrentIdx = draw_list->_VtxCurrentIdx;
+}
+
+// Move the end of the vertex/index buffers to the end of a primitive. Contents are written by ImDrawListRetainedRestore().
+static void ImDrawListRetainedResizeBuffers(ImDrawList* draw_list, const ImDrawListRetainedPrim* prim)
+{
+    if (prim->VtxSize > draw_list->VtxBuffer.Capacity || prim->IdxSize > draw_list->IdxBuffer.Capacity)
+    {
+        ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_DrawList);
+        if (prim->VtxSize > draw_list->VtxBuffer.Capacity)
+            draw_list->VtxBuffer.reserve(draw_list->VtxBuffer._grow_capacity(prim->VtxSize));
+        if (prim->IdxSize > draw_list->IdxBuffer.Capacity)
+            draw_list->IdxBuffer.reserve(draw_list->IdxBuffer._grow_capacity(prim->IdxSize));
+    }
+    draw_list->VtxBuffer.resize(prim->VtxSize);
+    draw_list->IdxBuffer.resize(prim->IdxSize);
+    draw_list->_VtxCurrentIdx = prim->VtxCurrentIdx;
+}
+
+// Apply the clip rectangle/texture changes made since the last skipped primitive, the same way _OnChangedClipRect()/_OnChangedTextureID() would have.
+static void ImDrawListRetainedSyncCmdHeader(ImDrawList* draw_list)
+{
+    ImDrawCmd* curr_cmd = &draw_list->CmdBuffer.Data[draw_list->CmdBuffer.Size - 1];
+    if (curr_cmd->ElemCount != 0)
+    {
+        if (ImDrawCmd_HeaderCompare(curr_cmd, &draw_list->_CmdHeader) != 0)
+            draw_list->AddDrawCmd();
+        return;
+    }
+    ImDrawCmd_HeaderCopy(curr_cmd, &draw_list->_CmdHeader);
+    ImDrawCmd* prev_cmd = curr_cmd - 1;
+    if (draw_list->CmdBuffer.Size > 1 && ImDrawCmd_HeaderCompare(curr_cmd, prev_cmd) == 0 && prev_cmd->UserCallback == NULL)
+        draw_list->CmdBuffer.pop_back();
+}
+
+// Stop replaying: bring back last frame's output up to 'prim' (NULL: nothing was skipped), translated to the current origin.
+// With 'swap_buffers' we take last frame's buffers as-is, otherwise we copy the part we need into the current ones.
+static void ImDrawListRetainedRestore(ImDrawList* draw_list, const ImDrawListRetainedPrim* prim, bool swap_buffers)
+{
+    ImDrawListRetained* r = draw_list->_Retained;
+    IM_ASSERT(r->Replaying);
+    r->Replaying = false;
+    r->LastPrimsReused = r->PrimsCount;
+    if (swap_buffers)
+    {
+        r->PrimsNext.swap(r->Prims);
+    }
+    else
+    {
+        if (r->PrimsCount > r->PrimsNext.Capacity)
+        {
+            ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_DrawList);
+            r->PrimsNext.reserve(r->Prims.Capacity);
+        }
+        r->PrimsNext.resize(r->PrimsCount);
+        if (r->PrimsCount > 0)
+            memcpy(r->PrimsNext.Data, r->Prims.Data, (size_t)r->PrimsCount * sizeof(ImDrawListRetainedPrim));
+    }
+    if (prim == NULL)
+    {
+        ImDrawListRetainedSyncCmdHeader(draw_list);
+        return;
+    }
+
+    // Vertices, indices and commands. The last command of a primitive may have been popped (or reused by ImDrawListSplitter::Merge()) after it: it is rebuilt below.
+    ImVector<ImDrawCmd>& cmd_buffer = draw_list->CmdBuffer;
+    const int cmd_copy_count = ImMin(prim->CmdSize, r->CmdBuffer.Size);
+    if (swap_buffers)
+    {
+        cmd_buffer.swap(r->CmdBuffer);
+        draw_list->IdxBuffer.swap(r->IdxBuffer);
+        draw_list->VtxBuffer.swap(r->VtxBuffer);
+    }
+    ImDrawListRetainedResizeBuffers(draw_list, prim);
+    if (prim->CmdSize > cmd_buffer.Capacity)
+    {
+        ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_DrawList);
+        cmd_buffer.reserve(cmd_buffer._grow_capacity(prim->CmdSize));
+    }
+    if (!swap_buffers)
+    {
+        if (prim->VtxSize > 0)
+            memcpy(draw_list->VtxBuffer.Data, r->VtxBuffer.Data, (size_t)prim->VtxSize * sizeof(ImDrawVert));
+        if (prim->IdxSize > 0)
+            memcpy(draw_list->IdxBuffer.Data, r->IdxBuffer.Data, (size_t)prim->IdxSize * sizeof(ImDrawIdx));
+        if (cmd_copy_count > 0)
+            memcpy(cmd_buffer.Data, r->CmdBuffer.Data, (size_t)cmd_copy_count * sizeof(ImDrawCmd));
+    }
+    cmd_buffer.resize(prim->CmdSize);
+    if (cmd_copy_count < prim->CmdSize)
+        cmd_buffer.back() = ImDrawCmd();
+
+    // Fix commands: the last one is still open, the others may have been altered after the primitive (e.g. merged with channels)
+    ImDrawCmd* last_cmd = &cmd_buffer.back();
+    last_cmd->IdxOffset = prim->CmdIdxOffset;
+    last_cmd->ElemCount = (unsigned int)prim->IdxSize - prim->CmdIdxOffset;
+    last_cmd->UserCallback = NULL;
+    last_cmd->UserCallbackData = NULL;
+    for (ImDrawCmd* cmd = cmd_buffer.Data; cmd < last_cmd; cmd++)
+        cmd->ElemCount = cmd[1].IdxOffset - cmd->IdxOffset;
+
+    // Translate if the window moved
+    const ImVec2 delta = r->Origin - r->PrevOrigin;
+    if (delta.x != 0.0f || delta.y != 0.0f)
+    {
+        for (ImDrawVert* vtx = draw_list->VtxBuffer.Data, *vtx_end = vtx + prim->VtxSize; vtx < vtx_end; vtx++)
+            vtx->pos += delta;
+        for (ImDrawCmd* cmd = cmd_buffer.Data; cmd <= last_cmd; cmd++)
+            cmd->ClipRect = ImVec4(cmd->ClipRect.x + delta.x, cmd->ClipRect.y + delta.y, cmd->ClipRect.z + delta.x, cmd->ClipRect.w + delta.y);
+    }
+
+    // Write state
+    draw_list->_CmdHeader.VtxOffset = (unsigned int)prim->VtxSize - prim->VtxCurrentIdx;
+    draw_list->_VtxWritePtr = draw_list->VtxBuffer.Data + draw_list->VtxBuffer.Size;
+    draw_list->_IdxWritePtr = draw_list->IdxBuffer.Data + draw_list->IdxBuffer.Size;
+    ImDrawListRetainedSyncCmdHeader(draw_list);
+}
+
+static inline const ImDrawListRetainedPrim* ImDrawListRetainedGetLastSkippedPrim(const ImDrawListRetained* r)
+{
+    return r->PrimsCount > 0 ? &r->Prims.Data[r->PrimsCount - 1] : NULL;
+}
+
+// Return true when the primitive matches last frame's: the caller skips it.
+static bool ImDrawListRetainedPrimBegin(ImDrawList* draw_list, ImU64 prim_hash)
+{
+    ImDrawListRetained* r = draw_list->_Retained;
+    if (!r->Recording || r->PrimDepth++ > 0)
+        return false;
+    r->Hash = ImDrawListRetainedHashCombine(r->Hash, prim_hash);
+    if (!r->Replaying)
+        return false;
+    if (r->PrimsCount < r->Prims.Size && r->Prims.Data[r->PrimsCount].Hash == r->Hash)
+    {
+        ImDrawListRetainedResizeBuffers(draw_list, &r->Prims.Data[r->PrimsCount]);
+        r->PrimsCount++;
+        r->PrimDepth = 0;
+        return true;
+    }
+    ImDrawListRetainedRestore(draw_list, ImDrawListRetainedGetLastSkippedPrim(r), false);
+    return false;
+}
+
+static void ImDrawListRetainedPrimEnd(ImDrawList* draw_list)
+{
+    ImDrawListRetained* r = draw_list->_Retained;
+    if (!r->Recording || --r->PrimDepth > 0)
+        return;
+    if (r->PrimsNext.Size == r->PrimsNext.Capacity)
+    {
+        ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_DrawList);
+        r->PrimsNext.reserve(r->PrimsNext._grow_capacity(r->PrimsNext.Size + 1));
+    }
+    r->PrimsNext.resize(r->PrimsNext.Size + 1);
+    ImDrawListRetainedGetState(draw_list, r->Hash, &r->PrimsNext.back());
+    r->PrimsCount++;
+}
+
+// Return true when CmdBuffer[] shouldn't be updated (it is rebuilt by ImDrawListRetainedRestore())
+static bool ImDrawListRetainedOnChangedCmdHeader(ImDrawList* draw_list)
+{
+    ImDrawListRetained* r = draw_list->_Retained;
+    if (!r->Recording || r->PrimDepth > 0)
+        return false;
+    ImDrawListRetainedHasher hasher(draw_list, ImDrawListRetainedPrimType_CmdHeader);
+    hasher.AddRect(draw_list->_CmdHeader.ClipRect);
+    hasher.AddData(&draw_list->_CmdHeader.TextureId, sizeof(ImTextureID));
+    r->Hash = ImDrawListRetainedHashCombine(r->Hash, hasher.Hash);
+    return r->Replaying;
+}
+
+static void ImDrawListRetainedOnUntrackedWrite(ImDrawList* draw_list)
+{
+    ImDrawListRetained* r = draw_list->_Retained;
+    if (r->PrimDepth > 0)
+        return;
+    if (r->Replaying)
+        ImDrawListRetainedRestore(draw_list, ImDrawListRetainedGetLastSkippedPrim(r), false);
+    if (r->Recording)
+        r->Hash = ImDrawListRetainedHashCombine(r->Hash, ImDrawListRetainedPrimType_UntrackedWrite);
+}
+
+// Start recording (and replaying if last frame was recorded). Call right after _ResetForNewFrame().
+// The output of primitives also depends on shared data and on the font atlas, glyphs rasterized on demand may be evicted from one frame to another.
+void ImDrawListRetainedBegin(ImDrawList* draw_list, const ImVec2& origin)
+{
+    ImDrawListRetained* r = draw_list->_Retained;
+    IM_ASSERT(r != NULL && !r->Active);
+    IM_ASSERT(draw_list->CmdBuffer.Size == 1 && draw_list->CmdBuffer[0].ElemCount == 0 && draw_list->VtxBuffer.Size == 0);
+    r->Origin = origin;
+
+    const ImDrawListSharedData* data = draw_list->_Data;
+    ImDrawListRetainedHasher hasher(draw_list, ImDrawListRetainedPrimType_SharedData);
+    hasher.AddData(&data->TexUvWhitePixel, sizeof(ImVec2));
+    hasher.AddData(&data->TexUvLines, sizeof(data->TexUvLines));
+    hasher.AddFloat(data->CurveTessellationTol);
+    hasher.AddFloat(data->CircleSegmentMaxError);
+    if (const ImFontAtlas* atlas = data->Font ? data->Font->ContainerAtlas : NULL)
+    {
+        hasher.AddU32((ImU32)atlas->TexWidth);
+        hasher.AddU32((ImU32)atlas->TexHeight);
+        if (atlas->GlyphCache != NULL)
+            hasher.AddU32((ImU32)atlas->GlyphCache->GlyphsLoadedCount);
+    }
+    r->Hash = hasher.Hash;
+    r->PrimsCount = r->PrimDepth = 0;
+    r->PrimsNext.resize(0);
+    r->LastPrimsReused = 0;
+    r->Replaying = r->PrimsValid;
+    r->Active = r->Recording = r->Recorded = true;
+}
+
+// Finish the current frame. If all primitives matched last frame's, its buffers are swapped back in.
+void ImDrawListRetainedEnd(ImDrawList* draw_list)
+{
+    ImDrawListRetained* r = draw_list->_Retained;
+    if (!r->Active)
+        return;
+    IM_ASSERT(r->PrimDepth == 0);
+    if (r->Replaying)
+    {
+        if (r->EndValid && r->PrimsCount == r->Prims.Size && r->Hash == r->End.Hash)
+        {
+            ImDrawListRetainedPrim end = r->End;
+            ImDrawListRetainedRestore(draw_list, &end, true);
+            r->FramesReused++;
+        }
+        else
+        {
+            ImDrawListRetainedRestore(draw_list, ImDrawListRetainedGetLastSkippedPrim(r), false);
+        }
+    }
+    r->EndValid = r->Recording;
+    if (r->Recording)
+        ImDrawListRetainedGetState(draw_list, r->Hash, &r->End);
+    r->Active = r->Recording = false;
+    r->FramesCount++;
+    r->LastPrimsCount = r->PrimsCount;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawListSplitter
 //-----------------------------------------------------------------------------
@@ -1498,7 +2229,13 @@ void ImDrawListSplitter::ClearFreeMemory()
 
 void ImDrawListSplitter::Split(ImDrawList* draw_list, int channels_count)
 {
-    IM_UNUSED(draw_list);
+    // Channels are written out of order: stop recording retained geometry until the end of the frame
+    if (draw_list->_Retained != NULL)
+    {
+        ImDrawListRetainedOnUntrackedWrite(draw_list);
+        draw_list->_Retained->Recording = false;
+    }
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_DrawList);
     IM_ASSERT(_Current == 0 && _Count <= 1 && "Nested channel splitting is not supported. Please use separate instances of ImDrawListSplitter.");
     int old_channels_count = _Channels.Size;
     if (old_channels_count < channels_count)
@@ -1660,6 +2397,154 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
     }
 }
 
+// Return true if clipping geometry whose vertices are within 'bb' with 'clip_rect' is a no-op
+static inline bool ImDrawCmd_IsContainedInClipRect(const ImRect& bb, const ImVec4& clip_rect)
+{
+    return bb.Min.x >= clip_rect.x && bb.Min.y >= clip_rect.y && bb.Max.x <= clip_rect.z && bb.Max.y <= clip_rect.w;
+}
+
+// Bounding box of the vertices referenced by a command. Vertices of a command are stored contiguously so we only scan indices for the range.
+static ImRect ImDrawCmd_CalcVtxBounds(const ImDrawList* draw_list, const ImDrawCmd* cmd)
+{
+    const ImDrawIdx* idx_read = draw_list->IdxBuffer.Data + cmd->IdxOffset;
+    unsigned int idx_min = idx_read[0], idx_max = idx_read[0];
+    for (unsigned int n = 1; n < cmd->ElemCount; n++)
+    {
+        idx_min = ImMin(idx_min, (unsigned int)idx_read[n]);
+        idx_max = ImMax(idx_max, (unsigned int)idx_read[n]);
+    }
+    ImRect bb(FLT_MAX, FLT_MAX, -FLT_MAX, -FLT_MAX);
+    const ImDrawVert* vtx_read = draw_list->VtxBuffer.Data + cmd->VtxOffset;
+    for (unsigned int n = idx_min; n <= idx_max; n++)
+        bb.Add(vtx_read[n].pos);
+    return bb;
+}
+
+// Helper to write the vertices and indices of all lists contiguously into a single destination, so a renderer can upload a frame with
+// one call instead of one per list. The destination is typically mapped GPU memory: it is written once and never read back.
+// - 'vtx_dst'/'idx_dst' must hold TotalVtxCount/TotalIdxCount elements. Both may be NULL to only compute the output commands (e.g. to count draw calls).
+// - 'out_cmds' (optional) receives the ImDrawCmd of all lists in order, with VtxOffset/IdxOffset relative to the merged buffers.
+//   User callbacks are copied as is: call them with a NULL parent list. Renderers may instead iterate CmdLists[] and add the global offsets themselves.
+// - With ImDrawDataMergeFlags_RebaseIndices, the vertex offset is added to the indices themselves and every VtxOffset is 0, so the frame can be drawn
+//   from the merged buffers by a renderer not supporting ImGuiBackendFlags_RendererHasVtxOffset. With 16-bit indices this requires TotalVtxCount <= 64K.
+// - With ImDrawDataMergeFlags_MergeCmds, consecutive commands with the same texture, vertex offset and clip rectangle are output as one (ImDrawList
+//   already does this within a list, so this mostly merges the last command of a list with the first command of the next one). Merging across lists
+//   requires RebaseIndices, otherwise every list has its own VtxOffset. Empty commands are skipped.
+// - With ImDrawDataMergeFlags_MergeContainedClip as well, commands with different clip rectangles are merged when the geometry of one side doesn't
+//   touch either clip rectangle: clipping it is a no-op so the clip rectangle of the other side can be used for both. This is typically the case for
+//   contents of adjacent windows or table columns not reaching their borders. This scans the vertex positions of every command.
+// Return number of output commands.
+int ImDrawData::MergeBuffers(ImDrawVert* vtx_dst, ImDrawIdx* idx_dst, ImVector<ImDrawCmd>* out_cmds, ImDrawDataMergeFlags flags) const
+{
+    const bool rebase_indices = (flags & ImDrawDataMergeFlags_RebaseIndices) != 0;
+    const bool merge_cmds = (flags & ImDrawDataMergeFlags_MergeCmds) != 0;
+    const bool merge_contained_clip = merge_cmds && (flags & ImDrawDataMergeFlags_MergeContainedClip) != 0;
+    IM_ASSERT((vtx_dst != NULL) == (idx_dst != NULL));
+    IM_ASSERT((!rebase_indices || sizeof(ImDrawIdx) == 4 || TotalVtxCount <= (1 << 16)) && "Rebased indices would overflow ImDrawIdx. Use 32-bit indices (see imconfig.h) or support VtxOffset.");
+
+    ImDrawCmd* cmd_dst = NULL;
+    if (out_cmds != NULL)
+    {
+        int total_cmd_count = 0;
+        for (int i = 0; i < CmdListsCount; i++)
+            total_cmd_count += CmdLists[i]->CmdBuffer.Size;
+        out_cmds->resize(total_cmd_count); // Upper bound, shrunk below if commands were merged or skipped
+        cmd_dst = out_cmds->Data;
+    }
+
+    // The last output command is only written once we know it can't be merged with the next one.
+    ImDrawCmd last_cmd;
+    bool last_cmd_valid = false;
+    ImRect last_bb;                 // With MergeContainedClip: bounding box of the geometry of 'last_cmd'
+    bool last_contained = false;    // With MergeContainedClip: geometry of 'last_cmd' is within its clip rectangle
+    int out_cmd_count = 0;
+
+    unsigned int global_vtx_offset = 0;
+    unsigned int global_idx_offset = 0;
+    for (int i = 0; i < CmdListsCount; i++)
+    {
+        const ImDrawList* cmd_list = CmdLists[i];
+        if (vtx_dst != NULL && cmd_list->VtxBuffer.Size > 0)
+            memcpy(vtx_dst + global_vtx_offset, cmd_list->VtxBuffer.Data, (size_t)cmd_list->VtxBuffer.size_in_bytes());
+        if (idx_dst != NULL && !rebase_indices && cmd_list->IdxBuffer.Size > 0)
+            memcpy(idx_dst + global_idx_offset, cmd_list->IdxBuffer.Data, (size_t)cmd_list->IdxBuffer.size_in_bytes());
+        for (int cmd_i = 0; cmd_i < cmd_list->CmdBuffer.Size; cmd_i++)
+        {
+            const ImDrawCmd* cmd = &cmd_list->CmdBuffer.Data[cmd_i];
+            const unsigned int vtx_offset = global_vtx_offset + cmd->VtxOffset;
+            if (idx_dst != NULL && rebase_indices && cmd->ElemCount > 0)
+            {
+                // Commands of a list cover its index buffer contiguously, so every index gets written exactly once.
+                const ImDrawIdx* idx_read = cmd_list->IdxBuffer.Data + cmd->IdxOffset;
+                ImDrawIdx* idx_write = idx_dst + global_idx_offset + cmd->IdxOffset;
+                for (unsigned int n = 0; n < cmd->ElemCount; n++)
+                    idx_write[n] = (ImDrawIdx)(idx_read[n] + vtx_offset);
+            }
+            if (merge_cmds && cmd->ElemCount == 0 && cmd->UserCallback == NULL)
+                continue;
+
+            ImDrawCmd new_cmd = *cmd;
+            new_cmd.VtxOffset = rebase_indices ? 0 : vtx_offset;
+            new_cmd.IdxOffset = global_idx_offset + cmd->IdxOffset;
+            ImRect new_bb;
+            bool new_contained = false;
+            if (merge_contained_clip && cmd->UserCallback == NULL)
+            {
+                new_bb = ImDrawCmd_CalcVtxBounds(cmd_list, cmd);
+                new_contained = ImDrawCmd_IsContainedInClipRect(new_bb, cmd->ClipRect);
+            }
+
+            if (merge_cmds && last_cmd_valid && last_cmd.UserCallback == NULL && new_cmd.UserCallback == NULL && last_cmd.TextureId == new_cmd.TextureId
+                && last_cmd.VtxOffset == new_cmd.VtxOffset && last_cmd.IdxOffset + last_cmd.ElemCount == new_cmd.IdxOffset)
+            {
+                bool merge = false;
+                if (memcmp(&last_cmd.ClipRect, &new_cmd.ClipRect, sizeof(ImVec4)) == 0)
+                {
+                    merge = true;
+                    last_contained &= new_contained;
+                }
+                else if (merge_contained_clip && new_contained && ImDrawCmd_IsContainedInClipRect(new_bb, last_cmd.ClipRect))
+                {
+                    merge = true;   // New geometry isn't clipped by either rectangle: keep the current one
+                }
+                else if (merge_contained_clip && last_contained && ImDrawCmd_IsContainedInClipRect(last_bb, new_cmd.ClipRect))
+                {
+                    merge = true;   // Current geometry isn't clipped by either rectangle: use the new one
+                    last_cmd.ClipRect = new_cmd.ClipRect;
+                    last_contained = new_contained;
+                }
+                if (merge)
+                {
+                    last_cmd.ElemCount += new_cmd.ElemCount;
+                    if (merge_contained_clip)
+                        last_bb.Add(new_bb);
+                    continue;
+                }
+            }
+
+            if (last_cmd_valid && cmd_dst != NULL)
+                *cmd_dst++ = last_cmd;
+            if (last_cmd_valid)
+                out_cmd_count++;
+            last_cmd = new_cmd;
+            last_cmd_valid = true;
+            last_bb = new_bb;
+            last_contained = new_contained;
+        }
+        global_vtx_offset += (unsigned int)cmd_list->VtxBuffer.Size;
+        global_idx_offset += (unsigned int)cmd_list->IdxBuffer.Size;
+    }
+    if (last_cmd_valid)
+    {
+        if (cmd_dst != NULL)
+            *cmd_dst++ = last_cmd;
+        out_cmd_count++;
+    }
+    if (out_cmds != NULL)
+        out_cmds->resize(out_cmd_count);
+    return out_cmd_count;
+}
+
 //-----------------------------------------------------------------------------
 // [SECTION] Helpers ShadeVertsXXX functions
 //-----------------------------------------------------------------------------
@@ -1667,6 +2552,19 @@ void ImDrawData::ScaleClipRects(const ImVec2& fb_scale)
 // Generic linear color gradient, write to RGB fields, leave A untouched.
 void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1)
 {
+    if (draw_list->_Retained != NULL)
+    {
+        ImDrawListRetainedHasher hasher(draw_list, ImDrawListRetainedPrimType_ShadeVertsLinearColorGradient);
+        hasher.AddU32((ImU32)vert_start_idx);
+        hasher.AddU32((ImU32)vert_end_idx);
+        hasher.AddPos(gradient_p0);
+        hasher.AddPos(gradient_p1);
+        hasher.AddU32(col0);
+        hasher.AddU32(col1);
+        if (ImDrawListRetainedPrimBegin(draw_list, hasher.Hash))
+            return;
+    }
+
     ImVec2 gradient_extent = gradient_p1 - gradient_p0;
     float gradient_inv_length2 = 1.0f / ImLengthSqr(gradient_extent);
     ImDrawVert* vert_start = draw_list->VtxBuffer.Data + vert_start_idx;
@@ -1686,11 +2584,28 @@ void ImGui::ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int ve
         int b = (int)(col0_b + col_delta_b * t);
         vert->col = (r << IM_COL32_R_SHIFT) | (g << IM_COL32_G_SHIFT) | (b << IM_COL32_B_SHIFT) | (vert->col & IM_COL32_A_MASK);
     }
+
+    if (draw_list->_Retained != NULL)
+        ImDrawListRetainedPrimEnd(draw_list);
 }
 
 // Distribute UV over (a, b) rectangle
 void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp)
 {
+    if (draw_list->_Retained != NULL)
+    {
+        ImDrawListRetainedHasher hasher(draw_list, ImDrawListRetainedPrimType_ShadeVertsLinearUV);
+        hasher.AddU32((ImU32)vert_start_idx);
+        hasher.AddU32((ImU32)vert_end_idx);
+        hasher.AddPos(a);
+        hasher.AddPos(b);
+        hasher.AddData(&uv_a, sizeof(ImVec2));
+        hasher.AddData(&uv_b, sizeof(ImVec2));
+        hasher.AddU32(clamp ? 1 : 0);
+        if (ImDrawListRetainedPrimBegin(draw_list, hasher.Hash))
+            return;
+    }
+
     const ImVec2 size = b - a;
     const ImVec2 uv_size = uv_b - uv_a;
     const ImVec2 scale = ImVec2(
@@ -1711,6 +2626,9 @@ void ImGui::ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int ve
         for (ImDrawVert* vertex = vert_start; vertex < vert_end; ++vertex)
             vertex->uv = uv_a + ImMul(ImVec2(vertex->pos.x, vertex->pos.y) - a, scale);
     }
+
+    if (draw_list->_Retained != NULL)
+        ImDrawListRetainedPrimEnd(draw_list);
 }
 
 //-----------------------------------------------------------------------------
@@ -1784,6 +2702,7 @@ ImFontAtlas::ImFontAtlas()
 {
     memset(this, 0, sizeof(*this));
     TexGlyphPadding = 1;
+    TexGlyphCacheHeight = 512;
     PackIdMouseCursors = PackIdLines = -1;
 }
 
@@ -1796,6 +2715,7 @@ ImFontAtlas::~ImFontAtlas()
 void    ImFontAtlas::ClearInputData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasGlyphCacheDestroy(this);
     for (int i = 0; i < ConfigData.Size; i++)
         if (ConfigData[i].FontData && ConfigData[i].FontDataOwnedByAtlas)
         {
@@ -1818,6 +2738,8 @@ void    ImFontAtlas::ClearInputData()
 void    ImFontAtlas::ClearTexData()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasGlyphCacheDestroy(this);
+    TexDirtyRects.clear();
     if (TexPixelsAlpha8)
         IM_FREE(TexPixelsAlpha8);
     if (TexPixelsRGBA32)
@@ -1829,60 +2751,400 @@ void    ImFontAtlas::ClearTexData()
 void    ImFontAtlas::ClearFonts()
 {
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasGlyphCacheDestroy(this);
     for (int i = 0; i < Fonts.Size; i++)
         IM_DELETE(Fonts[i]);
     Fonts.clear();
 }
 
-void    ImFontAtlas::Clear()
-{
-    ClearInputData();
-    ClearTexData();
-    ClearFonts();
+void    ImFontAtlas::Clear()
+{
+    ClearInputData();
+    ClearTexData();
+    ClearFonts();
+}
+
+void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
+{
+    // Build atlas on demand
+    if (TexPixelsAlpha8 == NULL)
+    {
+        if (ConfigData.empty())
+            AddFontDefault();
+        Build();
+    }
+
+    *out_pixels = TexPixelsAlpha8;
+    if (out_width) *out_width = TexWidth;
+    if (out_height) *out_height = TexHeight;
+    if (out_bytes_per_pixel) *out_bytes_per_pixel = 1;
+}
+
+void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
+{
+    // Convert to RGBA32 format on demand
+    // Although it is likely to be the most commonly used format, our font rendering is 1 channel / 8 bpp
+    if (!TexPixelsRGBA32)
+    {
+        unsigned char* pixels = NULL;
+        GetTexDataAsAlpha8(&pixels, NULL, NULL);
+        if (pixels)
+        {
+            TexPixelsRGBA32 = (unsigned int*)IM_ALLOC((size_t)TexWidth * (size_t)TexHeight * 4);
+            const unsigned char* src = pixels;
+            unsigned int* dst = TexPixelsRGBA32;
+            for (int n = TexWidth * TexHeight; n > 0; n--)
+                *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+        }
+    }
+
+    *out_pixels = (unsigned char*)TexPixelsRGBA32;
+    if (out_width) *out_width = TexWidth;
+    if (out_height) *out_height = TexHeight;
+    if (out_bytes_per_pixel) *out_bytes_per_pixel = 4;
+}
+
+// Build cache
+// - Sections are written with ImFontAtlasBuildCacheWriter/Reader, each padded to 4 bytes.
+// - Loading runs twice over the data: first to validate it without touching the atlas, then to apply it.
+// - The header stores the input sizes (font data, glyph ranges) next to the 32-bit key, so a hash collision alone can't match different inputs.
+#define IM_FONTATLAS_BUILD_CACHE_MAGIC      0x41464D49  // "IMFA" (also rejects data written with another endianness)
+#define IM_FONTATLAS_BUILD_CACHE_VERSION    2
+
+struct ImFontAtlasBuildCacheWriter
+{
+    ImVector<unsigned char>* Buf;
+    void Write(const void* data, size_t size)
+    {
+        const int offset = Buf->Size;
+        Buf->resize(offset + (((int)size + 3) & ~3));
+        memcpy(Buf->Data + offset, data, size);
+        memset(Buf->Data + offset + size, 0, (size_t)(Buf->Size - offset) - size);
+    }
+    void WriteInt(int v)        { Write(&v, sizeof(v)); }
+    void WriteFloat(float v)    { Write(&v, sizeof(v)); }
+};
+
+struct ImFontAtlasBuildCacheReader
+{
+    const unsigned char* P;
+    const unsigned char* End;
+    const void* Read(size_t size)   // Return NULL if out of data
+    {
+        const size_t size_padded = (size + 3) & ~(size_t)3;
+        if ((size_t)(End - P) < size_padded)
+            return NULL;
+        const void* data = P;
+        P += size_padded;
+        return data;
+    }
+    bool ReadInt(int* out)          { const void* p = Read(sizeof(*out)); if (p) memcpy(out, p, sizeof(*out)); return p != NULL; }
+    bool ReadFloat(float* out)      { const void* p = Read(sizeof(*out)); if (p) memcpy(out, p, sizeof(*out)); return p != NULL; }
+};
+
+static int ImFontAtlasBuildCacheFindFontIndex(const ImFontAtlas* atlas, const ImFont* font)
+{
+    for (int n = 0; n < atlas->Fonts.Size; n++)
+        if (atlas->Fonts[n] == font)
+            return n;
+    return -1;
+}
+
+static int ImFontAtlasBuildCacheCountRanges(const ImWchar* ranges)
+{
+    int ranges_count = 0;
+    if (ranges)
+        while (ranges[ranges_count] != 0)
+            ranges_count++;
+    return ranges_count;
+}
+
+ImU32 ImFontAtlas::GetBuildCacheKey() const
+{
+    ImU32 key = 0;
+    const int header[] = { IM_FONTATLAS_BUILD_CACHE_VERSION, IMGUI_VERSION_NUM, (int)sizeof(ImWchar), (int)sizeof(ImFontGlyph), IM_DRAWLIST_TEX_LINES_WIDTH_MAX, FontBuilderIO != NULL,
+#ifdef IMGUI_ENABLE_FREETYPE
+        1,
+#else
+        0,
+#endif
+        (int)Flags, TexDesiredWidth, TexGlyphPadding, (int)FontBuilderFlags, Fonts.Size, ConfigData.Size };
+    key = ImHashData(header, sizeof(header), key);
+
+    // Hash fields one by one: ImFontConfig has padding and pointers
+    for (int n = 0; n < ConfigData.Size; n++)
+    {
+        const ImFontConfig& cfg = ConfigData[n];
+        const int cfg_ints[] = { cfg.FontDataSize, cfg.FontNo, cfg.OversampleH, cfg.OversampleV, cfg.PixelSnapH, cfg.MergeMode, (int)cfg.FontBuilderFlags, (int)cfg.EllipsisChar, ImFontAtlasBuildCacheFindFontIndex(this, cfg.DstFont) };
+        const float cfg_floats[] = { cfg.SizePixels, cfg.GlyphExtraSpacing.x, cfg.GlyphExtraSpacing.y, cfg.GlyphOffset.x, cfg.GlyphOffset.y, cfg.GlyphMinAdvanceX, cfg.GlyphMaxAdvanceX, cfg.RasterizerMultiply };
+        key = ImHashData(cfg_ints, sizeof(cfg_ints), key);
+        key = ImHashData(cfg_floats, sizeof(cfg_floats), key);
+        key = ImHashData(cfg.FontData, (size_t)cfg.FontDataSize, key);
+        if (cfg.GlyphRanges)
+            key = ImHashData(cfg.GlyphRanges, ImFontAtlasBuildCacheCountRanges(cfg.GlyphRanges) * sizeof(ImWchar), key);
+    }
+
+    // Hash user rectangles (skipping the ones added by the builder itself, which only exist after building)
+    for (int n = 0; n < CustomRects.Size; n++)
+    {
+        if (n == PackIdMouseCursors || n == PackIdLines)
+            continue;
+        const ImFontAtlasCustomRect& r = CustomRects[n];
+        const int rect_ints[] = { r.Width, r.Height, (int)r.GlyphID, ImFontAtlasBuildCacheFindFontIndex(this, r.Font) };
+        const float rect_floats[] = { r.GlyphAdvanceX, r.GlyphOffset.x, r.GlyphOffset.y };
+        key = ImHashData(rect_ints, sizeof(rect_ints), key);
+        key = ImHashData(rect_floats, sizeof(rect_floats), key);
+    }
+    return key;
+}
+
+bool ImFontAtlas::SaveBuildCacheToMemory(ImVector<unsigned char>* out_data) const
+{
+    IM_ASSERT(out_data != NULL);
+    out_data->resize(0);
+    if (TexPixelsAlpha8 == NULL || Fonts.Size == 0 || (Flags & ImFontAtlasFlags_DynamicGlyphs))
+        return false;
+
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Font);
+    ImFontAtlasBuildCacheWriter w;
+    w.Buf = out_data;
+    w.WriteInt(IM_FONTATLAS_BUILD_CACHE_MAGIC);
+    w.WriteInt((int)GetBuildCacheKey());
+    w.WriteInt(0); // Total size, patched below
+    w.WriteInt(ConfigData.Size);
+    for (int n = 0; n < ConfigData.Size; n++)
+    {
+        w.WriteInt(ConfigData[n].FontDataSize);
+        w.WriteInt(ImFontAtlasBuildCacheCountRanges(ConfigData[n].GlyphRanges));
+    }
+
+    // Atlas
+    w.WriteInt(TexWidth);
+    w.WriteInt(TexHeight);
+    w.WriteInt(TexPixelsRGBA32 != NULL);
+    w.WriteInt(PackIdMouseCursors);
+    w.WriteInt(PackIdLines);
+    w.WriteInt(Fonts.Size);
+    w.WriteInt(CustomRects.Size);
+    w.Write(&TexUvScale, sizeof(TexUvScale));
+    w.Write(&TexUvWhitePixel, sizeof(TexUvWhitePixel));
+    w.Write(TexUvLines, sizeof(TexUvLines));
+    for (int n = 0; n < CustomRects.Size; n++)
+    {
+        const ImFontAtlasCustomRect& r = CustomRects[n];
+        const int rect_ints[] = { r.Width, r.Height, r.X, r.Y, (int)r.GlyphID, ImFontAtlasBuildCacheFindFontIndex(this, r.Font) };
+        const float rect_floats[] = { r.GlyphAdvanceX, r.GlyphOffset.x, r.GlyphOffset.y };
+        w.Write(rect_ints, sizeof(rect_ints));
+        w.Write(rect_floats, sizeof(rect_floats));
+    }
+
+    // Fonts
+    for (int font_n = 0; font_n < Fonts.Size; font_n++)
+    {
+        const ImFont* font = Fonts[font_n];
+        IM_ASSERT(!font->DirtyLookupTables);
+        w.WriteFloat(font->FontSize);
+        w.WriteFloat(font->Ascent);
+        w.WriteFloat(font->Descent);
+        w.WriteFloat(font->FallbackAdvanceX);
+        w.WriteInt(font->MetricsTotalSurface);
+        w.WriteInt(font->ConfigData ? (int)(font->ConfigData - ConfigData.Data) : -1);
+        w.WriteInt(font->ConfigDataCount);
+        w.WriteInt((int)font->FallbackChar);
+        w.WriteInt((int)font->EllipsisChar);
+        w.WriteInt(font->FallbackGlyph ? (int)(font->FallbackGlyph - font->Glyphs.Data) : -1);
+        w.WriteInt(font->Glyphs.Size);
+        w.WriteInt(font->IndexLookup.Size);
+        w.Write(font->Used4kPagesMap, sizeof(font->Used4kPagesMap));
+        w.Write(font->Glyphs.Data, (size_t)font->Glyphs.size_in_bytes());
+        w.Write(font->IndexAdvanceX.Data, (size_t)font->IndexAdvanceX.size_in_bytes());
+        w.Write(font->IndexLookup.Data, (size_t)font->IndexLookup.size_in_bytes());
+    }
+
+    // Texture
+    w.Write(TexPixelsAlpha8, (size_t)TexWidth * TexHeight);
+    if (TexPixelsRGBA32)
+        w.Write(TexPixelsRGBA32, (size_t)TexWidth * TexHeight * 4);
+
+    const int total_size = out_data->Size;
+    memcpy(out_data->Data + sizeof(int) * 2, &total_size, sizeof(total_size));
+    return true;
 }
 
-void    ImFontAtlas::GetTexDataAsAlpha8(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
+// Validate data without modifying the atlas if 'apply' is false.
+static bool ImFontAtlasBuildCacheLoad(ImFontAtlas* atlas, const void* data, size_t data_size, bool apply)
 {
-    // Build atlas on demand
-    if (TexPixelsAlpha8 == NULL)
+    ImFontAtlasBuildCacheReader r;
+    r.P = (const unsigned char*)data;
+    r.End = r.P + data_size;
+
+    int magic = 0, key = 0, total_size = 0;
+    if (!r.ReadInt(&magic) || !r.ReadInt(&key) || !r.ReadInt(&total_size))
+        return false;
+    if (magic != IM_FONTATLAS_BUILD_CACHE_MAGIC || (ImU32)key != atlas->GetBuildCacheKey() || (size_t)total_size != data_size)
+        return false;
+    int config_data_size = 0;
+    if (!r.ReadInt(&config_data_size) || config_data_size != atlas->ConfigData.Size)
+        return false;
+    for (int n = 0; n < config_data_size; n++)
     {
-        if (ConfigData.empty())
-            AddFontDefault();
-        Build();
+        int font_data_size = 0, ranges_count = 0;
+        if (!r.ReadInt(&font_data_size) || !r.ReadInt(&ranges_count))
+            return false;
+        if (font_data_size != atlas->ConfigData[n].FontDataSize || ranges_count != ImFontAtlasBuildCacheCountRanges(atlas->ConfigData[n].GlyphRanges))
+            return false;
     }
 
-    *out_pixels = TexPixelsAlpha8;
-    if (out_width) *out_width = TexWidth;
-    if (out_height) *out_height = TexHeight;
-    if (out_bytes_per_pixel) *out_bytes_per_pixel = 1;
-}
+    // Atlas
+    int tex_width = 0, tex_height = 0, has_rgba32 = 0, pack_id_mouse_cursors = -1, pack_id_lines = -1, fonts_count = 0, rects_count = 0;
+    if (!r.ReadInt(&tex_width) || !r.ReadInt(&tex_height) || !r.ReadInt(&has_rgba32) || !r.ReadInt(&pack_id_mouse_cursors) || !r.ReadInt(&pack_id_lines) || !r.ReadInt(&fonts_count) || !r.ReadInt(&rects_count))
+        return false;
+    if (tex_width <= 0 || tex_height <= 0 || tex_width > 0x8000 || tex_height > 0x8000 || fonts_count != atlas->Fonts.Size || rects_count < 0 || pack_id_mouse_cursors < -1 || pack_id_mouse_cursors >= rects_count || pack_id_lines < -1 || pack_id_lines >= rects_count)
+        return false;
+    const void* tex_uv_scale = r.Read(sizeof(atlas->TexUvScale));
+    const void* tex_uv_white_pixel = r.Read(sizeof(atlas->TexUvWhitePixel));
+    const void* tex_uv_lines = r.Read(sizeof(atlas->TexUvLines));
+    if (!tex_uv_scale || !tex_uv_white_pixel || !tex_uv_lines)
+        return false;
+    if (apply)
+    {
+        atlas->ClearTexData();
+        atlas->TexWidth = tex_width;
+        atlas->TexHeight = tex_height;
+        atlas->PackIdMouseCursors = pack_id_mouse_cursors;
+        atlas->PackIdLines = pack_id_lines;
+        memcpy(&atlas->TexUvScale, tex_uv_scale, sizeof(atlas->TexUvScale));
+        memcpy(&atlas->TexUvWhitePixel, tex_uv_white_pixel, sizeof(atlas->TexUvWhitePixel));
+        memcpy(atlas->TexUvLines, tex_uv_lines, sizeof(atlas->TexUvLines));
+        atlas->CustomRects.resize(rects_count);
+    }
+    for (int n = 0; n < rects_count; n++)
+    {
+        const int* rect_ints = (const int*)r.Read(sizeof(int) * 6);
+        const float* rect_floats = (const float*)r.Read(sizeof(float) * 3);
+        if (!rect_ints || !rect_floats || rect_ints[5] < -1 || rect_ints[5] >= fonts_count)
+            return false;
+        if (!apply)
+            continue;
+        ImFontAtlasCustomRect& rect = atlas->CustomRects[n];
+        rect.Width = (unsigned short)rect_ints[0];
+        rect.Height = (unsigned short)rect_ints[1];
+        rect.X = (unsigned short)rect_ints[2];
+        rect.Y = (unsigned short)rect_ints[3];
+        rect.GlyphID = (unsigned int)rect_ints[4];
+        rect.Font = (rect_ints[5] >= 0) ? atlas->Fonts[rect_ints[5]] : NULL;
+        rect.GlyphAdvanceX = rect_floats[0];
+        rect.GlyphOffset = ImVec2(rect_floats[1], rect_floats[2]);
+    }
 
-void    ImFontAtlas::GetTexDataAsRGBA32(unsigned char** out_pixels, int* out_width, int* out_height, int* out_bytes_per_pixel)
-{
-    // Convert to RGBA32 format on demand
-    // Although it is likely to be the most commonly used format, our font rendering is 1 channel / 8 bpp
-    if (!TexPixelsRGBA32)
+    // Fonts
+    for (int font_n = 0; font_n < fonts_count; font_n++)
     {
-        unsigned char* pixels = NULL;
-        GetTexDataAsAlpha8(&pixels, NULL, NULL);
-        if (pixels)
+        float font_size, ascent, descent, fallback_advance_x;
+        int metrics_total_surface, config_data_index, config_data_count, fallback_char, ellipsis_char, fallback_glyph_index, glyphs_count, index_count;
+        if (!r.ReadFloat(&font_size) || !r.ReadFloat(&ascent) || !r.ReadFloat(&descent) || !r.ReadFloat(&fallback_advance_x))
+            return false;
+        if (!r.ReadInt(&metrics_total_surface) || !r.ReadInt(&config_data_index) || !r.ReadInt(&config_data_count) || !r.ReadInt(&fallback_char) || !r.ReadInt(&ellipsis_char) || !r.ReadInt(&fallback_glyph_index) || !r.ReadInt(&glyphs_count) || !r.ReadInt(&index_count))
+            return false;
+        if (config_data_index < -1 || config_data_index >= atlas->ConfigData.Size || config_data_count < 0 || config_data_count > (config_data_index >= 0 ? atlas->ConfigData.Size - config_data_index : 0) || glyphs_count < 0 || glyphs_count >= (int)IM_FONTGLYPH_INDEX_QUEUED || fallback_glyph_index < -1 || fallback_glyph_index >= glyphs_count || index_count < 0 || index_count > IM_UNICODE_CODEPOINT_MAX + 1)
+            return false;
+        const void* used_4k_pages_map = r.Read(sizeof(ImFont::Used4kPagesMap));
+        const void* glyphs = r.Read(glyphs_count * sizeof(ImFontGlyph));
+        const void* index_advance_x = r.Read(index_count * sizeof(float));
+        const ImWchar* index_lookup = (const ImWchar*)r.Read(index_count * sizeof(ImWchar));
+        if (!used_4k_pages_map || !glyphs || !index_advance_x || !index_lookup)
+            return false;
+        for (int n = 0; n < index_count; n++)
+            if (index_lookup[n] != (ImWchar)-1 && (int)index_lookup[n] >= glyphs_count)
+                return false;
+        if (!apply)
+            continue;
+        ImFont* font = atlas->Fonts[font_n];
+        font->ClearOutputData();
+        font->FontSize = font_size;
+        font->Ascent = ascent;
+        font->Descent = descent;
+        font->FallbackAdvanceX = fallback_advance_x;
+        font->MetricsTotalSurface = metrics_total_surface;
+        font->ContainerAtlas = atlas;
+        font->ConfigData = (config_data_index >= 0) ? &atlas->ConfigData[config_data_index] : NULL;
+        font->ConfigDataCount = (short)config_data_count;
+        font->FallbackChar = (ImWchar)fallback_char;
+        font->EllipsisChar = (ImWchar)ellipsis_char;
+        memcpy(font->Used4kPagesMap, used_4k_pages_map, sizeof(font->Used4kPagesMap));
+        font->Glyphs.resize(glyphs_count);
+        font->IndexAdvanceX.resize(index_count);
+        font->IndexLookup.resize(index_count);
+        memcpy(font->Glyphs.Data, glyphs, (size_t)font->Glyphs.size_in_bytes());
+        memcpy(font->IndexAdvanceX.Data, index_advance_x, (size_t)font->IndexAdvanceX.size_in_bytes());
+        memcpy(font->IndexLookup.Data, index_lookup, (size_t)font->IndexLookup.size_in_bytes());
+        font->FallbackGlyph = (fallback_glyph_index >= 0) ? &font->Glyphs[fallback_glyph_index] : NULL;
+        font->DirtyLookupTables = false;
+    }
+
+    // Texture (compute sizes in 64-bit: up to 0x8000*0x8000*4 bytes would overflow a 32-bit size_t)
+    const ImU64 tex_pixels_count_64 = (ImU64)tex_width * (ImU64)tex_height;
+    if (tex_pixels_count_64 * (has_rgba32 ? 5 : 1) > (ImU64)(r.End - r.P))
+        return false;
+    const size_t tex_pixels_count = (size_t)tex_pixels_count_64;
+    const void* pixels_alpha8 = r.Read(tex_pixels_count);
+    const void* pixels_rgba32 = has_rgba32 ? r.Read(tex_pixels_count * 4) : NULL;
+    if (pixels_alpha8 == NULL || (has_rgba32 && pixels_rgba32 == NULL) || r.P != r.End)
+        return false;
+    if (apply)
+    {
+        atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(tex_pixels_count);
+        memcpy(atlas->TexPixelsAlpha8, pixels_alpha8, tex_pixels_count);
+        if (pixels_rgba32)
         {
-            TexPixelsRGBA32 = (unsigned int*)IM_ALLOC((size_t)TexWidth * (size_t)TexHeight * 4);
-            const unsigned char* src = pixels;
-            unsigned int* dst = TexPixelsRGBA32;
-            for (int n = TexWidth * TexHeight; n > 0; n--)
-                *dst++ = IM_COL32(255, 255, 255, (unsigned int)(*src++));
+            atlas->TexPixelsRGBA32 = (unsigned int*)IM_ALLOC(tex_pixels_count * 4);
+            memcpy(atlas->TexPixelsRGBA32, pixels_rgba32, tex_pixels_count * 4);
         }
     }
+    return true;
+}
 
-    *out_pixels = (unsigned char*)TexPixelsRGBA32;
-    if (out_width) *out_width = TexWidth;
-    if (out_height) *out_height = TexHeight;
-    if (out_bytes_per_pixel) *out_bytes_per_pixel = 4;
+bool ImFontAtlas::LoadBuildCacheFromMemory(const void* data, size_t data_size)
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    IM_ASSERT(((size_t)data & 3) == 0 && "Build cache data needs to be 4-byte aligned!");
+    if (data == NULL || ConfigData.Size == 0 || (Flags & ImFontAtlasFlags_DynamicGlyphs))
+        return false;
+    if (!ImFontAtlasBuildCacheLoad(this, data, data_size, false))
+        return false;
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Font);
+    TexID = (ImTextureID)NULL;
+    ImFontAtlasBuildCacheLoad(this, data, data_size, true);
+    return true;
+}
+
+bool ImFontAtlas::SaveBuildCacheToDisk(const char* filename) const
+{
+    ImVector<unsigned char> data;
+    if (!SaveBuildCacheToMemory(&data))
+        return false;
+    ImFileHandle f = ImFileOpen(filename, "wb");
+    if (!f)
+        return false;
+    const bool ret = ImFileWrite(data.Data, 1, (ImU64)data.Size, f) == (ImU64)data.Size;
+    ImFileClose(f);
+    return ret;
+}
+
+bool ImFontAtlas::LoadBuildCacheFromDisk(const char* filename)
+{
+    size_t data_size = 0;
+    void* data = ImFileLoadToMemory(filename, "rb", &data_size);
+    if (!data)
+        return false;
+    const bool ret = LoadBuildCacheFromMemory(data, data_size);
+    IM_FREE(data);
+    return ret;
 }
 
 ImFont* ImFontAtlas::AddFont(const ImFontConfig* font_cfg)
 {
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Font);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
     IM_ASSERT(font_cfg->FontData != NULL && font_cfg->FontDataSize > 0);
     IM_ASSERT(font_cfg->SizePixels > 0.0f);
@@ -1987,6 +3249,7 @@ ImFont* ImFontAtlas::AddFontFromMemoryTTF(void* ttf_data, int ttf_size, float si
 
 ImFont* ImFontAtlas::AddFontFromMemoryCompressedTTF(const void* compressed_ttf_data, int compressed_ttf_size, float size_pixels, const ImFontConfig* font_cfg_template, const ImWchar* glyph_ranges)
 {
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Font);
     const unsigned int buf_decompressed_size = stb_decompress_length((const unsigned char*)compressed_ttf_data);
     unsigned char* buf_decompressed_data = (unsigned char*)IM_ALLOC(buf_decompressed_size);
     stb_decompress(buf_decompressed_data, (const unsigned char*)compressed_ttf_data, (unsigned int)compressed_ttf_size);
@@ -2068,6 +3331,7 @@ bool ImFontAtlas::GetMouseCursorTexData(ImGuiMouseCursor cursor_type, ImVec2* ou
 
 bool    ImFontAtlas::Build()
 {
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Font);
     IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
 
     // Select builder
@@ -2134,6 +3398,25 @@ struct ImFontBuildDstData
     ImBitVector         GlyphsSet;          // This is used to resolve collision when multiple sources are merged into a same destination font.
 };
 
+// Glyphs of one source font rasterized by one job of ImFontAtlasBuildRasterJob()
+#define IM_FONTBUILD_RASTER_JOB_GLYPHS  128
+
+struct ImFontBuildRasterJob
+{
+    int                 SrcIndex;           // Index into src_tmp_array[]
+    int                 GlyphStart;         // First glyph (index into GlyphsList[], Rects[], PackedChars[])
+    int                 GlyphCount;
+};
+
+// Shared by all jobs, read-only while jobs are running
+struct ImFontBuildRasterJobsData
+{
+    ImFontAtlas*                Atlas;
+    const stbtt_pack_context*   PackContext;
+    ImFontBuildSrcData*         Sources;
+    const ImFontBuildRasterJob* Jobs;
+};
+
 static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>* out)
 {
     IM_ASSERT(sizeof(in->Storage.Data[0]) == sizeof(int));
@@ -2146,9 +3429,40 @@ static void UnpackBitVectorToFlatIndexList(const ImBitVector* in, ImVector<int>*
                     out->push_back((int)(((it - it_begin) << 5) + bit_n));
 }
 
+// Rasterize a range of glyphs from one source font into their packed rectangles.
+// (stbtt_PackFontRangesRenderIntoRects() modifies the oversampling fields of the pack context, so each job uses its own copy)
+static void ImFontAtlasBuildRasterJob(void* job_data, int job_index)
+{
+    ImFontBuildRasterJobsData* data = (ImFontBuildRasterJobsData*)job_data;
+    const ImFontBuildRasterJob& job = data->Jobs[job_index];
+    ImFontAtlas* atlas = data->Atlas;
+    ImFontConfig& cfg = atlas->ConfigData[job.SrcIndex];
+    ImFontBuildSrcData& src_tmp = data->Sources[job.SrcIndex];
+
+    stbtt_pack_context spc = *data->PackContext;
+    stbtt_pack_range pack_range = src_tmp.PackRange;
+    pack_range.array_of_unicode_codepoints += job.GlyphStart;
+    pack_range.num_chars = job.GlyphCount;
+    pack_range.chardata_for_range += job.GlyphStart;
+    stbrp_rect* rects = src_tmp.Rects + job.GlyphStart;
+    stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &pack_range, 1, rects);
+
+    // Apply multiply operator
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        stbrp_rect* r = rects;
+        for (int glyph_i = 0; glyph_i < job.GlyphCount; glyph_i++, r++)
+            if (r->was_packed)
+                ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+    }
+}
+
 static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
 {
     IM_ASSERT(atlas->ConfigData.Size > 0);
+    const bool dynamic_glyphs = (atlas->Flags & ImFontAtlasFlags_DynamicGlyphs) != 0;
 
     ImFontAtlasBuildInit(atlas);
 
@@ -2210,7 +3524,10 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
             dst_tmp.GlyphsSet.Create(dst_tmp.GlyphsHighest + 1);
 
         for (const ImWchar* src_range = src_tmp.SrcRanges; src_range[0] && src_range[1]; src_range += 2)
-            for (unsigned int codepoint = src_range[0]; codepoint <= src_range[1]; codepoint++)
+        {
+            // With ImFontAtlasFlags_DynamicGlyphs, higher codepoints are rasterized on demand (see ImFontAtlasGlyphCacheUpdateFontLookup)
+            const unsigned int codepoint_last = dynamic_glyphs ? ImMin((unsigned int)src_range[1], (unsigned int)IM_FONTGLYPH_CACHE_PRELOAD_MAX) : (unsigned int)src_range[1];
+            for (unsigned int codepoint = src_range[0]; codepoint <= codepoint_last; codepoint++)
             {
                 if (dst_tmp.GlyphsSet.TestBit(codepoint))    // Don't overwrite existing glyphs. We could make this an option for MergeMode (e.g. MergeOverwrite==true)
                     continue;
@@ -2224,6 +3541,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
                 dst_tmp.GlyphsSet.SetBit(codepoint);
                 total_glyphs_count++;
             }
+        }
     }
 
     // 3. Unpack our bit map into a flat list (we now have all the Unicode points that we know are requested _and_ available _and_ not overlapping another)
@@ -2297,6 +3615,8 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         atlas->TexWidth = atlas->TexDesiredWidth;
     else
         atlas->TexWidth = (surface_sqrt >= 4096 * 0.7f) ? 4096 : (surface_sqrt >= 2048 * 0.7f) ? 2048 : (surface_sqrt >= 1024 * 0.7f) ? 1024 : 512;
+    if (dynamic_glyphs && atlas->TexDesiredWidth <= 0)
+        atlas->TexWidth = ImMax(atlas->TexWidth, 1024); // Leave room for glyphs rasterized on demand
 
     // 5. Start packing
     // Pack our extra data rectangles first, so it will be on the upper-left corner of our texture (UV will have small values).
@@ -2322,6 +3642,10 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     }
 
     // 7. Allocate texture
+    // With ImFontAtlasFlags_DynamicGlyphs, reserve rows below the packed data for glyphs rasterized on demand (the cache also uses rows added by rounding up)
+    const int glyph_cache_y0 = atlas->TexHeight + atlas->TexGlyphPadding;
+    if (dynamic_glyphs)
+        atlas->TexHeight = glyph_cache_y0 + ImMax(atlas->TexGlyphCacheHeight, 0);
     atlas->TexHeight = (atlas->Flags & ImFontAtlasFlags_NoPowerOfTwoHeight) ? (atlas->TexHeight + 1) : ImUpperPowerOfTwo(atlas->TexHeight);
     atlas->TexUvScale = ImVec2(1.0f / atlas->TexWidth, 1.0f / atlas->TexHeight);
     atlas->TexPixelsAlpha8 = (unsigned char*)IM_ALLOC(atlas->TexWidth * atlas->TexHeight);
@@ -2330,27 +3654,41 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     spc.height = atlas->TexHeight;
 
     // 8. Render/rasterize font characters into the texture
+    // Glyphs are split into jobs which may run in parallel with BuildParallelForFunc. Each job writes into its own packed rectangles,
+    // so the output doesn't depend on scheduling.
+    ImVector<ImFontBuildRasterJob> jobs;
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
-        ImFontConfig& cfg = atlas->ConfigData[src_i];
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
-            continue;
-
-        stbtt_PackFontRangesRenderIntoRects(&spc, &src_tmp.FontInfo, &src_tmp.PackRange, 1, src_tmp.Rects);
-
-        // Apply multiply operator
-        if (cfg.RasterizerMultiply != 1.0f)
+        for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i += IM_FONTBUILD_RASTER_JOB_GLYPHS)
         {
-            unsigned char multiply_table[256];
-            ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
-            stbrp_rect* r = &src_tmp.Rects[0];
-            for (int glyph_i = 0; glyph_i < src_tmp.GlyphsCount; glyph_i++, r++)
-                if (r->was_packed)
-                    ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r->x, r->y, r->w, r->h, atlas->TexWidth * 1);
+            ImFontBuildRasterJob job;
+            job.SrcIndex = src_i;
+            job.GlyphStart = glyph_i;
+            job.GlyphCount = ImMin(src_tmp.GlyphsCount - glyph_i, IM_FONTBUILD_RASTER_JOB_GLYPHS);
+            jobs.push_back(job);
         }
-        src_tmp.Rects = NULL;
     }
+    ImFontBuildRasterJobsData jobs_data;
+    jobs_data.Atlas = atlas;
+    jobs_data.PackContext = &spc;
+    jobs_data.Sources = src_tmp_array.Data;
+    jobs_data.Jobs = jobs.Data;
+    if (atlas->BuildParallelForFunc != NULL && jobs.Size > 1)
+    {
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+            src_tmp_array[src_i].FontInfo.userdata = atlas; // Allocate outside of ImGui::MemAlloc(), see ImFontAtlasBuildStbttAlloc()
+        atlas->BuildParallelForFunc(ImFontAtlasBuildRasterJob, &jobs_data, jobs.Size, atlas->BuildParallelForUserData);
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+            src_tmp_array[src_i].FontInfo.userdata = NULL;
+    }
+    else
+    {
+        for (int job_i = 0; job_i < jobs.Size; job_i++)
+            ImFontAtlasBuildRasterJob(&jobs_data, job_i);
+    }
+    for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        src_tmp_array[src_i].Rects = NULL;
 
     // End packing
     stbtt_PackEnd(&spc);
@@ -2360,7 +3698,7 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
     {
         ImFontBuildSrcData& src_tmp = src_tmp_array[src_i];
-        if (src_tmp.GlyphsCount == 0)
+        if (src_tmp.GlyphsCount == 0 && !dynamic_glyphs)
             continue;
 
         // When merging fonts with MergeMode=true:
@@ -2391,6 +3729,24 @@ static bool ImFontAtlasBuildWithStbTruetype(ImFontAtlas* atlas)
         }
     }
 
+    // 10. Keep font sources around to rasterize other glyphs on demand.
+    // ImFontAtlasBuildFinish() -> ImFont::BuildLookupTable() will mark them as available.
+    if (dynamic_glyphs)
+    {
+        ImFontAtlasGlyphCache* cache = IM_NEW(ImFontAtlasGlyphCache)();
+        cache->AreaY0 = cache->ShelvesY = glyph_cache_y0;
+        cache->AreaY1 = atlas->TexHeight;
+        cache->Sources.resize(src_tmp_array.Size);
+        for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
+        {
+            ImFontAtlasGlyphCacheSrc& src = cache->Sources[src_i];
+            src.Config = &atlas->ConfigData[src_i];
+            src.FontInfo = IM_ALLOC(sizeof(stbtt_fontinfo));
+            memcpy(src.FontInfo, &src_tmp_array[src_i].FontInfo, sizeof(stbtt_fontinfo));
+        }
+        atlas->GlyphCache = cache;
+    }
+
     // Cleanup temporary (ImVector doesn't honor destructor)
     for (int src_i = 0; src_i < src_tmp_array.Size; src_i++)
         src_tmp_array[src_i].~ImFontBuildSrcData();
@@ -2408,6 +3764,338 @@ const ImFontBuilderIO* ImFontAtlasGetBuilderForStbTruetype()
 
 #endif // IMGUI_ENABLE_STB_TRUETYPE
 
+// Glyph cache for ImFontAtlasFlags_DynamicGlyphs (see comments above ImFontAtlasGlyphCache in imgui_internal.h)
+// Glyphs already rasterized stay valid after destroying the cache, other glyphs become missing.
+void ImFontAtlasGlyphCacheDestroy(ImFontAtlas* atlas)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    if (cache == NULL)
+        return;
+    for (int font_n = 0; font_n < atlas->Fonts.Size; font_n++)
+    {
+        ImFont* font = atlas->Fonts[font_n];
+        for (int n = 0; n < font->IndexLookup.Size; n++)
+            if (font->IndexLookup.Data[n] == IM_FONTGLYPH_INDEX_NOT_LOADED || font->IndexLookup.Data[n] == IM_FONTGLYPH_INDEX_QUEUED)
+                font->IndexLookup.Data[n] = (ImWchar)-1;
+        font->GlyphsLastUsedFrame.clear();
+    }
+    for (int src_n = 0; src_n < cache->Sources.Size; src_n++)
+        IM_FREE(cache->Sources[src_n].FontInfo);
+    IM_DELETE(cache);
+    atlas->GlyphCache = NULL;
+}
+
+// Called from ImFont::FindGlyph(), which is const: we can still write into IndexLookup.Data[],
+// and ImFontAtlas::UpdateGlyphCache() will retrieve the non-const font pointer from atlas->Fonts[].
+void ImFontAtlasGlyphCacheQueueGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar c)
+{
+    IM_ASSERT(atlas->GlyphCache != NULL);
+    font->IndexLookup.Data[c] = IM_FONTGLYPH_INDEX_QUEUED;
+    ImFontAtlasGlyphCacheRequest req;
+    req.Font = font;
+    req.Codepoint = c;
+    atlas->GlyphCache->Requests.push_back(req);
+}
+
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+static const ImWchar* ImFontAtlasGlyphCacheGetSrcRanges(ImFontAtlas* atlas, const ImFontAtlasGlyphCacheSrc* src)
+{
+    return src->Config->GlyphRanges ? src->Config->GlyphRanges : atlas->GetGlyphRangesDefault();
+}
+
+// Called at the end of ImFont::BuildLookupTable(): mark every codepoint not rasterized yet and available from one of the
+// font sources as IM_FONTGLYPH_INDEX_NOT_LOADED. Sources are visited in order so the first one providing a codepoint wins, as in Build().
+void ImFontAtlasGlyphCacheUpdateFontLookup(ImFontAtlas* atlas, ImFont* font)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    unsigned int codepoint_max = 0;
+    for (int src_n = 0; src_n < cache->Sources.Size; src_n++)
+        if (cache->Sources[src_n].Config->DstFont == font)
+            for (const ImWchar* src_range = ImFontAtlasGlyphCacheGetSrcRanges(atlas, &cache->Sources[src_n]); src_range[0] && src_range[1]; src_range += 2)
+                codepoint_max = ImMax(codepoint_max, (unsigned int)src_range[1]);
+    if (codepoint_max <= IM_FONTGLYPH_CACHE_PRELOAD_MAX)
+        return;
+
+    const int index_size_old = font->IndexLookup.Size;
+    font->GrowIndex((int)codepoint_max + 1);
+    for (int n = index_size_old; n < font->IndexAdvanceX.Size; n++)
+        font->IndexAdvanceX[n] = font->FallbackAdvanceX;
+    font->IndexLookup[0] = (ImWchar)-1; // Evicted glyphs are left in Glyphs[] with Codepoint 0
+    font->IndexAdvanceX[0] = font->FallbackAdvanceX;
+
+    for (int src_n = 0; src_n < cache->Sources.Size; src_n++)
+    {
+        ImFontAtlasGlyphCacheSrc* src = &cache->Sources[src_n];
+        if (src->Config->DstFont != font)
+            continue;
+        const stbtt_fontinfo* font_info = (const stbtt_fontinfo*)src->FontInfo;
+        for (const ImWchar* src_range = ImFontAtlasGlyphCacheGetSrcRanges(atlas, src); src_range[0] && src_range[1]; src_range += 2)
+            for (unsigned int codepoint = ImMax((unsigned int)src_range[0], (unsigned int)IM_FONTGLYPH_CACHE_PRELOAD_MAX + 1); codepoint <= src_range[1]; codepoint++)
+            {
+                if (font->IndexLookup.Data[codepoint] != (ImWchar)-1)   // Already rasterized, or provided by an earlier source
+                    continue;
+                if (!stbtt_FindGlyphIndex(font_info, (int)codepoint))
+                    continue;
+                font->IndexLookup.Data[codepoint] = IM_FONTGLYPH_INDEX_NOT_LOADED;
+                const unsigned int page_n = codepoint / 4096;
+                font->Used4kPagesMap[page_n >> 3] |= 1 << (page_n & 7);
+            }
+    }
+    font->GlyphsLastUsedFrame.resize(font->Glyphs.Size, 0);
+}
+
+// Merge with previous rectangle when extending it horizontally (consecutive cells of a same shelf)
+static void ImFontAtlasGlyphCacheAddDirtyRect(ImFontAtlas* atlas, int x, int y, int w, int h)
+{
+    if (atlas->TexDirtyRects.Size > 0)
+    {
+        ImFontAtlasDirtyRect& last = atlas->TexDirtyRects.back();
+        if (last.Y == y && last.Height == h && last.X + last.Width == x)
+        {
+            last.Width = (unsigned short)(last.Width + w);
+            return;
+        }
+    }
+    ImFontAtlasDirtyRect r;
+    r.X = (unsigned short)x;
+    r.Y = (unsigned short)y;
+    r.Width = (unsigned short)w;
+    r.Height = (unsigned short)h;
+    atlas->TexDirtyRects.push_back(r);
+}
+
+static ImFontAtlasGlyphCacheCell* ImFontAtlasGlyphCacheAllocCell(ImFontAtlas* atlas, int size)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+    ImFontAtlasGlyphCacheCell new_cell;
+    new_cell.Size = (unsigned short)size;
+    new_cell.Font = NULL;
+    new_cell.GlyphIndex = -1;
+
+    // Append to an existing shelf of the same size
+    for (int shelf_n = 0; shelf_n < cache->Shelves.Size; shelf_n++)
+    {
+        ImFontAtlasGlyphCacheShelf& shelf = cache->Shelves[shelf_n];
+        if (shelf.CellSize != size || shelf.CursorX + size > atlas->TexWidth)
+            continue;
+        new_cell.X = shelf.CursorX;
+        new_cell.Y = shelf.Y;
+        shelf.CursorX = (unsigned short)(shelf.CursorX + size);
+        cache->Cells.push_back(new_cell);
+        return &cache->Cells.back();
+    }
+
+    // Create a new shelf
+    if (cache->ShelvesY + size <= cache->AreaY1)
+    {
+        ImFontAtlasGlyphCacheShelf shelf;
+        shelf.Y = (unsigned short)cache->ShelvesY;
+        shelf.CellSize = (unsigned short)size;
+        shelf.CursorX = (unsigned short)size;
+        cache->Shelves.push_back(shelf);
+        cache->ShelvesY += size;
+        new_cell.X = 0;
+        new_cell.Y = shelf.Y;
+        cache->Cells.push_back(new_cell);
+        return &cache->Cells.back();
+    }
+
+    // Recycle the least recently used cell which is large enough but not too large, and whose glyph wasn't used in the last frame
+    ImFontAtlasGlyphCacheCell* lru_cell = NULL;
+    int lru_frame = cache->FrameCount - 1;
+    for (int cell_n = 0; cell_n < cache->Cells.Size; cell_n++)
+    {
+        ImFontAtlasGlyphCacheCell* cell = &cache->Cells[cell_n];
+        if (cell->Size < size || cell->Size >= size * 2 || cell->Font == NULL)
+            continue;
+        if (&cell->Font->Glyphs[cell->GlyphIndex] == cell->Font->FallbackGlyph)
+            continue;
+        const int last_used_frame = cell->Font->GlyphsLastUsedFrame[cell->GlyphIndex];
+        if (last_used_frame < lru_frame)
+        {
+            lru_cell = cell;
+            lru_frame = last_used_frame;
+        }
+    }
+    if (lru_cell == NULL)
+        return NULL;
+
+    // Evict its glyph. The Glyphs[] entry will be reused by the next glyph loaded into this font.
+    ImFont* font = lru_cell->Font;
+    ImFontGlyph* glyph = &font->Glyphs[lru_cell->GlyphIndex];
+    font->IndexLookup[glyph->Codepoint] = IM_FONTGLYPH_INDEX_NOT_LOADED;
+    font->IndexAdvanceX[glyph->Codepoint] = font->FallbackAdvanceX;
+    glyph->Codepoint = 0;
+    glyph->Visible = 0;
+    ImFontAtlasGlyphCacheSlot slot;
+    slot.Font = font;
+    slot.GlyphIndex = lru_cell->GlyphIndex;
+    cache->FreeSlots.push_back(slot);
+    font->UpdateGlyphsGeneration();
+    lru_cell->Font = NULL;
+    lru_cell->GlyphIndex = -1;
+    cache->GlyphsEvictedCount++;
+    return lru_cell;
+}
+
+// Rasterize one glyph into the cache, following the same steps as ImFontAtlasBuildWithStbTruetype() for a single glyph.
+static void ImFontAtlasGlyphCacheLoadGlyph(ImFontAtlas* atlas, ImFont* font, ImWchar codepoint)
+{
+    ImFontAtlasGlyphCache* cache = atlas->GlyphCache;
+
+    // Find the source providing this glyph
+    const ImFontAtlasGlyphCacheSrc* src = NULL;
+    int glyph_index_in_font = 0;
+    for (int src_n = 0; src_n < cache->Sources.Size && src == NULL; src_n++)
+    {
+        const ImFontAtlasGlyphCacheSrc* src_candidate = &cache->Sources[src_n];
+        if (src_candidate->Config->DstFont != font)
+            continue;
+        bool in_ranges = false;
+        for (const ImWchar* src_range = ImFontAtlasGlyphCacheGetSrcRanges(atlas, src_candidate); src_range[0] && src_range[1] && !in_ranges; src_range += 2)
+            in_ranges = (codepoint >= src_range[0] && codepoint <= src_range[1]);
+        if (in_ranges && (glyph_index_in_font = stbtt_FindGlyphIndex((const stbtt_fontinfo*)src_candidate->FontInfo, (int)codepoint)) != 0)
+            src = src_candidate;
+    }
+    if (src == NULL)
+    {
+        font->IndexLookup[codepoint] = (ImWchar)-1;
+        return;
+    }
+    const ImFontConfig& cfg = *src->Config;
+    stbtt_fontinfo* font_info = (stbtt_fontinfo*)src->FontInfo;
+
+    // Find a Glyphs[] entry: reuse one left by an evicted glyph, or append
+    int glyph_slot_n = -1;
+    for (int slot_n = 0; slot_n < cache->FreeSlots.Size && glyph_slot_n == -1; slot_n++)
+        if (cache->FreeSlots[slot_n].Font == font)
+            glyph_slot_n = slot_n;
+    if (glyph_slot_n == -1 && (unsigned int)font->Glyphs.Size >= (unsigned int)IM_FONTGLYPH_INDEX_QUEUED)
+    {
+        font->IndexLookup[codepoint] = IM_FONTGLYPH_INDEX_NOT_LOADED;
+        cache->GlyphsFailedCount++;
+        return;
+    }
+
+    // Measure, using square cells rounded up to 4 pixels to limit the number of shelf sizes
+    const float scale = (cfg.SizePixels > 0) ? stbtt_ScaleForPixelHeight(font_info, cfg.SizePixels) : stbtt_ScaleForMappingEmToPixels(font_info, -cfg.SizePixels);
+    const int padding = atlas->TexGlyphPadding;
+    int x0, y0, x1, y1;
+    stbtt_GetGlyphBitmapBoxSubpixel(font_info, glyph_index_in_font, scale * cfg.OversampleH, scale * cfg.OversampleV, 0, 0, &x0, &y0, &x1, &y1);
+    stbrp_rect r = {};
+    r.w = (stbrp_coord)(x1 - x0 + padding + cfg.OversampleH - 1);
+    r.h = (stbrp_coord)(y1 - y0 + padding + cfg.OversampleV - 1);
+    const int cell_size = (ImMax((int)r.w, (int)r.h) + 3) & ~3;
+    if (cell_size > atlas->TexWidth || cell_size > cache->AreaY1 - cache->AreaY0)
+    {
+        font->IndexLookup[codepoint] = (ImWchar)-1; // Would never fit
+        return;
+    }
+
+    ImFontAtlasGlyphCacheCell* cell = ImFontAtlasGlyphCacheAllocCell(atlas, cell_size);
+    if (cell == NULL)
+    {
+        font->IndexLookup[codepoint] = IM_FONTGLYPH_INDEX_NOT_LOADED; // Will be queued again next time it is used
+        cache->GlyphsFailedCount++;
+        return;
+    }
+
+    // Rasterize
+    for (int y = 0; y < cell->Size; y++)
+        memset(atlas->TexPixelsAlpha8 + (cell->Y + y) * atlas->TexWidth + cell->X, 0, cell->Size);
+    int codepoint_int = (int)codepoint;
+    stbtt_packedchar packed_char = {};
+    stbtt_pack_range pack_range = {};
+    pack_range.font_size = cfg.SizePixels;
+    pack_range.array_of_unicode_codepoints = &codepoint_int;
+    pack_range.num_chars = 1;
+    pack_range.chardata_for_range = &packed_char;
+    pack_range.h_oversample = (unsigned char)cfg.OversampleH;
+    pack_range.v_oversample = (unsigned char)cfg.OversampleV;
+    stbtt_pack_context spc = {};
+    spc.width = atlas->TexWidth;
+    spc.height = atlas->TexHeight;
+    spc.stride_in_bytes = atlas->TexWidth;
+    spc.padding = padding;
+    spc.pixels = atlas->TexPixelsAlpha8;
+    r.x = cell->X;
+    r.y = cell->Y;
+    r.was_packed = 1;
+    stbtt_PackFontRangesRenderIntoRects(&spc, font_info, &pack_range, 1, &r);
+    if (cfg.RasterizerMultiply != 1.0f)
+    {
+        unsigned char multiply_table[256];
+        ImFontAtlasBuildMultiplyCalcLookupTable(multiply_table, cfg.RasterizerMultiply);
+        ImFontAtlasBuildMultiplyRectAlpha8(multiply_table, atlas->TexPixelsAlpha8, r.x, r.y, r.w, r.h, atlas->TexWidth * 1);
+    }
+    if (atlas->TexPixelsRGBA32 != NULL)
+        for (int y = cell->Y; y < cell->Y + cell->Size; y++)
+        {
+            const unsigned char* src_pixels = atlas->TexPixelsAlpha8 + y * atlas->TexWidth + cell->X;
+            unsigned int* dst_pixels = atlas->TexPixelsRGBA32 + y * atlas->TexWidth + cell->X;
+            for (int n = cell->Size; n > 0; n--)
+                *dst_pixels++ = IM_COL32(255, 255, 255, (unsigned int)(*src_pixels++));
+        }
+    ImFontAtlasGlyphCacheAddDirtyRect(atlas, cell->X, cell->Y, cell->Size, cell->Size);
+
+    // Register glyph. AddGlyph() always appends, so move it into the free entry if we have one.
+    stbtt_aligned_quad q;
+    float unused_x = 0.0f, unused_y = 0.0f;
+    stbtt_GetPackedQuad(&packed_char, atlas->TexWidth, atlas->TexHeight, 0, &unused_x, &unused_y, &q, 0);
+    const float font_off_x = cfg.GlyphOffset.x;
+    const float font_off_y = cfg.GlyphOffset.y + IM_ROUND(font->Ascent);
+    font->AddGlyph(&cfg, codepoint, q.x0 + font_off_x, q.y0 + font_off_y, q.x1 + font_off_x, q.y1 + font_off_y, q.s0, q.t0, q.s1, q.t1, packed_char.xadvance);
+    int glyph_index = font->Glyphs.Size - 1;
+    if (glyph_slot_n != -1)
+    {
+        glyph_index = cache->FreeSlots[glyph_slot_n].GlyphIndex;
+        font->Glyphs[glyph_index] = font->Glyphs.back();
+        font->Glyphs.pop_back();
+        cache->FreeSlots.erase(cache->FreeSlots.Data + glyph_slot_n);
+    }
+    font->DirtyLookupTables = false; // Set by AddGlyph(), but we update lookup tables ourselves
+    font->IndexLookup[codepoint] = (ImWchar)glyph_index;
+    font->IndexAdvanceX[codepoint] = font->Glyphs[glyph_index].AdvanceX;
+    font->FallbackGlyph = font->FindGlyphNoFallback(font->FallbackChar); // Glyphs[] may have been reallocated
+    font->GlyphsLastUsedFrame.resize(font->Glyphs.Size, 0);
+    font->GlyphsLastUsedFrame[glyph_index] = cache->FrameCount;
+    cell->Font = font;
+    cell->GlyphIndex = glyph_index;
+    cache->GlyphsLoadedCount++;
+}
+#else
+void ImFontAtlasGlyphCacheUpdateFontLookup(ImFontAtlas*, ImFont*) {}
+#endif // IMGUI_ENABLE_STB_TRUETYPE
+
+void ImFontAtlas::UpdateGlyphCache()
+{
+    IM_ASSERT(!Locked && "Cannot modify a locked ImFontAtlas between NewFrame() and EndFrame/Render()!");
+    ImFontAtlasGlyphCache* cache = GlyphCache;
+    if (cache == NULL)
+        return;
+    cache->FrameCount++;
+#ifdef IMGUI_ENABLE_STB_TRUETYPE
+    if (cache->Requests.Size == 0)
+        return;
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Font);
+    IM_ASSERT(TexPixelsAlpha8 != NULL); // Don't call ClearTexData() when using ImFontAtlasFlags_DynamicGlyphs
+    for (int req_n = 0; req_n < cache->Requests.Size; req_n++)
+    {
+        const ImFontAtlasGlyphCacheRequest& req = cache->Requests[req_n];
+        ImFont* font = NULL;
+        for (int font_n = 0; font_n < Fonts.Size && font == NULL; font_n++)
+            if (Fonts[font_n] == req.Font)
+                font = Fonts[font_n];
+        if (font == NULL || req.Codepoint >= (unsigned int)font->IndexLookup.Size)
+            continue;
+        const ImWchar index = font->IndexLookup[req.Codepoint];
+        if (index == IM_FONTGLYPH_INDEX_QUEUED || index == IM_FONTGLYPH_INDEX_NOT_LOADED)
+            ImFontAtlasGlyphCacheLoadGlyph(this, font, req.Codepoint);
+    }
+#endif
+    cache->Requests.resize(0);
+}
+
 void ImFontAtlasBuildSetupFont(ImFontAtlas* atlas, ImFont* font, ImFontConfig* font_config, float ascent, float descent)
 {
     if (!font_config->MergeMode)
@@ -2934,6 +4622,7 @@ ImFont::ImFont()
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    UpdateGlyphsGeneration();
 }
 
 ImFont::~ImFont()
@@ -2953,6 +4642,8 @@ void    ImFont::ClearOutputData()
     DirtyLookupTables = true;
     Ascent = Descent = 0.0f;
     MetricsTotalSurface = 0;
+    GlyphsLastUsedFrame.clear();
+    UpdateGlyphsGeneration();
 }
 
 void ImFont::BuildLookupTable()
@@ -2962,11 +4653,12 @@ void ImFont::BuildLookupTable()
         max_codepoint = ImMax(max_codepoint, (int)Glyphs[i].Codepoint);
 
     // Build lookup table
-    IM_ASSERT(Glyphs.Size < 0xFFFF); // -1 is reserved
+    IM_ASSERT((unsigned int)Glyphs.Size < (unsigned int)IM_FONTGLYPH_INDEX_QUEUED); // -1, -2 and -3 are reserved
     IndexAdvanceX.clear();
     IndexLookup.clear();
     DirtyLookupTables = false;
     memset(Used4kPagesMap, 0, sizeof(Used4kPagesMap));
+    UpdateGlyphsGeneration();
     GrowIndex(max_codepoint + 1);
     for (int i = 0; i < Glyphs.Size; i++)
     {
@@ -3003,6 +4695,10 @@ void ImFont::BuildLookupTable()
     for (int i = 0; i < max_codepoint + 1; i++)
         if (IndexAdvanceX[i] < 0.0f)
             IndexAdvanceX[i] = FallbackAdvanceX;
+
+    // Mark glyphs that can be rasterized on demand
+    if (ContainerAtlas && ContainerAtlas->GlyphCache)
+        ImFontAtlasGlyphCacheUpdateFontLookup(ContainerAtlas, this);
 }
 
 // API is designed this way to avoid exposing the 4K page size
@@ -3030,6 +4726,13 @@ void ImFont::SetFallbackChar(ImWchar c)
     BuildLookupTable();
 }
 
+// Called whenever glyphs or their advances change. Values come from a global counter so a font allocated at the address of a destroyed one doesn't match stale results.
+void ImFont::UpdateGlyphsGeneration()
+{
+    static unsigned int generation_counter = 0;
+    GlyphsGeneration = ++generation_counter;
+}
+
 void ImFont::GrowIndex(int new_size)
 {
     IM_ASSERT(IndexAdvanceX.Size == IndexLookup.Size);
@@ -3083,6 +4786,7 @@ void ImFont::AddGlyph(const ImFontConfig* cfg, ImWchar codepoint, float x0, floa
     // We use (U1-U0)*TexWidth instead of X1-X0 to account for oversampling.
     float pad = ContainerAtlas->TexGlyphPadding + 0.99f;
     DirtyLookupTables = true;
+    UpdateGlyphsGeneration();
     MetricsTotalSurface += (int)((glyph.U1 - glyph.U0) * ContainerAtlas->TexWidth + pad) * (int)((glyph.V1 - glyph.V0) * ContainerAtlas->TexHeight + pad);
 }
 
@@ -3099,6 +4803,7 @@ void ImFont::AddRemapChar(ImWchar dst, ImWchar src, bool overwrite_dst)
     GrowIndex(dst + 1);
     IndexLookup[dst] = (src < index_size) ? IndexLookup.Data[src] : (ImWchar)-1;
     IndexAdvanceX[dst] = (src < index_size) ? IndexAdvanceX.Data[src] : 1.0f;
+    UpdateGlyphsGeneration();
 }
 
 const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
@@ -3106,8 +4811,14 @@ const ImFontGlyph* ImFont::FindGlyph(ImWchar c) const
     if (c >= (size_t)IndexLookup.Size)
         return FallbackGlyph;
     const ImWchar i = IndexLookup.Data[c];
-    if (i == (ImWchar)-1)
+    if (i >= IM_FONTGLYPH_INDEX_QUEUED) // -1, IM_FONTGLYPH_INDEX_NOT_LOADED or IM_FONTGLYPH_INDEX_QUEUED
+    {
+        if (i == IM_FONTGLYPH_INDEX_NOT_LOADED)
+            ImFontAtlasGlyphCacheQueueGlyph(ContainerAtlas, this, c);
         return FallbackGlyph;
+    }
+    if ((int)i < GlyphsLastUsedFrame.Size)
+        GlyphsLastUsedFrame.Data[i] = ContainerAtlas->GlyphCache->FrameCount;
     return &Glyphs.Data[i];
 }
 
@@ -3116,7 +4827,7 @@ const ImFontGlyph* ImFont::FindGlyphNoFallback(ImWchar c) const
     if (c >= (size_t)IndexLookup.Size)
         return NULL;
     const ImWchar i = IndexLookup.Data[c];
-    if (i == (ImWchar)-1)
+    if (i >= IM_FONTGLYPH_INDEX_QUEUED)
         return NULL;
     return &Glyphs.Data[i];
 }
@@ -3328,6 +5039,138 @@ void ImFont::RenderChar(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
     draw_list->PrimRectUV(ImVec2(pos.x + glyph->X0 * scale, pos.y + glyph->Y0 * scale), ImVec2(pos.x + glyph->X1 * scale, pos.y + glyph->Y1 * scale), ImVec2(glyph->U0, glyph->V0), ImVec2(glyph->U1, glyph->V1), col);
 }
 
+// SSE2 path of RenderText() for runs of printable ASCII characters (0x20..0x7E), which make the bulk of most UI and log text.
+// Glyphs are looked up 16 at a time, then each quad is computed and clipped as (x1,y1,x2,y2) vectors and its vertices are written
+// with one 16-byte store for pos+uv (this requires the default ImDrawVert layout).
+// We evaluate the same operations in the same order as the scalar code, so output is bitwise identical.
+#if defined(IMGUI_ENABLE_SSE) && !defined(IMGUI_OVERRIDE_DRAWVERT_STRUCT_LAYOUT)
+#define IMGUI_ENABLE_SSE_RENDERTEXT
+
+// Return end of the run of printable ASCII characters starting at 'text'
+static inline const char* ImSseFindAsciiRunEnd(const char* text, const char* text_end)
+{
+    const __m128i v_control_max = _mm_set1_epi8(0x1F);
+    const __m128i v_del = _mm_set1_epi8(0x7F);
+    for (; text_end - text >= 16; text += 16)
+    {
+        // Signed compare: bytes >= 0x80 (non-ASCII) are negative and fail the test like control characters
+        const __m128i v = _mm_loadu_si128((const __m128i*)(const void*)text);
+        const __m128i v_printable = _mm_andnot_si128(_mm_cmpeq_epi8(v, v_del), _mm_cmpgt_epi8(v, v_control_max));
+        unsigned int mask = (unsigned int)_mm_movemask_epi8(v_printable);
+        if (mask != 0xFFFF)
+        {
+            while (mask & 1)
+            {
+                text++;
+                mask >>= 1;
+            }
+            return text;
+        }
+    }
+    while (text < text_end && (unsigned char)(*text - 0x20) < 0x5F)
+        text++;
+    return text;
+}
+
+struct ImFontRenderTextSseState
+{
+    __m128          Scale;          // (scale, scale, scale, scale)
+    __m128          ClipMin;        // (clip_rect.x, clip_rect.y) x 2
+    __m128          ClipMax;        // (clip_rect.z, clip_rect.w) x 2
+    __m128          ClipTestMax;    // (clip_rect.z, 0, -clip_rect.x, 0), compared to (x1, y1, -x2, y2) (y lanes are ignored)
+    __m128          SignX2;         // Flip sign of x2 in (x1, y1, x2, y2)
+    __m128          MaskXU;         // Select x and u lanes of (x, y, u, v)
+    ImDrawVert*     VtxWrite;
+    ImDrawIdx*      IdxWrite;
+    unsigned int    VtxCurrentIdx;
+};
+
+// Render characters in [s, s_end), which are all printable ASCII, advancing 'x'
+static void ImFontRenderTextAsciiRunSse(const ImFont* font, ImFontRenderTextSseState* st, float* p_x, float y, ImU32 col, ImU32 col_untinted, const char* s, const char* s_end, bool cpu_fine_clip)
+{
+    float x = *p_x;
+    ImDrawVert* vtx_write = st->VtxWrite;
+    ImDrawIdx* idx_write = st->IdxWrite;
+    unsigned int vtx_current_idx = st->VtxCurrentIdx;
+    const float scale = _mm_cvtss_f32(st->Scale);
+    while (s < s_end)
+    {
+        const ImFontGlyph* glyphs[16];
+        const int glyphs_count = ImMin((int)(s_end - s), IM_ARRAYSIZE(glyphs));
+        for (int n = 0; n < glyphs_count; n++)
+            glyphs[n] = font->FindGlyph((ImWchar)s[n]);
+        s += glyphs_count;
+
+        for (int n = 0; n < glyphs_count; n++)
+        {
+            const ImFontGlyph* glyph = glyphs[n];
+            if (glyph == NULL)
+                continue;
+            const float char_width = glyph->AdvanceX * scale;
+            if (glyph->Visible)
+            {
+                // (x1, y1, x2, y2) = (x, y, x, y) + (X0, Y0, X1, Y1) * scale
+                const __m128 pos = _mm_add_ps(_mm_set_ps(y, x, y, x), _mm_mul_ps(_mm_loadu_ps(&glyph->X0), st->Scale));
+                if ((_mm_movemask_ps(_mm_cmple_ps(_mm_xor_ps(pos, st->SignX2), st->ClipTestMax)) & 0x05) == 0x05) // x1 <= clip_rect.z && x2 >= clip_rect.x
+                {
+                    const __m128 uv = _mm_loadu_ps(&glyph->U0);
+                    __m128 p1 = _mm_movelh_ps(pos, pos);    // (x1, y1, x1, y1)
+                    __m128 p2 = _mm_movehl_ps(pos, pos);    // (x2, y2, x2, y2)
+                    __m128 uv1 = _mm_movelh_ps(uv, uv);     // (u1, v1, u1, v1)
+                    __m128 uv2 = _mm_movehl_ps(uv, uv);     // (u2, v2, u2, v2)
+
+                    // CPU side clipping, both axes at once: left/top edges then right/bottom edges (using the clipped p1/uv1 as the scalar code does)
+                    // Most glyphs are fully inside the clip rectangle: only pay for the divisions when an edge is crossed.
+                    if (cpu_fine_clip)
+                    {
+                        __m128 mask = _mm_cmplt_ps(p1, st->ClipMin);
+                        if (_mm_movemask_ps(mask))
+                        {
+                            const __m128 uv1_clipped = _mm_add_ps(uv1, _mm_mul_ps(_mm_sub_ps(_mm_set1_ps(1.0f), _mm_div_ps(_mm_sub_ps(p2, st->ClipMin), _mm_sub_ps(p2, p1))), _mm_sub_ps(uv2, uv1)));
+                            uv1 = _mm_or_ps(_mm_and_ps(mask, uv1_clipped), _mm_andnot_ps(mask, uv1));
+                            p1 = _mm_or_ps(_mm_and_ps(mask, st->ClipMin), _mm_andnot_ps(mask, p1));
+                        }
+                        mask = _mm_cmpgt_ps(p2, st->ClipMax);
+                        if (_mm_movemask_ps(mask))
+                        {
+                            const __m128 uv2_clipped = _mm_add_ps(uv1, _mm_mul_ps(_mm_div_ps(_mm_sub_ps(st->ClipMax, p1), _mm_sub_ps(p2, p1)), _mm_sub_ps(uv2, uv1)));
+                            uv2 = _mm_or_ps(_mm_and_ps(mask, uv2_clipped), _mm_andnot_ps(mask, uv2));
+                            p2 = _mm_or_ps(_mm_and_ps(mask, st->ClipMax), _mm_andnot_ps(mask, p2));
+                        }
+                        if (_mm_movemask_ps(_mm_cmpge_ps(p1, p2)) & 0x02) // y1 >= y2
+                        {
+                            x += char_width;
+                            continue;
+                        }
+                    }
+
+                    // Vertices (pos, uv): 0 = (x1, y1, u1, v1), 1 = (x2, y1, u2, v1), 2 = (x2, y2, u2, v2), 3 = (x1, y2, u1, v2)
+                    const __m128 v0 = _mm_movelh_ps(p1, uv1);
+                    const __m128 v2 = _mm_movelh_ps(p2, uv2);
+                    const __m128 v1 = _mm_or_ps(_mm_and_ps(st->MaskXU, v2), _mm_andnot_ps(st->MaskXU, v0));
+                    const __m128 v3 = _mm_or_ps(_mm_and_ps(st->MaskXU, v0), _mm_andnot_ps(st->MaskXU, v2));
+                    const ImU32 glyph_col = glyph->Colored ? col_untinted : col;
+                    _mm_storeu_ps(&vtx_write[0].pos.x, v0); vtx_write[0].col = glyph_col;
+                    _mm_storeu_ps(&vtx_write[1].pos.x, v1); vtx_write[1].col = glyph_col;
+                    _mm_storeu_ps(&vtx_write[2].pos.x, v2); vtx_write[2].col = glyph_col;
+                    _mm_storeu_ps(&vtx_write[3].pos.x, v3); vtx_write[3].col = glyph_col;
+                    idx_write[0] = (ImDrawIdx)(vtx_current_idx); idx_write[1] = (ImDrawIdx)(vtx_current_idx+1); idx_write[2] = (ImDrawIdx)(vtx_current_idx+2);
+                    idx_write[3] = (ImDrawIdx)(vtx_current_idx); idx_write[4] = (ImDrawIdx)(vtx_current_idx+2); idx_write[5] = (ImDrawIdx)(vtx_current_idx+3);
+                    vtx_write += 4;
+                    vtx_current_idx += 4;
+                    idx_write += 6;
+                }
+            }
+            x += char_width;
+        }
+    }
+    *p_x = x;
+    st->VtxWrite = vtx_write;
+    st->IdxWrite = idx_write;
+    st->VtxCurrentIdx = vtx_current_idx;
+}
+#endif
+
 void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col, const ImVec4& clip_rect, const char* text_begin, const char* text_end, float wrap_width, bool cpu_fine_clip) const
 {
     if (!text_end)
@@ -3385,6 +5228,16 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
 
     const ImU32 col_untinted = col | ~IM_COL32_A_MASK;
 
+#ifdef IMGUI_ENABLE_SSE_RENDERTEXT
+    ImFontRenderTextSseState sse_state;
+    sse_state.Scale = _mm_set1_ps(scale);
+    sse_state.ClipMin = _mm_set_ps(clip_rect.y, clip_rect.x, clip_rect.y, clip_rect.x);
+    sse_state.ClipMax = _mm_set_ps(clip_rect.w, clip_rect.z, clip_rect.w, clip_rect.z);
+    sse_state.ClipTestMax = _mm_set_ps(0.0f, -clip_rect.x, 0.0f, clip_rect.z);
+    sse_state.SignX2 = _mm_castsi128_ps(_mm_set_epi32(0, (int)0x80000000, 0, 0));
+    sse_state.MaskXU = _mm_castsi128_ps(_mm_set_epi32(0, -1, 0, -1));
+#endif
+
     while (s < text_end)
     {
         if (word_wrap_enabled)
@@ -3413,6 +5266,23 @@ void ImFont::RenderText(ImDrawList* draw_list, float size, ImVec2 pos, ImU32 col
             }
         }
 
+#ifdef IMGUI_ENABLE_SSE_RENDERTEXT
+        // Render the run of printable ASCII characters starting here (up to the next word-wrap position)
+        if ((unsigned char)(*s - 0x20) < 0x5F)
+        {
+            const char* run_end = ImSseFindAsciiRunEnd(s, word_wrap_enabled ? word_wrap_eol : text_end);
+            sse_state.VtxWrite = vtx_write;
+            sse_state.IdxWrite = idx_write;
+            sse_state.VtxCurrentIdx = vtx_current_idx;
+            ImFontRenderTextAsciiRunSse(this, &sse_state, &x, y, col, col_untinted, s, run_end, cpu_fine_clip);
+            vtx_write = sse_state.VtxWrite;
+            idx_write = sse_state.IdxWrite;
+            vtx_current_idx = sse_state.VtxCurrentIdx;
+            s = run_end;
+            continue;
+        }
+#endif
+
         // Decode and advance source
         unsigned int c = (unsigned int)*s;
         if (c < 0x80)
@@ -84,6 +84,12 @@ Index of this file:
 #error Use IMGUI_DISABLE_DEFAULT_MATH_FUNCTIONS
 #endif
 
+// Enable SSE2 intrinsics if available (x86-64 and x86 builds with SSE2 enabled). Define IMGUI_DISABLE_SSE to disable.
+#if (defined __SSE2__ || defined __x86_64__ || defined _M_X64 || (defined(_M_IX86_FP) && (_M_IX86_FP >= 2))) && !defined(IMGUI_DISABLE_SSE)
+#define IMGUI_ENABLE_SSE
+#include <emmintrin.h>
+#endif
+
 // Enable stb_truetype by default unless FreeType is enabled.
 // You can compile with both by defining both IMGUI_ENABLE_FREETYPE and IMGUI_ENABLE_STB_TRUETYPE together.
 #ifndef IMGUI_ENABLE_FREETYPE
@@ -128,6 +134,7 @@ struct ImGuiWindowSettings;         // Storage for a window .ini settings (we ke
 
 // Use your programming IDE "Go to definition" facility on the names of the center columns to find the actual flags/enum lists.
 typedef int ImGuiLayoutType;            // -> enum ImGuiLayoutType_         // Enum: Horizontal or vertical
+typedef int ImGuiMemCategory;           // -> enum ImGuiMemCategory_        // Enum: Category of allocations, for Metrics
 typedef int ImGuiItemFlags;             // -> enum ImGuiItemFlags_          // Flags: for PushItemFlag()
 typedef int ImGuiItemStatusFlags;       // -> enum ImGuiItemStatusFlags_    // Flags: for DC.LastItemStatusFlags
 typedef int ImGuiOldColumnFlags;        // -> enum ImGuiOldColumnFlags_     // Flags: for BeginColumns()
@@ -163,8 +170,7 @@ namespace ImStb
 #define STB_TEXTEDIT_STRING             ImGuiInputTextState
 #define STB_TEXTEDIT_CHARTYPE           ImWchar
 #define STB_TEXTEDIT_GETWIDTH_NEWLINE   (-1.0f)
-#define STB_TEXTEDIT_UNDOSTATECOUNT     99
-#define STB_TEXTEDIT_UNDOCHARCOUNT      999
+#define STB_TEXTEDIT_UNDO_CUSTOM                                    // Undo history is stored in ImGuiInputTextState::Undo
 #include "imstb_textedit.h"
 
 } // namespace ImStb
@@ -226,8 +232,18 @@ namespace ImStb
 #define IMGUI_CDECL
 #endif
 
+// Thread-local storage, when supported by the compiler (used to tell apart the thread owning a context)
+#if (defined(__cplusplus) && __cplusplus >= 201103L) || (defined(_MSC_VER) && _MSC_VER >= 1900)
+#define IM_THREAD_LOCAL thread_local
+#elif defined(__GNUC__)
+#define IM_THREAD_LOCAL __thread
+#elif defined(_MSC_VER)
+#define IM_THREAD_LOCAL __declspec(thread)
+#endif
+
 // Debug Tools
 // Use 'Metrics->Tools->Item Picker' to break into the call-stack of a specific item.
+// Use 'Metrics->Memory->Zero-allocation check' or DebugStartZeroAllocCheck() to break into the call-stack of heap allocations made after warm-up.
 #ifndef IM_DEBUG_BREAK
 #if defined(__clang__)
 #define IM_DEBUG_BREAK()    __builtin_debugtrap()
@@ -259,11 +275,13 @@ namespace ImStb
 // - Helper: ImSpan<>, ImSpanAllocator<>
 // - Helper: ImPool<>
 // - Helper: ImChunkStream<>
+// - Helper: ImFrameArena
 //-----------------------------------------------------------------------------
 
 // Helpers: Hashing
 IMGUI_API ImGuiID       ImHashData(const void* data, size_t data_size, ImU32 seed = 0);
 IMGUI_API ImGuiID       ImHashStr(const char* data, size_t data_size = 0, ImU32 seed = 0);
+IMGUI_API ImU64         ImHashData64(const void* data, size_t data_size, ImU64 seed = 0);
 #ifndef IMGUI_DISABLE_OBSOLETE_FUNCTIONS
 static inline ImGuiID   ImHash(const void* data, int size, ImU32 seed = 0) { return size ? ImHashData(data, (size_t)size, seed) : ImHashStr((const char*)data, 0, seed); } // [moved to ImHashStr/ImHashData in 1.68]
 #endif
@@ -471,6 +489,9 @@ struct IMGUI_API ImRect
 };
 
 // Helper: ImBitArray
+typedef ImU32*  ImBitArrayPtr; // Name for use in structs
+inline size_t   ImBitArrayGetStorageSizeInBytes(int bitcount)   { return (size_t)((bitcount + 31) >> 5) << 2; }
+inline void     ImBitArrayClearAllBits(ImU32* arr, int bitcount){ memset(arr, 0, ImBitArrayGetStorageSizeInBytes(bitcount)); }
 inline bool     ImBitArrayTestBit(const ImU32* arr, int n)      { ImU32 mask = (ImU32)1 << (n & 31); return (arr[n >> 5] & mask) != 0; }
 inline void     ImBitArrayClearBit(ImU32* arr, int n)           { ImU32 mask = (ImU32)1 << (n & 31); arr[n >> 5] &= ~mask; }
 inline void     ImBitArraySetBit(ImU32* arr, int n)             { ImU32 mask = (ImU32)1 << (n & 31); arr[n >> 5] |= mask; }
@@ -487,6 +508,26 @@ inline void     ImBitArraySetBitRange(ImU32* arr, int n, int n2) // Works on ran
     }
 }
 
+inline int      ImBitArrayFindNextSetBit(const ImU32* arr, int n, int n2) // Works on range [n..n2), return -1 if no bit is set
+{
+    while (n < n2)
+    {
+        ImU32 bits = arr[n >> 5] >> (n & 31);
+        if (bits == 0)
+        {
+            n = (n + 32) & ~31;
+            continue;
+        }
+        while ((bits & 1) == 0)
+        {
+            bits >>= 1;
+            n++;
+        }
+        return (n < n2) ? n : -1;
+    }
+    return -1;
+}
+
 // Helper: ImBitArray class (wrapper over ImBitArray functions)
 // Store 1-bit per value. NOT CLEARED by constructor.
 template<int BITCOUNT>
@@ -613,6 +654,27 @@ struct IMGUI_API ImChunkStream
 
 };
 
+// Helper: ImFrameArena
+// Bump allocator for transient allocations, which are all released at once by Reset() (g.FrameArena is reset by NewFrame()).
+// Memory is taken from blocks allocated with IM_ALLOC(). When Reset() finds more than one block they are replaced by a single block
+// sized for the peak usage, so a steady workload stops allocating from the heap after a few frames.
+struct ImFrameArenaBlock;
+struct IMGUI_API ImFrameArena
+{
+    ImFrameArenaBlock*  Blocks;         // Linked list of blocks, current first (not an ImVector<> as they may be allocating from us)
+    int                 BlocksCount;
+    size_t              UsedSize;       // Bytes allocated since last Reset()
+    size_t              PeakUsedSize;   // Largest value of UsedSize
+    size_t              CapacitySize;   // Sum of blocks sizes
+
+    ImFrameArena()      { memset(this, 0, sizeof(*this)); }
+    ~ImFrameArena()     { Clear(); }
+    void*   Alloc(size_t size);         // Return 16-bytes aligned memory
+    bool    Contains(const void* ptr) const;
+    void    Reset();
+    void    Clear();
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] ImDrawList support
 //-----------------------------------------------------------------------------
@@ -669,6 +731,76 @@ struct ImDrawDataBuilder
     IMGUI_API void FlattenIntoSingleLayer();
 };
 
+// Primitive submitted to a retained draw list: hash of everything submitted so far, and state of the buffers after it
+struct ImDrawListRetainedPrim
+{
+    ImU64           Hash;
+    int             VtxSize;
+    int             IdxSize;
+    int             CmdSize;
+    unsigned int    CmdIdxOffset;       // IdxOffset of the last command
+    unsigned int    VtxCurrentIdx;
+};
+
+// Retained geometry of a draw list (ImGuiWindowFlags_RetainGeometry)
+// Each primitive (AddPolyline(), AddConvexPolyFilled(), AddText(), etc.) hashes its parameters, positions being relative to the window position.
+// While replaying, primitives matching last frame's are skipped: the draw list buffer sizes only move over last frame's output.
+// On the first mismatch (or any write we can't track), last frame's output up to that point is copied back, translated if the window moved,
+// and we carry on drawing normally. If everything matched, ImDrawListRetainedEnd() swaps last frame's buffers back in.
+struct ImDrawListRetained
+{
+    ImVector<ImDrawCmd>     CmdBuffer;          // Output of last frame
+    ImVector<ImDrawIdx>     IdxBuffer;
+    ImVector<ImDrawVert>    VtxBuffer;
+    ImVector<ImDrawListRetainedPrim> Prims;     // Primitives of last frame
+    ImVector<ImDrawListRetainedPrim> PrimsNext; // Primitives of current frame
+    ImDrawListRetainedPrim  End;                // State at the end of last frame (when EndValid)
+    ImVec2                  Origin;             // Position of owner window, primitives are hashed relative to it
+    ImVec2                  PrevOrigin;
+    ImU64                   Hash;               // Hash of everything submitted so far
+    int                     PrimsCount;         // Number of primitives submitted so far (not counting nested ones)
+    int                     PrimDepth;          // > 0 while drawing a primitive
+    bool                    Active;             // Between ImDrawListRetainedBegin() and ImDrawListRetainedEnd()
+    bool                    Replaying;          // Skipping primitives matching last frame's
+    bool                    Recording;          // Hashing primitives (stops when channels are split)
+    bool                    Recorded;           // Current frame was recorded, Prims/buffers will be valid next frame
+    bool                    PrimsValid;
+    bool                    EndValid;
+
+    // Statistics
+    int                     FramesCount;
+    int                     FramesReused;       // Frames where all primitives matched
+    int                     LastPrimsCount;
+    int                     LastPrimsReused;
+
+    ImDrawListRetained()    { memset(this, 0, sizeof(*this)); }
+    IMGUI_API void          ClearFreeMemory();
+};
+
+// Helper to hash the parameters of a primitive submitted to a retained draw list
+struct ImDrawListRetainedHasher
+{
+    ImU64           Hash;
+    ImVec2          Origin;
+
+    ImDrawListRetainedHasher(const ImDrawList* draw_list, ImU32 prim_type) { Hash = 0; Origin = draw_list->_Retained->Origin; AddU32(prim_type); AddU32((ImU32)draw_list->Flags); AddFloat(draw_list->_FringeScale); }
+    void            AddU32(ImU32 v)                             { Hash = (Hash ^ v) * 0x9E3779B97F4A7C15ULL; Hash ^= Hash >> 32; }
+    void            AddFloat(float v)                           { ImU32 u; memcpy(&u, &v, sizeof(u)); AddU32(u); }
+    void            AddPos(const ImVec2& p)                     { AddFloat(p.x - Origin.x); AddFloat(p.y - Origin.y); }
+    void            AddRect(const ImVec4& r)                    { AddPos(ImVec2(r.x, r.y)); AddPos(ImVec2(r.z, r.w)); }
+    void            AddPoints(const ImVec2* points, int count)  { AddU32((ImU32)count); for (int n = 0; n < count; n++) AddPos(points[n]); }
+    void            AddData(const void* data, size_t size)
+    {
+        const unsigned char* p = (const unsigned char*)data;
+        AddU32((ImU32)size);
+        for (; size >= 4; p += 4, size -= 4) { ImU32 u; memcpy(&u, p, 4); AddU32(u); }
+        if (size > 0) { ImU32 u = 0; memcpy(&u, p, size); AddU32(u); }
+    }
+};
+
+IMGUI_API void              ImDrawListRetainedBegin(ImDrawList* draw_list, const ImVec2& origin);
+IMGUI_API void              ImDrawListRetainedEnd(ImDrawList* draw_list);
+
 //-----------------------------------------------------------------------------
 // [SECTION] Widgets support: flags, enums, data structures
 //-----------------------------------------------------------------------------
@@ -948,6 +1080,44 @@ struct IMGUI_API ImGuiMenuColumns
     float       CalcExtraSpace(float avail_w) const;
 };
 
+// Undo/redo record for InputText(): replacement of DeleteLen characters at Where with InsertLen characters
+struct ImGuiInputTextUndoRecord
+{
+    int                     Where;                  // position of the edit (in characters)
+    int                     DeleteLen;              // number of characters removed
+    int                     InsertLen;              // number of characters inserted
+    int                     TextOffset;             // offset of the removed text in ImGuiInputTextUndoStack::Text, immediately followed by the inserted text (both UTF-8)
+    int                     DeleteBytes;            // size of the removed text in UTF-8
+    int                     InsertBytes;            // size of the inserted text in UTF-8
+    int                     Group;                  // ImGuiInputTextUndoStack::Group at the time of the last edit merged in this record
+};
+
+// Undo/redo history for InputText(), replacing the fixed-size buffers of stb_textedit.h
+// Edits are recorded by STB_TEXTEDIT_DELETECHARS()/STB_TEXTEDIT_INSERTCHARS() as UTF-8 deltas stored in a single growable buffer.
+// A delete followed by an insert at the same position within an action becomes a single record, typed characters and
+// successive Backspace/Delete presses are merged in the same record until a new word or line is started.
+// Oldest records are discarded when the history uses more than io.ConfigInputTextUndoMemoryMax bytes. They are only skipped over
+// at first, and removed from the buffers once they take more space than the remaining history, so trimming cost is amortized.
+struct IMGUI_API ImGuiInputTextUndoStack
+{
+    ImVector<ImGuiInputTextUndoRecord> Records;     // [FirstRecord..UndoPoint) can be undone, [UndoPoint..Records.Size) can be redone, [0..FirstRecord) were discarded
+    ImVector<char>          Text;                   // removed/inserted text of all records, in order
+    int                     FirstRecord;            // index of the oldest record still in use
+    int                     UndoPoint;              // index of the next record to redo
+    int                     Group;                  // incremented on every user action. Records of the same group are merged, typing runs may extend a record of the previous group.
+    bool                    Applying;               // set while undoing/redoing so edits are not recorded
+
+    ImGuiInputTextUndoStack()               { memset(this, 0, sizeof(*this)); }
+    void        Clear()                     { Records.resize(0); Text.resize(0); FirstRecord = UndoPoint = 0; }
+    void        ClearFreeMemory()           { Records.clear(); Text.clear(); FirstRecord = UndoPoint = 0; }
+    int         GetTextOffset() const       { return FirstRecord < Records.Size ? Records[FirstRecord].TextOffset : Text.Size; }   // start of the text still in use
+    int         GetMemoryUsage() const      { return Text.Size - GetTextOffset() + (Records.Size - FirstRecord) * (int)sizeof(ImGuiInputTextUndoRecord); }
+    void        NextGroup(bool allow_merge) { Group += allow_merge ? 1 : 2; }
+    void        RecordDelete(int where, const ImWchar* text, int text_len);
+    void        RecordInsert(int where, const ImWchar* text, int text_len);
+    void        ApplyMemoryLimit();
+};
+
 // Internal state of the currently focused/edited text input box
 // For a given item ID, access with ImGui::GetInputTextState()
 struct IMGUI_API ImGuiInputTextState
@@ -955,12 +1125,19 @@ struct IMGUI_API ImGuiInputTextState
     ImGuiID                 ID;                     // widget id owning the text state
     int                     CurLenW, CurLenA;       // we need to maintain our buffer length in both UTF-8 and wchar format. UTF-8 length is valid even if TextA is not.
     ImVector<ImWchar>       TextW;                  // edit buffer, we need to persist but can't guarantee the persistence of the user-provided buffer. so we copy into own buffer.
-    ImVector<char>          TextA;                  // temporary UTF8 buffer for callbacks and other operations. this is not updated in every code-path! size=capacity.
+    ImVector<char>          TextA;                  // UTF8 mirror of TextW, updated incrementally by the edit callbacks. used for callbacks, clipboard and applying back to user buffer. size=capacity.
     ImVector<char>          InitialTextA;           // backup of end-user buffer at the time of focus (in UTF-8, unaltered)
-    bool                    TextAIsValid;           // temporary UTF8 buffer is not initially valid before we make the widget active (until then we pull the data from user argument)
+    bool                    TextAIsValid;           // UTF8 mirror is only valid for non read-only widgets once they have been made active (until then we pull the data from user argument)
+    int                     TextAOffsetCacheW;      // last (wchar index, UTF-8 offset) pair converted by the edit callbacks: edits are mostly local so we count from there instead of from the start of the text
+    int                     TextAOffsetCacheA;      // "
+    ImVector<int>           LineStartsW;            // index of the first character of each line in TextW ([0] == 0). maintained by the edit callbacks, so per-frame cost is proportional to visible lines
+    ImVector<int>           LineStartsA;            // offset of the first byte of each line in the UTF-8 text (TextA, or user buffer when read-only)
+    bool                    LineStartsDirty;        // set when TextW is rewritten as a whole, the line index will be rebuilt on next use
+    int                     LineStartsLastRow;      // last line returned by STB_TEXTEDIT_LAYOUTROW(), stb_textedit.h iterates rows in order
     int                     BufCapacityA;           // end-user buffer capacity
     float                   ScrollX;                // horizontal scrolling/offset
     ImStb::STB_TexteditState Stb;                   // state for stb_textedit.h
+    ImGuiInputTextUndoStack Undo;                   // undo/redo history
     float                   CursorAnim;             // timer for cursor blink, reset on every user action so the cursor reappears immediately
     bool                    CursorFollow;           // set when we want scrolling to follow the current cursor position (not always!)
     bool                    SelectedAllMouseLock;   // after a double-click to select all, we ignore further mouse drags to update selection
@@ -970,10 +1147,10 @@ struct IMGUI_API ImGuiInputTextState
     void*                   UserCallbackData;       // "
 
     ImGuiInputTextState()                   { memset(this, 0, sizeof(*this)); }
-    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; CursorClamp(); }
-    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); }
-    int         GetUndoAvailCount() const   { return Stb.undostate.undo_point; }
-    int         GetRedoAvailCount() const   { return STB_TEXTEDIT_UNDOSTATECOUNT - Stb.undostate.redo_point; }
+    void        ClearText()                 { CurLenW = CurLenA = 0; TextW[0] = 0; TextA[0] = 0; TextAOffsetCacheW = TextAOffsetCacheA = 0; LineStartsDirty = true; CursorClamp(); }
+    void        ClearFreeMemory()           { TextW.clear(); TextA.clear(); InitialTextA.clear(); LineStartsW.clear(); LineStartsA.clear(); LineStartsDirty = true; Undo.ClearFreeMemory(); }
+    int         GetUndoAvailCount() const   { return Undo.UndoPoint - Undo.FirstRecord; }
+    int         GetRedoAvailCount() const   { return Undo.Records.Size - Undo.UndoPoint; }
     void        OnKeyPressed(int key);      // Cannot be inline because we call in code in stb_textedit.h implementation
 
     // Cursor & Selection
@@ -1082,6 +1259,44 @@ struct ImGuiPtrOrIndex
     ImGuiPtrOrIndex(int index)  { Ptr = NULL; Index = index; }
 };
 
+// Cache of ImGui::CalcTextSize() results for strings of IM_TEXTSIZE_CACHE_MIN_TEXT_LEN bytes or more, enabled with io.ConfigTextSizeCache.
+// Set-associative table: an entry can only be stored in one of the IM_TEXTSIZE_CACHE_WAYS slots of its set, replacing the least recently used one.
+// NewFrame() doubles the table size when recently used entries got evicted during the previous frame.
+// Wrapped text is measured through the cache too (wrap width is part of the key), but the line breaks ImFont::RenderText() finds
+// with CalcWordWrapPositionA() when drawing it are not cached.
+#define IM_TEXTSIZE_CACHE_WAYS              4
+#define IM_TEXTSIZE_CACHE_MIN_ENTRIES       1024
+#define IM_TEXTSIZE_CACHE_MAX_ENTRIES       (1 << 17)
+#define IM_TEXTSIZE_CACHE_MIN_TEXT_LEN      16          // Shorter strings are not cached
+
+struct ImGuiTextSizeCacheEntry
+{
+    ImU64       Hash;                   // 64-bit hash of text, font, font glyphs generation, font size and wrap width (0: unused slot)
+    int         TextLen;
+    ImFont*     Font;
+    unsigned int FontGlyphsGeneration;  // ImFont::GlyphsGeneration at the time the text was measured
+    float       FontSize;
+    float       WrapWidth;
+    ImVec2      Size;                   // Output of ImFont::CalcTextSizeA()
+    int         LastUsedFrame;
+};
+
+struct ImGuiTextSizeCache
+{
+    ImVector<ImGuiTextSizeCacheEntry> Entries;  // Power of two size, or empty when disabled
+    int         HitCountThisFrame;
+    int         MissCountThisFrame;
+    int         EvictRecentCountThisFrame;      // Evicted entries which were used this frame or the previous one
+    int         HitCountLastFrame;
+    int         MissCountLastFrame;
+    int         EvictRecentCountLastFrame;
+    ImU64       HitCount;                       // Totals since the cache was last cleared
+    ImU64       MissCount;
+
+    ImGuiTextSizeCache()    { memset(this, 0, sizeof(*this)); }
+    void        Clear()     { Entries.clear(); HitCountThisFrame = MissCountThisFrame = EvictRecentCountThisFrame = HitCountLastFrame = MissCountLastFrame = EvictRecentCountLastFrame = 0; HitCount = MissCount = 0; }
+};
+
 //-----------------------------------------------------------------------------
 // [SECTION] Columns support
 //-----------------------------------------------------------------------------
@@ -1239,6 +1454,41 @@ struct ImGuiMetricsConfig
     }
 };
 
+// Category of allocations made by MemAlloc() (see ImGuiMemCategoryScope), for allocation counters in Metrics
+enum ImGuiMemCategory_
+{
+    ImGuiMemCategory_Other,
+    ImGuiMemCategory_Window,
+    ImGuiMemCategory_DrawList,
+    ImGuiMemCategory_Table,
+    ImGuiMemCategory_InputText,
+    ImGuiMemCategory_Settings,
+    ImGuiMemCategory_Font,
+    ImGuiMemCategory_COUNT
+};
+
+// Heap allocation counters for one ImGuiMemCategory (frees are not tracked per category as MemFree() doesn't know the size or owner)
+struct ImGuiMemCategoryStats
+{
+    int         AllocCount;             // Since context creation
+    int         AllocCountThisFrame;
+    int         AllocCountLastFrame;
+    size_t      AllocBytes;             // Since context creation
+    size_t      AllocBytesThisFrame;
+    size_t      AllocBytesLastFrame;
+
+    ImGuiMemCategoryStats() { memset(this, 0, sizeof(*this)); }
+};
+
+// Heap allocation reported by the zero-allocation check (see DebugStartZeroAllocCheck())
+struct ImGuiDebugAllocReport
+{
+    int                 Frame;
+    ImGuiMemCategory    Category;
+    ImGuiID             WindowID;       // Current window when the allocation was made, if any
+    size_t              Size;
+};
+
 struct IMGUI_API ImGuiStackSizes
 {
     short   SizeOfIDStack;
@@ -1423,6 +1673,7 @@ struct ImGuiContext
     // Render
     float                   DimBgRatio;                         // 0.0..1.0 animation when fading in a dimming background (for modal window and CTRL+TAB list)
     ImGuiMouseCursor        MouseCursor;
+    unsigned int            DrawListContentGeneration;          // Last value assigned to ImDrawList::ContentGeneration
 
     // Drag and Drop
     bool                    DragDropActive;
@@ -1449,6 +1700,7 @@ struct ImGuiContext
     ImVector<ImGuiPtrOrIndex>       CurrentTableStack;
     ImVector<float>                 TablesLastTimeActive;       // Last used timestamp of each tables (SOA, for efficient GC)
     ImVector<ImDrawChannel>         DrawChannelsTempMergeBuffer;
+    ImVector<ImU32>                 TablesTempBitArrays;        // Scratch storage for bit arrays sized on columns/channels count (see TableMergeDrawChannels())
 
     // Tab bars
     ImGuiTabBar*                    CurrentTabBar;
@@ -1509,6 +1761,27 @@ struct ImGuiContext
     bool                    DebugItemPickerActive;              // Item picker is active (started with DebugStartItemPicker())
     ImGuiID                 DebugItemPickerBreakId;             // Will call IM_DEBUG_BREAK() when encountering this id
     ImGuiMetricsConfig      DebugMetricsConfig;
+    int                     DebugMetricsDrawCallsFrame;         // Frame in which ShowMetricsWindow() requested draw call counts: only then does Render() count them
+    int                     DebugMetricsDrawCalls;              // Set by Render(): number of draw commands in the draw data
+    int                     DebugMetricsDrawCallsMerged;        // Set by Render(): number of draw commands output by ImDrawData::MergeBuffers() with ImDrawDataMergeFlags_MergeCmds
+    int                     DebugMetricsDrawListsCount;         // Set by Render(): number of draw lists in the draw data
+    int                     DebugMetricsDrawListsUnchanged;     // Set by Render(): number of those with ContentUnchanged == true
+    bool                    DebugZeroAllocCheckActive;          // Report heap allocations made from frame DebugZeroAllocCheckStartFrame onward (see DebugStartZeroAllocCheck())
+    bool                    DebugZeroAllocCheckBreak;           // Call IM_DEBUG_BREAK() on those allocations
+    bool                    DebugZeroAllocCheckLog;             // Log those allocations with IMGUI_DEBUG_LOG()
+    int                     DebugZeroAllocCheckStartFrame;
+    int                     DebugZeroAllocCheckCount;           // Number of allocations reported since DebugStartZeroAllocCheck()
+    ImGuiDebugAllocReport   DebugZeroAllocCheckReports[16];     // Last reported allocations (circular buffer, fixed size so reporting doesn't allocate)
+
+    // Memory
+    ImGuiMemCategory        MemCategory;                        // Category of allocations made by MemAlloc() (see ImGuiMemCategoryScope)
+    ImGuiMemCategoryStats   MemStats[ImGuiMemCategory_COUNT];   // Heap allocation counters, per category
+    ImFrameArena            FrameArena;                         // Transient allocations made between PushFrameArenaAllocator() and PopFrameArenaAllocator(), released by NewFrame()
+    int                     FrameArenaAllocatorDepth;
+    const void*             MemOwnerThread;                     // Identifies the thread which called CreateContext(), then the one calling NewFrame(). MemAlloc()/MemFree() calls from other threads bypass all of the above.
+
+    // Text
+    ImGuiTextSizeCache      TextSizeCache;                      // Results of CalcTextSize() (io.ConfigTextSizeCache)
 
     // Misc
     float                   FramerateSecPerFrame[120];          // Calculate estimate of framerate for user over the last 2 seconds.
@@ -1517,6 +1790,9 @@ struct ImGuiContext
     int                     WantCaptureMouseNextFrame;          // Explicit capture via CaptureKeyboardFromApp()/CaptureMouseFromApp() sets those flags
     int                     WantCaptureKeyboardNextFrame;
     int                     WantTextInputNextFrame;
+    float                   WaitBeforeNextFrame;                // Lowest value passed to SetMaxWaitBeforeNextFrame() during the frame, see io.WaitBeforeNextFrame
+    ImU32                   WaitStateHash;                      // Hash of interaction state and window layout at the end of last frame
+    int                     WaitStableFrames;                   // Number of consecutive frames ended without inputs nor state changes
     char                    TempBuffer[1024 * 3 + 1];           // Temporary text buffer
 
     ImGuiContext(ImFontAtlas* shared_font_atlas)
@@ -1609,6 +1885,7 @@ struct ImGuiContext
 
         DimBgRatio = 0.0f;
         MouseCursor = ImGuiMouseCursor_Arrow;
+        DrawListContentGeneration = 0;
 
         DragDropActive = DragDropWithinSource = DragDropWithinTarget = false;
         DragDropSourceFlags = ImGuiDragDropFlags_None;
@@ -1657,11 +1934,23 @@ struct ImGuiContext
 
         DebugItemPickerActive = false;
         DebugItemPickerBreakId = 0;
+        DebugMetricsDrawCallsFrame = -1;
+        DebugMetricsDrawCalls = DebugMetricsDrawCallsMerged = DebugMetricsDrawListsCount = DebugMetricsDrawListsUnchanged = 0;
+        DebugZeroAllocCheckActive = DebugZeroAllocCheckBreak = DebugZeroAllocCheckLog = false;
+        DebugZeroAllocCheckStartFrame = DebugZeroAllocCheckCount = 0;
+        memset(DebugZeroAllocCheckReports, 0, sizeof(DebugZeroAllocCheckReports));
+
+        MemCategory = ImGuiMemCategory_Other;
+        FrameArenaAllocatorDepth = 0;
+        MemOwnerThread = NULL;
 
         memset(FramerateSecPerFrame, 0, sizeof(FramerateSecPerFrame));
         FramerateSecPerFrameIdx = 0;
         FramerateSecPerFrameAccum = 0.0f;
         WantCaptureMouseNextFrame = WantCaptureKeyboardNextFrame = WantTextInputNextFrame = -1;
+        WaitBeforeNextFrame = FLT_MAX;
+        WaitStateHash = 0;
+        WaitStableFrames = 0;
         memset(TempBuffer, 0, sizeof(TempBuffer));
     }
 };
@@ -1806,6 +2095,7 @@ struct IMGUI_API ImGuiWindow
 
     ImDrawList*             DrawList;                           // == &DrawListInst (for backward compatibility reason with code using imgui_internal.h we keep this a pointer)
     ImDrawList              DrawListInst;
+    ImDrawListRetained      DrawListRetained;                   // Retained geometry of DrawListInst (ImGuiWindowFlags_RetainGeometry)
     ImGuiWindow*            ParentWindow;                       // If we are a child _or_ popup window, this is pointing to our parent. Otherwise NULL.
     ImGuiWindow*            RootWindow;                         // Point to ourself or first ancestor that is not a child window == Top-level window.
     ImGuiWindow*            RootWindowForTitleBarHighlight;     // Point to ourself or first ancestor which will display TitleBgActive color when this window is active.
@@ -1941,12 +2231,12 @@ struct ImGuiTabBar
 #ifdef IMGUI_HAS_TABLE
 
 #define IM_COL32_DISABLE                IM_COL32(0,0,0,1)   // Special sentinel code which cannot be used as a regular color.
-#define IMGUI_TABLE_MAX_COLUMNS         64                  // sizeof(ImU64) * 8. This is solely because we frequently encode columns set in a ImU64.
-#define IMGUI_TABLE_MAX_DRAW_CHANNELS   (4 + 64 * 2)        // See TableSetupDrawChannels()
+#define IMGUI_TABLE_MAX_COLUMNS         2048                // Column sets are stored as ImBitArrayPtr sized on ColumnsCount. May be further lifted (up to ~32K with 16-bit indices).
+#define IMGUI_TABLE_MAX_DRAW_CHANNELS   (4 + IMGUI_TABLE_MAX_COLUMNS * 2) // See TableSetupDrawChannels()
 
-// Our current column maximum is 64 but we may raise that in the future.
-typedef ImS8 ImGuiTableColumnIdx;
-typedef ImU8 ImGuiTableDrawChannelIdx;
+// Our current column maximum is 2048, indices are stored on 16-bit.
+typedef ImS16 ImGuiTableColumnIdx;
+typedef ImU16 ImGuiTableDrawChannelIdx;
 
 // [Internal] sizeof() ~ 104
 // We use the terminology "Enabled" to refer to a column that is not Hidden by user/api.
@@ -2004,7 +2294,7 @@ struct ImGuiTableColumn
         PrevEnabledColumn = NextEnabledColumn = -1;
         SortOrder = -1;
         SortDirection = ImGuiSortDirection_None;
-        DrawChannelCurrent = DrawChannelFrozen = DrawChannelUnfrozen = (ImU8)-1;
+        DrawChannelCurrent = DrawChannelFrozen = DrawChannelUnfrozen = (ImGuiTableDrawChannelIdx)-1;
     }
 };
 
@@ -2021,14 +2311,14 @@ struct ImGuiTable
 {
     ImGuiID                     ID;
     ImGuiTableFlags             Flags;
-    void*                       RawData;                    // Single allocation to hold Columns[], DisplayOrderToIndex[] and RowCellData[]
+    void*                       RawData;                    // Single allocation to hold Columns[], DisplayOrderToIndex[], RowCellData[] and the column bit arrays below
     ImSpan<ImGuiTableColumn>    Columns;                    // Point within RawData[]
     ImSpan<ImGuiTableColumnIdx> DisplayOrderToIndex;        // Point within RawData[]. Store display order of columns (when not reordered, the values are 0...Count-1)
     ImSpan<ImGuiTableCellData>  RowCellData;                // Point within RawData[]. Store cells background requests for current row.
-    ImU64                       EnabledMaskByDisplayOrder;  // Column DisplayOrder -> IsEnabled map
-    ImU64                       EnabledMaskByIndex;         // Column Index -> IsEnabled map (== not hidden by user/api) in a format adequate for iterating column without touching cold data
-    ImU64                       VisibleMaskByIndex;         // Column Index -> IsVisibleX|IsVisibleY map (== not hidden by user/api && not hidden by scrolling/cliprect)
-    ImU64                       RequestOutputMaskByIndex;   // Column Index -> IsVisible || AutoFit (== expect user to submit items)
+    ImBitArrayPtr               EnabledMaskByDisplayOrder;  // Point within RawData[]. Column DisplayOrder -> IsEnabled map
+    ImBitArrayPtr               EnabledMaskByIndex;         // Point within RawData[]. Column Index -> IsEnabled map (== not hidden by user/api) in a format adequate for iterating column without touching cold data
+    ImBitArrayPtr               VisibleMaskByIndex;         // Point within RawData[]. Column Index -> IsVisibleX|IsVisibleY map (== not hidden by user/api && not hidden by scrolling/cliprect)
+    ImBitArrayPtr               RequestOutputMaskByIndex;   // Point within RawData[]. Column Index -> IsVisible || AutoFit (== expect user to submit items)
     ImGuiTableFlags             SettingsLoadedFlags;        // Which data were loaded from the .ini file (e.g. when order is not altered we won't save order)
     int                         SettingsOffset;             // Offset in g.SettingsTables
     int                         LastFrameActive;
@@ -2092,6 +2382,8 @@ struct ImGuiTable
     ImGuiTableSortSpecs         SortSpecs;                  // Public facing sorts specs, this is what we return in TableGetSortSpecs()
     ImGuiTableColumnIdx         SortSpecsCount;
     ImGuiTableColumnIdx         ColumnsEnabledCount;        // Number of enabled columns (<= ColumnsCount)
+    ImGuiTableColumnIdx         ColumnsVisibleCount;        // Number of visible columns (<= ColumnsEnabledCount). Only those get their own draw channels.
+    ImGuiTableColumnIdx         ColumnsVisibleCountMax;     // Largest ColumnsVisibleCount seen, draw channels are allocated for that many columns.
     ImGuiTableColumnIdx         ColumnsEnabledFixedCount;   // Number of enabled columns (<= ColumnsCount)
     ImGuiTableColumnIdx         DeclColumnsCount;           // Count calls to TableSetupColumn()
     ImGuiTableColumnIdx         HoveredColumnBody;          // Index of column whose visible region is being hovered. Important: == ColumnsCount when hovering empty region after the right-most column!
@@ -2135,7 +2427,7 @@ struct ImGuiTable
     IMGUI_API ~ImGuiTable()     { IM_FREE(RawData); }
 };
 
-// sizeof() ~ 12
+// sizeof() ~ 16
 struct ImGuiTableColumnSettings
 {
     float                   WidthOrWeight;
@@ -2211,6 +2503,7 @@ namespace ImGui
 
     // Fonts, drawing
     IMGUI_API void          SetCurrentFont(ImFont* font);
+    IMGUI_API void          ClearTextSizeCache();
     inline ImFont*          GetDefaultFont() { ImGuiContext& g = *GImGui; return g.IO.FontDefault ? g.IO.FontDefault : g.IO.Fonts->Fonts[0]; }
     inline ImDrawList*      GetForegroundDrawList(ImGuiWindow* window) { IM_UNUSED(window); return GetForegroundDrawList(); } // This seemingly unnecessary wrapper simplifies compatibility between the 'master' and 'docking' branches.
     IMGUI_API ImDrawList*   GetBackgroundDrawList(ImGuiViewport* viewport);                     // get background draw list for the given viewport. this draw list will be the first rendering one. Useful to quickly draw shapes/text behind dear imgui contents.
@@ -2373,6 +2666,7 @@ namespace ImGui
     IMGUI_API void          TableDrawBorders(ImGuiTable* table);
     IMGUI_API void          TableDrawContextMenu(ImGuiTable* table);
     IMGUI_API void          TableMergeDrawChannels(ImGuiTable* table);
+    IMGUI_API void          TableRestoreDrawChannels(ImGuiTable* table);
     IMGUI_API void          TableSortSpecsSanitize(ImGuiTable* table);
     IMGUI_API void          TableSortSpecsBuild(ImGuiTable* table);
     IMGUI_API ImGuiSortDirection TableGetColumnNextSortDirection(ImGuiTableColumn* column);
@@ -2504,6 +2798,15 @@ namespace ImGui
     IMGUI_API void          ShadeVertsLinearColorGradientKeepAlpha(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, ImVec2 gradient_p0, ImVec2 gradient_p1, ImU32 col0, ImU32 col1);
     IMGUI_API void          ShadeVertsLinearUV(ImDrawList* draw_list, int vert_start_idx, int vert_end_idx, const ImVec2& a, const ImVec2& b, const ImVec2& uv_a, const ImVec2& uv_b, bool clamp);
 
+    // Memory
+    // - Heap allocations made by MemAlloc() are counted per category (see ImGuiMemCategoryScope), displayed in Metrics->Memory.
+    // - Between PushFrameArenaAllocator() and PopFrameArenaAllocator(), MemAlloc() returns memory from g.FrameArena which is released by the next NewFrame(),
+    //   and MemFree() of that memory does nothing. Only use it to create temporary buffers: growing a persistent ImVector<> in this scope would leave it dangling!
+    IMGUI_API ImGuiMemCategory SetMemCategory(ImGuiMemCategory category);  // Return previous category
+    IMGUI_API const char*   GetMemCategoryName(ImGuiMemCategory category);
+    IMGUI_API void          PushFrameArenaAllocator();
+    IMGUI_API void          PopFrameArenaAllocator();
+
     // Garbage collection
     IMGUI_API void          GcCompactTransientMiscBuffers();
     IMGUI_API void          GcCompactTransientWindowBuffers(ImGuiWindow* window);
@@ -2513,10 +2816,13 @@ namespace ImGui
     IMGUI_API void          ErrorCheckEndFrameRecover(ImGuiErrorLogCallback log_callback, void* user_data = NULL);
     inline void             DebugDrawItemRect(ImU32 col = IM_COL32(255,0,0,255))    { ImGuiContext& g = *GImGui; ImGuiWindow* window = g.CurrentWindow; GetForegroundDrawList(window)->AddRect(window->DC.LastItemRect.Min, window->DC.LastItemRect.Max, col); }
     inline void             DebugStartItemPicker()                                  { ImGuiContext& g = *GImGui; g.DebugItemPickerActive = true; }
+    IMGUI_API void          DebugStartZeroAllocCheck(int warmup_frames = 0, bool break_on_alloc = true, bool log_allocs = true);   // Report heap allocations made by MemAlloc() once 'warmup_frames' more frames have started.
+    inline void             DebugStopZeroAllocCheck()                               { ImGuiContext& g = *GImGui; g.DebugZeroAllocCheckActive = false; }
 
     IMGUI_API void          DebugNodeColumns(ImGuiOldColumns* columns);
     IMGUI_API void          DebugNodeDrawList(ImGuiWindow* window, const ImDrawList* draw_list, const char* label);
     IMGUI_API void          DebugNodeDrawCmdShowMeshAndBoundingBox(ImDrawList* out_draw_list, const ImDrawList* draw_list, const ImDrawCmd* draw_cmd, bool show_mesh, bool show_aabb);
+    IMGUI_API void          DebugNodeMemoryBuffers();
     IMGUI_API void          DebugNodeStorage(ImGuiStorage* storage, const char* label);
     IMGUI_API void          DebugNodeTabBar(ImGuiTabBar* tab_bar, const char* label);
     IMGUI_API void          DebugNodeTable(ImGuiTable* table);
@@ -2529,6 +2835,14 @@ namespace ImGui
 
 } // namespace ImGui
 
+// Helper: set the category of allocations made by MemAlloc() until the end of the scope
+struct ImGuiMemCategoryScope
+{
+    ImGuiMemCategory    BackupCategory;
+    ImGuiMemCategoryScope(ImGuiMemCategory category)    { BackupCategory = ImGui::SetMemCategory(category); }
+    ~ImGuiMemCategoryScope()                            { ImGui::SetMemCategory(BackupCategory); }
+};
+
 
 //-----------------------------------------------------------------------------
 // [SECTION] ImFontAtlas internal API
@@ -2551,6 +2865,69 @@ IMGUI_API void      ImFontAtlasBuildRender32bppRectFromString(ImFontAtlas* atlas
 IMGUI_API void      ImFontAtlasBuildMultiplyCalcLookupTable(unsigned char out_table[256], float in_multiply_factor);
 IMGUI_API void      ImFontAtlasBuildMultiplyRectAlpha8(const unsigned char table[256], unsigned char* pixels, int x, int y, int w, int h, int stride);
 
+// Glyph cache for ImFontAtlasFlags_DynamicGlyphs
+// - Build() only rasterizes glyphs up to IM_FONTGLYPH_CACHE_PRELOAD_MAX. Other glyphs available in the requested ranges are marked as
+//   IM_FONTGLYPH_INDEX_NOT_LOADED in ImFont::IndexLookup[]. ImFont::FindGlyph() queues them (-> IM_FONTGLYPH_INDEX_QUEUED) and returns the fallback glyph.
+// - ImFontAtlas::UpdateGlyphCache() rasterizes queued glyphs into square cells allocated on shelves (rows of cells of the same size) in
+//   the texture area reserved below the packed glyphs. When the area is full, the least recently used cell of a compatible size is
+//   recycled, as long as its glyph hasn't been used in the last frame.
+#define IM_FONTGLYPH_CACHE_PRELOAD_MAX  0xFF                // Glyphs up to this codepoint are always rasterized by Build()
+#define IM_FONTGLYPH_INDEX_NOT_LOADED   ((ImWchar)-2)       // ImFont::IndexLookup[] value for a glyph available in the font but not rasterized yet
+#define IM_FONTGLYPH_INDEX_QUEUED       ((ImWchar)-3)       // ImFont::IndexLookup[] value for a glyph queued for rasterization
+
+struct ImFontAtlasGlyphCacheSrc
+{
+    const ImFontConfig* Config;             // Pointer within ImFontAtlas::ConfigData[]
+    void*               FontInfo;           // stbtt_fontinfo*
+};
+
+struct ImFontAtlasGlyphCacheRequest
+{
+    const ImFont*       Font;
+    ImWchar             Codepoint;
+};
+
+struct ImFontAtlasGlyphCacheShelf
+{
+    unsigned short      Y;                  // Top of the shelf in the texture
+    unsigned short      CellSize;           // Height of the shelf = width and height of its cells
+    unsigned short      CursorX;            // Position of next cell to allocate
+};
+
+struct ImFontAtlasGlyphCacheCell
+{
+    unsigned short      X, Y, Size;
+    ImFont*             Font;               // Font owning the glyph stored in this cell
+    int                 GlyphIndex;         // Index into Font->Glyphs[]
+};
+
+struct ImFontAtlasGlyphCacheSlot
+{
+    ImFont*             Font;
+    int                 GlyphIndex;
+};
+
+struct ImFontAtlasGlyphCache
+{
+    ImVector<ImFontAtlasGlyphCacheSrc>      Sources;        // One per ImFontAtlas::ConfigData[] entry
+    ImVector<ImFontAtlasGlyphCacheRequest>  Requests;       // Glyphs queued by ImFont::FindGlyph()
+    ImVector<ImFontAtlasGlyphCacheShelf>    Shelves;
+    ImVector<ImFontAtlasGlyphCacheCell>     Cells;
+    ImVector<ImFontAtlasGlyphCacheSlot>     FreeSlots;      // Unused ImFont::Glyphs[] entries left by evicting a glyph of another font
+    int                 AreaY0, AreaY1;     // Texture rows reserved for the cache
+    int                 ShelvesY;           // Top of the unused space below the last shelf
+    int                 FrameCount;         // Incremented by UpdateGlyphCache(), stamped into ImFont::GlyphsLastUsedFrame[]
+    int                 GlyphsLoadedCount;  // Statistics (since Build())
+    int                 GlyphsEvictedCount;
+    int                 GlyphsFailedCount;  // Rasterization requests that couldn't find space (all candidate cells in use)
+
+    ImFontAtlasGlyphCache() { AreaY0 = AreaY1 = ShelvesY = 0; FrameCount = 0; GlyphsLoadedCount = GlyphsEvictedCount = GlyphsFailedCount = 0; }
+};
+
+IMGUI_API void      ImFontAtlasGlyphCacheDestroy(ImFontAtlas* atlas);
+IMGUI_API void      ImFontAtlasGlyphCacheQueueGlyph(ImFontAtlas* atlas, const ImFont* font, ImWchar c);
+IMGUI_API void      ImFontAtlasGlyphCacheUpdateFontLookup(ImFontAtlas* atlas, ImFont* font);
+
 //-----------------------------------------------------------------------------
 // [SECTION] Test Engine specific hooks (imgui_test_engine)
 //-----------------------------------------------------------------------------
@@ -57,6 +57,7 @@ Index of this file:
 //    | TableEndRow()                           - finish existing row
 //    | TableBeginRow()                         - add a new row
 // - TableSetColumnIndex() / TableNextColumn()  user begin into a cell
+//   or TableNextVisibleColumn()                (skipping clipped/hidden columns)
 //    | TableEndCell()                          - close existing column/cell
 //    | TableBeginCell()                        - enter into current column/cell
 // - [...]                                      user emit contents
@@ -64,6 +65,7 @@ Index of this file:
 // - EndTable()                                 user ends the table
 //    | TableDrawBorders()                      - draw outer borders, inner vertical borders
 //    | TableMergeDrawChannels()                - merge draw channels if clipping isn't required
+//    | TableRestoreDrawChannels()              - put reordered draw channels back in place so they keep their buffers
 //    | EndChild()                              - (if ScrollX/ScrollY is set)
 //-----------------------------------------------------------------------------
 
@@ -174,6 +176,9 @@ Index of this file:
 //
 // - We need distinguish those cases because non-hidden columns that are clipped outside of scrolling bounds should still contribute their height to the row.
 //   However, in the majority of cases, the contribution to row height is the same for all columns, or the tallest cells are known by the programmer.
+// - For tables with many columns (up to IMGUI_TABLE_MAX_COLUMNS) and ScrollX, TableNextVisibleColumn() only visits columns
+//   in cases [A] (or columns measuring their width), so that the cost of submitting a row scales with visible columns.
+//   Columns not in sight don't get their own draw channel, so draw channels merging also scales with visible columns.
 //-----------------------------------------------------------------------------
 // About clipping/culling of whole Tables:
 // - Scrolling tables with a known outer size can be clipped earlier as BeginTable() will return false.
@@ -299,12 +304,13 @@ bool    ImGui::BeginTable(const char* str_id, int columns_count, ImGuiTableFlags
 bool    ImGui::BeginTableEx(const char* name, ImGuiID id, int columns_count, ImGuiTableFlags flags, const ImVec2& outer_size, float inner_width)
 {
     ImGuiContext& g = *GImGui;
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Table);
     ImGuiWindow* outer_window = GetCurrentWindow();
     if (outer_window->SkipItems) // Consistent with other tables + beneficial side effect that assert on miscalling EndTable() will be more visible.
         return false;
 
     // Sanity checks
-    IM_ASSERT(columns_count > 0 && columns_count <= IMGUI_TABLE_MAX_COLUMNS && "Only 1..64 columns allowed!");
+    IM_ASSERT(columns_count > 0 && columns_count <= IMGUI_TABLE_MAX_COLUMNS && "Only 1..IMGUI_TABLE_MAX_COLUMNS columns allowed!");
     if (flags & ImGuiTableFlags_ScrollX)
         IM_ASSERT(inner_width >= 0.0f);
 
@@ -537,16 +543,24 @@ bool    ImGui::BeginTableEx(const char* name, ImGuiID id, int columns_count, ImG
 void ImGui::TableBeginInitMemory(ImGuiTable* table, int columns_count)
 {
     // Allocate single buffer for our arrays
-    ImSpanAllocator<3> span_allocator;
+    // (4-byte aligned spans first: ImGuiTableColumnIdx is 16-bit so DisplayOrderToIndex[] goes last)
+    ImSpanAllocator<7> span_allocator;
     span_allocator.ReserveBytes(0, columns_count * sizeof(ImGuiTableColumn));
-    span_allocator.ReserveBytes(1, columns_count * sizeof(ImGuiTableColumnIdx));
-    span_allocator.ReserveBytes(2, columns_count * sizeof(ImGuiTableCellData));
+    span_allocator.ReserveBytes(1, columns_count * sizeof(ImGuiTableCellData));
+    for (int n = 2; n < 6; n++)
+        span_allocator.ReserveBytes(n, ImBitArrayGetStorageSizeInBytes(columns_count));
+    span_allocator.ReserveBytes(6, columns_count * sizeof(ImGuiTableColumnIdx));
     table->RawData = IM_ALLOC(span_allocator.GetArenaSizeInBytes());
     memset(table->RawData, 0, span_allocator.GetArenaSizeInBytes());
+    table->ColumnsVisibleCountMax = 0;
     span_allocator.SetArenaBasePtr(table->RawData);
     span_allocator.GetSpan(0, &table->Columns);
-    span_allocator.GetSpan(1, &table->DisplayOrderToIndex);
-    span_allocator.GetSpan(2, &table->RowCellData);
+    span_allocator.GetSpan(1, &table->RowCellData);
+    table->EnabledMaskByDisplayOrder = (ImBitArrayPtr)span_allocator.GetSpanPtrBegin(2);
+    table->EnabledMaskByIndex = (ImBitArrayPtr)span_allocator.GetSpanPtrBegin(3);
+    table->VisibleMaskByIndex = (ImBitArrayPtr)span_allocator.GetSpanPtrBegin(4);
+    table->RequestOutputMaskByIndex = (ImBitArrayPtr)span_allocator.GetSpanPtrBegin(5);
+    span_allocator.GetSpan(6, &table->DisplayOrderToIndex);
 }
 
 // Apply queued resizing/reordering/hiding requests
@@ -685,8 +699,8 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
     const ImGuiTableFlags table_sizing_policy = (table->Flags & ImGuiTableFlags_SizingMask_);
     table->IsDefaultDisplayOrder = true;
     table->ColumnsEnabledCount = 0;
-    table->EnabledMaskByIndex = 0x00;
-    table->EnabledMaskByDisplayOrder = 0x00;
+    ImBitArrayClearAllBits(table->EnabledMaskByIndex, table->ColumnsCount);
+    ImBitArrayClearAllBits(table->EnabledMaskByDisplayOrder, table->ColumnsCount);
     table->LeftMostEnabledColumn = -1;
     table->MinColumnWidth = ImMax(1.0f, g.Style.FramePadding.x * 1.0f); // g.Style.ColumnsMinSpacing; // FIXME-TABLE
 
@@ -749,8 +763,8 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
         else
             table->LeftMostEnabledColumn = (ImGuiTableColumnIdx)column_n;
         column->IndexWithinEnabledSet = table->ColumnsEnabledCount++;
-        table->EnabledMaskByIndex |= (ImU64)1 << column_n;
-        table->EnabledMaskByDisplayOrder |= (ImU64)1 << column->DisplayOrder;
+        ImBitArraySetBit(table->EnabledMaskByIndex, column_n);
+        ImBitArraySetBit(table->EnabledMaskByDisplayOrder, column->DisplayOrder);
         prev_visible_column_idx = column_n;
         IM_ASSERT(column->IndexWithinEnabledSet <= column->DisplayOrder);
 
@@ -798,7 +812,7 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
     table->LeftMostStretchedColumn = table->RightMostStretchedColumn = -1;
     for (int column_n = 0; column_n < table->ColumnsCount; column_n++)
     {
-        if (!(table->EnabledMaskByIndex & ((ImU64)1 << column_n)))
+        if (!ImBitArrayTestBit(table->EnabledMaskByIndex, column_n))
             continue;
         ImGuiTableColumn* column = &table->Columns[column_n];
 
@@ -814,7 +828,7 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
             // Latch initial size for fixed columns and update it constantly for auto-resizing column (unless clipped!)
             if (column->AutoFitQueue != 0x00)
                 column->WidthRequest = width_auto;
-            else if ((column->Flags & ImGuiTableColumnFlags_WidthFixed) && !column_is_resizable && (table->RequestOutputMaskByIndex & ((ImU64)1 << column_n)))
+            else if ((column->Flags & ImGuiTableColumnFlags_WidthFixed) && !column_is_resizable && ImBitArrayTestBit(table->RequestOutputMaskByIndex, column_n))
                 column->WidthRequest = width_auto;
 
             // FIXME-TABLE: Increase minimum size during init frame to avoid biasing auto-fitting widgets
@@ -860,7 +874,7 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
     table->ColumnsGivenWidth = width_spacings + (table->CellPaddingX * 2.0f) * table->ColumnsEnabledCount;
     for (int column_n = 0; column_n < table->ColumnsCount; column_n++)
     {
-        if (!(table->EnabledMaskByIndex & ((ImU64)1 << column_n)))
+        if (!ImBitArrayTestBit(table->EnabledMaskByIndex, column_n))
             continue;
         ImGuiTableColumn* column = &table->Columns[column_n];
 
@@ -887,7 +901,7 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
     if (width_remaining_for_stretched_columns >= 1.0f && !(table->Flags & ImGuiTableFlags_PreciseWidths))
         for (int order_n = table->ColumnsCount - 1; stretch_sum_weights > 0.0f && width_remaining_for_stretched_columns >= 1.0f && order_n >= 0; order_n--)
         {
-            if (!(table->EnabledMaskByDisplayOrder & ((ImU64)1 << order_n)))
+            if (!ImBitArrayTestBit(table->EnabledMaskByDisplayOrder, order_n))
                 continue;
             ImGuiTableColumn* column = &table->Columns[table->DisplayOrderToIndex[order_n]];
             if (!(column->Flags & ImGuiTableColumnFlags_WidthStretch))
@@ -909,8 +923,9 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
     float offset_x = ((table->FreezeColumnsCount > 0) ? table->OuterRect.Min.x : work_rect.Min.x) + table->OuterPaddingX - table->CellSpacingX1;
     ImRect host_clip_rect = table->InnerClipRect;
     //host_clip_rect.Max.x += table->CellPaddingX + table->CellSpacingX2;
-    table->VisibleMaskByIndex = 0x00;
-    table->RequestOutputMaskByIndex = 0x00;
+    table->ColumnsVisibleCount = 0;
+    ImBitArrayClearAllBits(table->VisibleMaskByIndex, table->ColumnsCount);
+    ImBitArrayClearAllBits(table->RequestOutputMaskByIndex, table->ColumnsCount);
     for (int order_n = 0; order_n < table->ColumnsCount; order_n++)
     {
         const int column_n = table->DisplayOrderToIndex[order_n];
@@ -927,7 +942,7 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
         // Clear status flags
         column->Flags &= ~ImGuiTableColumnFlags_StatusMask_;
 
-        if ((table->EnabledMaskByDisplayOrder & ((ImU64)1 << order_n)) == 0)
+        if (!ImBitArrayTestBit(table->EnabledMaskByDisplayOrder, order_n))
         {
             // Hidden column: clear a few fields and we are done with it for the remainder of the function.
             // We set a zero-width clip rect but set Min.y/Max.y properly to not interfere with the clipper.
@@ -980,12 +995,15 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
         column->IsVisibleY = true; // (column->ClipRect.Max.y > column->ClipRect.Min.y);
         const bool is_visible = column->IsVisibleX; //&& column->IsVisibleY;
         if (is_visible)
-            table->VisibleMaskByIndex |= ((ImU64)1 << column_n);
+        {
+            ImBitArraySetBit(table->VisibleMaskByIndex, column_n);
+            table->ColumnsVisibleCount++;
+        }
 
         // Mark column as requesting output from user. Note that fixed + non-resizable sets are auto-fitting at all times and therefore always request output.
         column->IsRequestOutput = is_visible || column->AutoFitQueue != 0 || column->CannotSkipItemsQueue != 0;
         if (column->IsRequestOutput)
-            table->RequestOutputMaskByIndex |= ((ImU64)1 << column_n);
+            ImBitArraySetBit(table->RequestOutputMaskByIndex, column_n);
 
         // Mark column as SkipItems (ignoring all items/layout)
         column->IsSkipItems = !column->IsEnabled || table->HostSkipItems;
@@ -1020,6 +1038,8 @@ void ImGui::TableUpdateLayout(ImGuiTable* table)
             column->AutoFitQueue >>= 1;
             column->CannotSkipItemsQueue >>= 1;
         }
+        if (column->AutoFitQueue != 0 || column->CannotSkipItemsQueue != 0)
+            SetMaxWaitBeforeNextFrame(0.0f);
 
         if (visible_n < table->FreezeColumnsCount)
             host_clip_rect.Min.x = ImClamp(column->MaxX + TABLE_BORDER_SIZE, host_clip_rect.Min.x, host_clip_rect.Max.x);
@@ -1112,7 +1132,7 @@ void ImGui::TableUpdateBorders(ImGuiTable* table)
 
     for (int order_n = 0; order_n < table->ColumnsCount; order_n++)
     {
-        if (!(table->EnabledMaskByDisplayOrder & ((ImU64)1 << order_n)))
+        if (!ImBitArrayTestBit(table->EnabledMaskByDisplayOrder, order_n))
             continue;
 
         const int column_n = table->DisplayOrderToIndex[order_n];
@@ -1129,7 +1149,10 @@ void ImGui::TableUpdateBorders(ImGuiTable* table)
             if (column->MaxX < table->Columns[table->DisplayOrderToIndex[table->FreezeColumnsCount - 1]].MaxX)
                 continue;
 
+        // Skip columns scrolled out of view (unless being resized) so hit-testing scales with visible columns
         ImGuiID column_id = TableGetColumnResizeID(table, column_n, table->InstanceCurrent);
+        if (!column->IsVisibleX && g.ActiveId != column_id)
+            continue;
         ImRect hit_rect(column->MaxX - hit_half_width, hit_y1, column->MaxX + hit_half_width, border_y2_hit);
         //GetForegroundDrawList()->AddRect(hit_rect.Min, hit_rect.Max, IM_COL32(255, 0, 0, 100));
         KeepAliveID(column_id);
@@ -1160,6 +1183,7 @@ void ImGui::TableUpdateBorders(ImGuiTable* table)
 void    ImGui::EndTable()
 {
     ImGuiContext& g = *GImGui;
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Table);
     ImGuiTable* table = g.CurrentTable;
     IM_ASSERT(table != NULL && "Only call EndTable() if BeginTable() returns true!");
 
@@ -1227,7 +1251,7 @@ void    ImGui::EndTable()
     // We have no way to prevent user submitting direct ImDrawList calls into a hidden column (but ImGui:: calls will be clipped out)
     // Pros: remove draw calls which will have no effect. since they'll have zero-size cliprect they may be early out anyway.
     // Cons: making it harder for users watching metrics/debugger to spot the wasted vertices.
-    if (table->DummyDrawChannel != (ImGuiTableColumnIdx)-1)
+    if (table->DummyDrawChannel != (ImGuiTableDrawChannelIdx)-1)
     {
         ImDrawChannel* dummy_channel = &table->DrawSplitter._Channels[table->DummyDrawChannel];
         dummy_channel->_CmdBuffer.resize(0);
@@ -1240,12 +1264,13 @@ void    ImGui::EndTable()
     if ((table->Flags & ImGuiTableFlags_NoClip) == 0)
         TableMergeDrawChannels(table);
     table->DrawSplitter.Merge(inner_window->DrawList);
+    TableRestoreDrawChannels(table);
 
     // Update ColumnsAutoFitWidth to get us ahead for host using our size to auto-resize without waiting for next BeginTable()
     const float width_spacings = (table->OuterPaddingX * 2.0f) + (table->CellSpacingX1 + table->CellSpacingX2) * (table->ColumnsEnabledCount - 1);
     table->ColumnsAutoFitWidth = width_spacings + (table->CellPaddingX * 2.0f) * table->ColumnsEnabledCount;
     for (int column_n = 0; column_n < table->ColumnsCount; column_n++)
-        if (table->EnabledMaskByIndex & ((ImU64)1 << column_n))
+        if (ImBitArrayTestBit(table->EnabledMaskByIndex, column_n))
         {
             ImGuiTableColumn* column = &table->Columns[column_n];
             if ((column->Flags & ImGuiTableColumnFlags_WidthFixed) && !(column->Flags & ImGuiTableColumnFlags_NoResize))
@@ -1354,6 +1379,7 @@ void    ImGui::EndTable()
 void ImGui::TableSetupColumn(const char* label, ImGuiTableColumnFlags flags, float init_width_or_weight, ImGuiID user_id)
 {
     ImGuiContext& g = *GImGui;
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Table);
     ImGuiTable* table = g.CurrentTable;
     IM_ASSERT(table != NULL && "Need to call TableSetupColumn() after BeginTable()!");
     IM_ASSERT(table->IsLayoutLocked == false && "Need to call call TableSetupColumn() before first row!");
@@ -1545,7 +1571,7 @@ void ImGui::TableSetBgColor(ImGuiTableBgTarget target, ImU32 color, int column_n
             return;
         if (column_n == -1)
             column_n = table->CurrentColumn;
-        if ((table->VisibleMaskByIndex & ((ImU64)1 << column_n)) == 0)
+        if (!ImBitArrayTestBit(table->VisibleMaskByIndex, column_n))
             return;
         if (table->RowCellDataCurrent < 0 || table->RowCellData[table->RowCellDataCurrent].Column != column_n)
             table->RowCellDataCurrent++;
@@ -1787,6 +1813,7 @@ void ImGui::TableEndRow(ImGuiTable* table)
 // - TableGetColumnIndex()
 // - TableSetColumnIndex()
 // - TableNextColumn()
+// - TableNextVisibleColumn()
 // - TableBeginCell() [Internal]
 // - TableEndCell() [Internal]
 //-------------------------------------------------------------------------
@@ -1818,7 +1845,7 @@ bool ImGui::TableSetColumnIndex(int column_n)
 
     // Return whether the column is visible. User may choose to skip submitting items based on this return value,
     // however they shouldn't skip submitting for columns that may have the tallest contribution to row height.
-    return (table->RequestOutputMaskByIndex & ((ImU64)1 << column_n)) != 0;
+    return ImBitArrayTestBit(table->RequestOutputMaskByIndex, column_n);
 }
 
 // [Public] Append into the next column, wrap and create a new row when already on last column
@@ -1844,7 +1871,26 @@ bool ImGui::TableNextColumn()
     // Return whether the column is visible. User may choose to skip submitting items based on this return value,
     // however they shouldn't skip submitting for columns that may have the tallest contribution to row height.
     int column_n = table->CurrentColumn;
-    return (table->RequestOutputMaskByIndex & ((ImU64)1 << column_n)) != 0;
+    return ImBitArrayTestBit(table->RequestOutputMaskByIndex, column_n);
+}
+
+// [Public] Append into the next column requesting output in the current row (in index order)
+// Columns clipped by horizontal scrolling or hidden are skipped without being entered, scanning 32 columns at a time.
+bool ImGui::TableNextVisibleColumn()
+{
+    ImGuiContext& g = *GImGui;
+    ImGuiTable* table = g.CurrentTable;
+    if (!table)
+        return false;
+    IM_ASSERT(table->IsInsideRow && "Need to call TableNextRow() before TableNextVisibleColumn()!");
+
+    const int column_n = ImBitArrayFindNextSetBit(table->RequestOutputMaskByIndex, table->CurrentColumn + 1, table->ColumnsCount);
+    if (column_n == -1)
+        return false;
+    if (table->CurrentColumn != -1)
+        TableEndCell(table);
+    TableBeginCell(table, column_n);
+    return true;
 }
 
 
@@ -2129,6 +2175,7 @@ void ImGui::TableUpdateColumnsWeightFromWidth(ImGuiTable* table)
 // - TablePopBackgroundChannel() [Internal]
 // - TableSetupDrawChannels() [Internal]
 // - TableMergeDrawChannels() [Internal]
+// - TableRestoreDrawChannels() [Internal]
 // - TableDrawBorders() [Internal]
 //-------------------------------------------------------------------------
 
@@ -2161,6 +2208,8 @@ void ImGui::TablePopBackgroundChannel()
 // Allocate draw channels. Called by TableUpdateLayout()
 // - We allocate them following storage order instead of display order so reordering columns won't needlessly
 //   increase overall dormant memory cost.
+// - We only allocate channels for visible columns: columns clipped by horizontal scrolling or hidden share the dummy
+//   channel, so the channel count (and merging cost) scales with visible rather than total columns.
 // - We isolate headers draw commands in their own channels instead of just altering clip rects.
 //   This is in order to facilitate merging of draw commands.
 // - After crossing FreezeRowsCount, all columns see their current draw channel changed to a second set of channels.
@@ -2173,13 +2222,16 @@ void ImGui::TablePopBackgroundChannel()
 // - Clip                         --> 2+D+N channels
 // - FreezeRows                   --> 2+D+N*2 (unless scrolling value is zero)
 // - FreezeRows || FreezeColunns  --> 3+D+N*2 (unless scrolling value is zero)
-// Where D is 1 if any column is clipped or hidden (dummy channel) otherwise 0.
+// Where N is the number of visible columns and D is 1 if any column is clipped or hidden (dummy channel) otherwise 0.
 void ImGui::TableSetupDrawChannels(ImGuiTable* table)
 {
     const int freeze_row_multiplier = (table->FreezeRowsCount > 0) ? 2 : 1;
-    const int channels_for_row = (table->Flags & ImGuiTableFlags_NoClip) ? 1 : table->ColumnsEnabledCount;
+    // Allocate row channels for the largest visible columns count seen so far rather than the current one, which varies when
+    // scrolling horizontally: a stable layout lets each channel reuse the buffers it had on previous frames.
+    table->ColumnsVisibleCountMax = ImMax(table->ColumnsVisibleCountMax, table->ColumnsVisibleCount);
+    const int channels_for_row = (table->Flags & ImGuiTableFlags_NoClip) ? 1 : table->ColumnsVisibleCountMax;
     const int channels_for_bg = 1 + 1 * freeze_row_multiplier;
-    const int channels_for_dummy = (table->ColumnsEnabledCount < table->ColumnsCount || table->VisibleMaskByIndex != table->EnabledMaskByIndex) ? +1 : 0;
+    const int channels_for_dummy = (table->ColumnsVisibleCount < table->ColumnsCount) ? +1 : 0;
     const int channels_total = channels_for_bg + (channels_for_row * freeze_row_multiplier) + channels_for_dummy;
     table->DrawSplitter.Split(table->InnerWindow->DrawList, channels_total);
     table->DummyDrawChannel = (ImGuiTableDrawChannelIdx)((channels_for_dummy > 0) ? channels_total - 1 : -1);
@@ -2253,18 +2305,26 @@ void ImGui::TableMergeDrawChannels(ImGuiTable* table)
     // Track which groups we are going to attempt to merge, and which channels goes into each group.
     struct MergeGroup
     {
-        ImRect  ClipRect;
-        int     ChannelsCount;
-        ImBitArray<IMGUI_TABLE_MAX_DRAW_CHANNELS> ChannelsMask;
+        ImRect          ClipRect;
+        int             ChannelsCount;
+        ImBitArrayPtr   ChannelsMask;
     };
     int merge_group_mask = 0x00;
     MergeGroup merge_groups[4];
     memset(merge_groups, 0, sizeof(merge_groups));
 
+    // Masks are sized on the actual channel count, use shared temporary storage so the allocation gets amortized.
+    // (4 masks for merge groups + 1 for remaining channels)
+    const int mask_storage_count = (int)(ImBitArrayGetStorageSizeInBytes(splitter->_Count) / sizeof(ImU32));
+    g.TablesTempBitArrays.resize(mask_storage_count * 5);
+    memset(g.TablesTempBitArrays.Data, 0, (size_t)g.TablesTempBitArrays.size_in_bytes());
+    for (int merge_group_n = 0; merge_group_n < IM_ARRAYSIZE(merge_groups); merge_group_n++)
+        merge_groups[merge_group_n].ChannelsMask = g.TablesTempBitArrays.Data + mask_storage_count * merge_group_n;
+
     // 1. Scan channels and take note of those which can be merged
     for (int column_n = 0; column_n < table->ColumnsCount; column_n++)
     {
-        if ((table->VisibleMaskByIndex & ((ImU64)1 << column_n)) == 0)
+        if (!ImBitArrayTestBit(table->VisibleMaskByIndex, column_n))
             continue;
         ImGuiTableColumn* column = &table->Columns[column_n];
 
@@ -2296,11 +2356,11 @@ void ImGui::TableMergeDrawChannels(ImGuiTable* table)
             }
 
             const int merge_group_n = (has_freeze_h && column_n < table->FreezeColumnsCount ? 0 : 1) + (has_freeze_v && merge_group_sub_n == 0 ? 0 : 2);
-            IM_ASSERT(channel_no < IMGUI_TABLE_MAX_DRAW_CHANNELS);
+            IM_ASSERT(channel_no < splitter->_Count && channel_no < IMGUI_TABLE_MAX_DRAW_CHANNELS);
             MergeGroup* merge_group = &merge_groups[merge_group_n];
             if (merge_group->ChannelsCount == 0)
                 merge_group->ClipRect = ImRect(+FLT_MAX, +FLT_MAX, -FLT_MAX, -FLT_MAX);
-            merge_group->ChannelsMask.SetBit(channel_no);
+            ImBitArraySetBit(merge_group->ChannelsMask, channel_no);
             merge_group->ChannelsCount++;
             merge_group->ClipRect.Add(src_channel->_CmdBuffer[0].ClipRect);
             merge_group_mask |= (1 << merge_group_n);
@@ -2334,12 +2394,12 @@ void ImGui::TableMergeDrawChannels(ImGuiTable* table)
     {
         // We skip channel 0 (Bg0/Bg1) and 1 (Bg2 frozen) from the shuffling since they won't move - see channels allocation in TableSetupDrawChannels().
         const int LEADING_DRAW_CHANNELS = 2;
-        g.DrawChannelsTempMergeBuffer.resize(splitter->_Count - LEADING_DRAW_CHANNELS); // Use shared temporary storage so the allocation gets amortized
+        const int reordered_count = splitter->_Count - LEADING_DRAW_CHANNELS;
+        g.DrawChannelsTempMergeBuffer.resize(reordered_count * 2); // Use shared temporary storage so the allocation gets amortized
         ImDrawChannel* dst_tmp = g.DrawChannelsTempMergeBuffer.Data;
-        ImBitArray<IMGUI_TABLE_MAX_DRAW_CHANNELS> remaining_mask;                       // We need 132-bit of storage
-        remaining_mask.ClearAllBits();
-        remaining_mask.SetBitRange(LEADING_DRAW_CHANNELS, splitter->_Count);
-        remaining_mask.ClearBit(table->Bg2DrawChannelUnfrozen);
+        ImBitArrayPtr remaining_mask = g.TablesTempBitArrays.Data + mask_storage_count * 4;  // Already cleared above
+        ImBitArraySetBitRange(remaining_mask, LEADING_DRAW_CHANNELS, splitter->_Count);
+        ImBitArrayClearBit(remaining_mask, table->Bg2DrawChannelUnfrozen);
         IM_ASSERT(has_freeze_v == false || table->Bg2DrawChannelUnfrozen != TABLE_DRAW_CHANNEL_BG2_FROZEN);
         int remaining_count = splitter->_Count - (has_freeze_v ? LEADING_DRAW_CHANNELS + 1 : LEADING_DRAW_CHANNELS);
         //ImRect host_rect = (table->InnerWindow == table->OuterWindow) ? table->InnerClipRect : table->HostClipRect;
@@ -2372,14 +2432,14 @@ void ImGui::TableMergeDrawChannels(ImGuiTable* table)
                 GetOverlayDrawList()->AddLine(merge_group->ClipRect.Max, merge_clip_rect.Max, IM_COL32(255, 100, 0, 200));
 #endif
                 remaining_count -= merge_group->ChannelsCount;
-                for (int n = 0; n < IM_ARRAYSIZE(remaining_mask.Storage); n++)
-                    remaining_mask.Storage[n] &= ~merge_group->ChannelsMask.Storage[n];
+                for (int n = 0; n < mask_storage_count; n++)
+                    remaining_mask[n] &= ~merge_group->ChannelsMask[n];
                 for (int n = 0; n < splitter->_Count && merge_channels_count != 0; n++)
                 {
                     // Copy + overwrite new clip rect
-                    if (!merge_group->ChannelsMask.TestBit(n))
+                    if (!ImBitArrayTestBit(merge_group->ChannelsMask, n))
                         continue;
-                    merge_group->ChannelsMask.ClearBit(n);
+                    ImBitArrayClearBit(merge_group->ChannelsMask, n);
                     merge_channels_count--;
 
                     ImDrawChannel* channel = &splitter->_Channels[n];
@@ -2397,17 +2457,35 @@ void ImGui::TableMergeDrawChannels(ImGuiTable* table)
         // Append unmergeable channels that we didn't reorder at the end of the list
         for (int n = 0; n < splitter->_Count && remaining_count != 0; n++)
         {
-            if (!remaining_mask.TestBit(n))
+            if (!ImBitArrayTestBit(remaining_mask, n))
                 continue;
             ImDrawChannel* channel = &splitter->_Channels[n];
             memcpy(dst_tmp++, channel, sizeof(ImDrawChannel));
             remaining_count--;
         }
-        IM_ASSERT(dst_tmp == g.DrawChannelsTempMergeBuffer.Data + g.DrawChannelsTempMergeBuffer.Size);
-        memcpy(splitter->_Channels.Data + LEADING_DRAW_CHANNELS, g.DrawChannelsTempMergeBuffer.Data, (splitter->_Count - LEADING_DRAW_CHANNELS) * sizeof(ImDrawChannel));
+        IM_ASSERT(dst_tmp == g.DrawChannelsTempMergeBuffer.Data + reordered_count);
+
+        // Keep the original order in the second half of the buffer: EndTable() restores it after merging, see TableRestoreDrawChannels().
+        memcpy(g.DrawChannelsTempMergeBuffer.Data + reordered_count, splitter->_Channels.Data + LEADING_DRAW_CHANNELS, reordered_count * sizeof(ImDrawChannel));
+        memcpy(splitter->_Channels.Data + LEADING_DRAW_CHANNELS, g.DrawChannelsTempMergeBuffer.Data, reordered_count * sizeof(ImDrawChannel));
     }
 }
 
+// Put channels reordered by TableMergeDrawChannels() back in their original slots, after the splitter merged them. Called by EndTable().
+// Each channel owns buffers that it keeps from one frame to the next. Without this, buffers would move to other slots every frame
+// (the order depends on which columns are visible and mergeable), and keep growing as they are given larger contents than before.
+void ImGui::TableRestoreDrawChannels(ImGuiTable* table)
+{
+    ImGuiContext& g = *GImGui;
+    if (g.DrawChannelsTempMergeBuffer.Size == 0)
+        return;
+    const int LEADING_DRAW_CHANNELS = 2;
+    const int reordered_count = g.DrawChannelsTempMergeBuffer.Size / 2;
+    IM_ASSERT(table->DrawSplitter._Channels.Size >= LEADING_DRAW_CHANNELS + reordered_count);
+    memcpy(table->DrawSplitter._Channels.Data + LEADING_DRAW_CHANNELS, g.DrawChannelsTempMergeBuffer.Data + reordered_count, reordered_count * sizeof(ImDrawChannel));
+    g.DrawChannelsTempMergeBuffer.resize(0);
+}
+
 // FIXME-TABLE: This is a mess, need to redesign how we render borders (as some are also done in TableEndRow)
 void ImGui::TableDrawBorders(ImGuiTable* table)
 {
@@ -2428,7 +2506,7 @@ void ImGui::TableDrawBorders(ImGuiTable* table)
     {
         for (int order_n = 0; order_n < table->ColumnsCount; order_n++)
         {
-            if (!(table->EnabledMaskByDisplayOrder & ((ImU64)1 << order_n)))
+            if (!ImBitArrayTestBit(table->EnabledMaskByDisplayOrder, order_n))
                 continue;
 
             const int column_n = table->DisplayOrderToIndex[order_n];
@@ -2606,11 +2684,18 @@ void ImGui::TableSetColumnSortDirection(int column_n, ImGuiSortDirection sort_di
 
 void ImGui::TableSortSpecsSanitize(ImGuiTable* table)
 {
+    ImGuiContext& g = *GImGui;
     IM_ASSERT(table->Flags & ImGuiTableFlags_Sortable);
 
+    // Both masks below are sized on columns count (SortOrder < ColumnsCount when valid)
+    g.TablesTempBitArrays.resize((int)(ImBitArrayGetStorageSizeInBytes(table->ColumnsCount) / sizeof(ImU32)));
+    ImBitArrayPtr temp_mask = g.TablesTempBitArrays.Data;
+
     // Clear SortOrder from hidden column and verify that there's no gap or duplicate.
     int sort_order_count = 0;
-    ImU64 sort_order_mask = 0x00;
+    int sort_order_max = -1;
+    bool has_duplicate = false;
+    ImBitArrayClearAllBits(temp_mask, table->ColumnsCount); // SortOrder -> used map
     for (int column_n = 0; column_n < table->ColumnsCount; column_n++)
     {
         ImGuiTableColumn* column = &table->Columns[column_n];
@@ -2619,26 +2704,30 @@ void ImGui::TableSortSpecsSanitize(ImGuiTable* table)
         if (column->SortOrder == -1)
             continue;
         sort_order_count++;
-        sort_order_mask |= ((ImU64)1 << column->SortOrder);
-        IM_ASSERT(sort_order_count < (int)sizeof(sort_order_mask) * 8);
+        sort_order_max = ImMax(sort_order_max, (int)column->SortOrder);
+        if (column->SortOrder < 0 || column->SortOrder >= table->ColumnsCount || ImBitArrayTestBit(temp_mask, column->SortOrder))
+            has_duplicate = true;
+        else
+            ImBitArraySetBit(temp_mask, column->SortOrder);
     }
 
-    const bool need_fix_linearize = ((ImU64)1 << sort_order_count) != (sort_order_mask + 1);
+    const bool need_fix_linearize = has_duplicate || (sort_order_max + 1 != sort_order_count);
     const bool need_fix_single_sort_order = (sort_order_count > 1) && !(table->Flags & ImGuiTableFlags_SortMulti);
     if (need_fix_linearize || need_fix_single_sort_order)
     {
-        ImU64 fixed_mask = 0x00;
+        ImBitArrayPtr fixed_mask = temp_mask; // Column Index -> fixed map
+        ImBitArrayClearAllBits(fixed_mask, table->ColumnsCount);
         for (int sort_n = 0; sort_n < sort_order_count; sort_n++)
         {
             // Fix: Rewrite sort order fields if needed so they have no gap or duplicate.
             // (e.g. SortOrder 0 disappeared, SortOrder 1..2 exists --> rewrite then as SortOrder 0..1)
             int column_with_smallest_sort_order = -1;
             for (int column_n = 0; column_n < table->ColumnsCount; column_n++)
-                if ((fixed_mask & ((ImU64)1 << (ImU64)column_n)) == 0 && table->Columns[column_n].SortOrder != -1)
+                if (!ImBitArrayTestBit(fixed_mask, column_n) && table->Columns[column_n].SortOrder != -1)
                     if (column_with_smallest_sort_order == -1 || table->Columns[column_n].SortOrder < table->Columns[column_with_smallest_sort_order].SortOrder)
                         column_with_smallest_sort_order = column_n;
             IM_ASSERT(column_with_smallest_sort_order != -1);
-            fixed_mask |= ((ImU64)1 << column_with_smallest_sort_order);
+            ImBitArraySetBit(fixed_mask, column_with_smallest_sort_order);
             table->Columns[column_with_smallest_sort_order].SortOrder = (ImGuiTableColumnIdx)sort_n;
 
             // Fix: Make sure only one column has a SortOrder if ImGuiTableFlags_MultiSortable is not set.
@@ -2714,7 +2803,12 @@ float ImGui::TableGetHeaderRowHeight()
     int columns_count = TableGetColumnCount();
     for (int column_n = 0; column_n < columns_count; column_n++)
         if (TableGetColumnFlags(column_n) & ImGuiTableColumnFlags_IsEnabled)
-            row_height = ImMax(row_height, CalcTextSize(TableGetColumnName(column_n)).y);
+        {
+            // Only multi-line labels can be taller than a line: don't measure every label of tables with many columns.
+            const char* name = TableGetColumnName(column_n);
+            if (strchr(name, '\n') != NULL)
+                row_height = ImMax(row_height, CalcTextSize(name).y);
+        }
     row_height += GetStyle().CellPadding.y * 2.0f;
     return row_height;
 }
@@ -2743,10 +2837,9 @@ void ImGui::TableHeadersRow()
         return;
 
     const int columns_count = TableGetColumnCount();
-    for (int column_n = 0; column_n < columns_count; column_n++)
+    while (TableNextVisibleColumn())
     {
-        if (!TableSetColumnIndex(column_n))
-            continue;
+        const int column_n = table->CurrentColumn;
 
         // Push an id to allow unnamed labels (generally accidental, but let's behave nicely with them)
         // - in your own code you may omit the PushID/PopID all-together, provided you know they won't collide
@@ -3068,6 +3161,7 @@ static size_t TableSettingsCalcChunkSize(int columns_count)
 ImGuiTableSettings* ImGui::TableSettingsCreate(ImGuiID id, int columns_count)
 {
     ImGuiContext& g = *GImGui;
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_Settings);
     ImGuiTableSettings* settings = g.SettingsTables.alloc_chunk(TableSettingsCalcChunkSize(columns_count));
     TableSettingsInit(settings, id, columns_count, columns_count);
     return settings;
@@ -3191,7 +3285,10 @@ void ImGui::TableLoadSettings(ImGuiTable* table)
 
     // Serialize ImGuiTableSettings/ImGuiTableColumnSettings into ImGuiTable/ImGuiTableColumn
     ImGuiTableColumnSettings* column_settings = settings->GetColumnSettings();
-    ImU64 display_order_mask = 0;
+    g.TablesTempBitArrays.resize((int)(ImBitArrayGetStorageSizeInBytes(table->ColumnsCount) / sizeof(ImU32)));
+    ImBitArrayPtr display_order_mask = g.TablesTempBitArrays.Data;
+    ImBitArrayClearAllBits(display_order_mask, table->ColumnsCount);
+    int display_order_count = 0;
     for (int data_n = 0; data_n < settings->ColumnsCount; data_n++, column_settings++)
     {
         int column_n = column_settings->Index;
@@ -3211,15 +3308,19 @@ void ImGui::TableLoadSettings(ImGuiTable* table)
             column->DisplayOrder = column_settings->DisplayOrder;
         else
             column->DisplayOrder = (ImGuiTableColumnIdx)column_n;
-        display_order_mask |= (ImU64)1 << column->DisplayOrder;
+        if (column->DisplayOrder >= 0 && column->DisplayOrder < settings->ColumnsCount && column->DisplayOrder < table->ColumnsCount && !ImBitArrayTestBit(display_order_mask, column->DisplayOrder))
+        {
+            ImBitArraySetBit(display_order_mask, column->DisplayOrder);
+            display_order_count++;
+        }
         column->IsEnabled = column->IsEnabledNextFrame = column_settings->IsEnabled;
         column->SortOrder = column_settings->SortOrder;
         column->SortDirection = column_settings->SortDirection;
     }
 
     // Validate and fix invalid display order data
-    const ImU64 expected_display_order_mask = (settings->ColumnsCount == 64) ? ~0 : ((ImU64)1 << settings->ColumnsCount) - 1;
-    if (display_order_mask != expected_display_order_mask)
+    // (valid when every order in 0..settings->ColumnsCount-1 is used exactly once)
+    if (display_order_count != settings->ColumnsCount)
         for (int column_n = 0; column_n < table->ColumnsCount; column_n++)
             table->Columns[column_n].DisplayOrder = (ImGuiTableColumnIdx)column_n;
 
@@ -125,6 +125,9 @@ static const ImU64          IM_U64_MAX = (2ULL * 9223372036854775807LL + 1);
 static bool             InputTextFilterCharacter(unsigned int* p_char, ImGuiInputTextFlags flags, ImGuiInputTextCallback callback, void* user_data);
 static int              InputTextCalcTextLenAndLineCount(const char* text_begin, const char** out_text_end);
 static ImVec2           InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* text_end, const ImWchar** remaining = NULL, ImVec2* out_offset = NULL, bool stop_on_new_line = false);
+static int              InputTextCalcTextOffsetA(ImGuiInputTextState* state, int char_idx);
+static void             InputTextUpdateLineStarts(ImGuiInputTextState* state);
+static int              InputTextFindLineNo(const ImGuiInputTextState* state, int char_idx);
 
 //-------------------------------------------------------------------------
 // [SECTION] Widgets: Text, etc.
@@ -3493,15 +3496,12 @@ bool ImGui::InputTextWithHint(const char* label, const char* hint, char* buf, si
 
 static int InputTextCalcTextLenAndLineCount(const char* text_begin, const char** out_text_end)
 {
-    int line_count = 0;
-    const char* s = text_begin;
-    while (char c = *s++) // We are only matching for \n so we can ignore UTF-8 decoding
-        if (c == '\n')
-            line_count++;
-    s--;
-    if (s[0] != '\n' && s[0] != '\r')
+    // We are only matching for \n so we can ignore UTF-8 decoding
+    const char* text_end = text_begin + strlen(text_begin);
+    int line_count = 1;
+    for (const char* s = text_begin; (s = (const char*)memchr(s, '\n', (size_t)(text_end - s))) != NULL; s++)
         line_count++;
-    *out_text_end = s;
+    *out_text_end = text_end;
     return line_count;
 }
 
@@ -3550,6 +3550,205 @@ static ImVec2 InputTextCalcTextSizeW(const ImWchar* text_begin, const ImWchar* t
     return text_size;
 }
 
+// Convert a wchar index in TextW into a byte offset in its UTF-8 mirror TextA.
+// Counting from the start of the text is O(N), but edits and cursor queries are mostly local so we count from the last converted position.
+static int InputTextCalcTextOffsetA(ImGuiInputTextState* state, int char_idx)
+{
+    IM_ASSERT(char_idx >= 0 && char_idx <= state->CurLenW);
+    const ImWchar* text = state->TextW.Data;
+    int cache_w = state->TextAOffsetCacheW;
+    int cache_a = state->TextAOffsetCacheA;
+    if (cache_w > state->CurLenW || char_idx < cache_w - char_idx)
+        cache_w = cache_a = 0;
+    if (char_idx >= cache_w)
+        cache_a += ImTextCountUtf8BytesFromStr(text + cache_w, text + char_idx);
+    else
+        cache_a -= ImTextCountUtf8BytesFromStr(text + char_idx, text + cache_w);
+    state->TextAOffsetCacheW = char_idx;
+    state->TextAOffsetCacheA = cache_a;
+    return cache_a;
+}
+
+// Rebuild the line index if the text was rewritten as a whole. Edits done through stb_textedit.h update it incrementally.
+static void InputTextUpdateLineStarts(ImGuiInputTextState* state)
+{
+    if (!state->LineStartsDirty)
+        return;
+    state->LineStartsDirty = false;
+    state->LineStartsLastRow = 0;
+    state->LineStartsW.resize(0);
+    state->LineStartsA.resize(0);
+    state->LineStartsW.push_back(0);
+    state->LineStartsA.push_back(0);
+    const ImWchar* text = state->TextW.Data;
+    const char* text_a = state->TextA.Data;     // Read-only widgets: copy of the user buffer
+    const char* text_a_end = text_a + state->CurLenA;
+    int offset_a = 0;
+    for (int n = 0; n < state->CurLenW; n++)
+    {
+        const unsigned int c = text[n];
+        if (!state->TextAIsValid)
+        {
+            // Offsets are used in the user buffer: step over the bytes this character was decoded from.
+            // 4 bytes sequences and invalid input (decoded as U+FFFD) don't have the same length once encoded again.
+            unsigned int unused_c;
+            offset_a += ImTextCharFromUtf8(&unused_c, text_a + offset_a, text_a_end);
+        }
+        else
+        {
+            offset_a += (c < 0x80) ? 1 : ImTextCountUtf8BytesFromStr(text + n, text + n + 1);
+        }
+        if (c == '\n')
+        {
+            state->LineStartsW.push_back(n + 1);
+            state->LineStartsA.push_back(offset_a);
+        }
+    }
+}
+
+// Return the line containing character 'char_idx'
+static int InputTextFindLineNo(const ImGuiInputTextState* state, int char_idx)
+{
+    IM_ASSERT(!state->LineStartsDirty && state->LineStartsW.Size > 0);
+    const int* line_starts = state->LineStartsW.Data;
+    int line_min = 0;
+    int line_max = state->LineStartsW.Size - 1;
+    while (line_min < line_max)
+    {
+        const int line_mid = (line_min + line_max + 1) >> 1;
+        if (line_starts[line_mid] <= char_idx)
+            line_min = line_mid;
+        else
+            line_max = line_mid - 1;
+    }
+    return line_min;
+}
+
+// Grow undo storage on demand. Start from a few KB rather than ImVector's default so typing doesn't reallocate every few characters.
+// Capacity is kept across activations (Clear() doesn't free), until ClearFreeMemory().
+template<typename T>
+static void InputTextUndoGrow(ImVector<T>* v, int new_size, int min_capacity)
+{
+    if (new_size > v->Capacity)
+        v->reserve(ImMax(ImMax(new_size, min_capacity), v->Capacity + v->Capacity / 2));
+}
+
+// Append UTF-8 encoding of 'text' to 'out'
+static void InputTextUndoAppendText(ImVector<char>* out, const ImWchar* text, int text_len, int text_bytes)
+{
+    InputTextUndoGrow(out, out->Size + text_bytes + 1, 4096);
+    out->resize(out->Size + text_bytes + 1);
+    ImTextStrToUtf8(out->Data + out->Size - text_bytes - 1, text_bytes + 1, text, text + text_len);
+    out->pop_back(); // ImTextStrToUtf8() zero-terminates
+}
+
+// Called before 'text_len' characters at 'where' are removed
+void ImGuiInputTextUndoStack::RecordDelete(int where, const ImWchar* text, int text_len)
+{
+    if (Applying || text_len <= 0)
+        return;
+    if (UndoPoint < Records.Size)
+    {
+        Text.resize(Records[UndoPoint].TextOffset);
+        Records.resize(UndoPoint);
+    }
+
+    // Merge successive Backspace/Delete presses
+    const int text_bytes = ImTextCountUtf8BytesFromStr(text, text + text_len);
+    ImGuiInputTextUndoRecord* last = Records.Size > FirstRecord ? &Records.back() : NULL;
+    const bool can_merge = last && last->Group == Group - 1 && last->InsertLen == 0 && text_len == 1 && text[0] != '\n';
+    if (can_merge && where + 1 == last->Where)
+    {
+        char c_utf8[5];
+        ImTextStrToUtf8(c_utf8, IM_ARRAYSIZE(c_utf8), text, text + 1);
+        InputTextUndoGrow(&Text, Text.Size + text_bytes, 4096);
+        Text.resize(Text.Size + text_bytes);
+        memmove(Text.Data + last->TextOffset + text_bytes, Text.Data + last->TextOffset, (size_t)last->DeleteBytes);
+        memcpy(Text.Data + last->TextOffset, c_utf8, (size_t)text_bytes);
+        last->Where--;
+    }
+    else if (can_merge && where == last->Where)
+    {
+        InputTextUndoAppendText(&Text, text, text_len, text_bytes);
+    }
+    else
+    {
+        ImGuiInputTextUndoRecord rec = { where, 0, 0, Text.Size, 0, 0, Group };
+        InputTextUndoGrow(&Records, Records.Size + 1, 64);
+        Records.push_back(rec);
+        InputTextUndoAppendText(&Text, text, text_len, text_bytes);
+        last = &Records.back();
+    }
+    last->DeleteLen += text_len;
+    last->DeleteBytes += text_bytes;
+    last->Group = Group;
+    UndoPoint = Records.Size;
+    ApplyMemoryLimit();
+}
+
+// Called after 'text_len' characters were inserted at 'where'
+void ImGuiInputTextUndoStack::RecordInsert(int where, const ImWchar* text, int text_len)
+{
+    if (Applying || text_len <= 0)
+        return;
+    if (UndoPoint < Records.Size)
+    {
+        Text.resize(Records[UndoPoint].TextOffset);
+        Records.resize(UndoPoint);
+    }
+
+    // Merge with a delete at the same position in the same action (typing over a selection, paste, revert), or extend a typing run.
+    // A typing run ends on a new line or when a new word is started.
+    const int text_bytes = ImTextCountUtf8BytesFromStr(text, text + text_len);
+    ImGuiInputTextUndoRecord* last = Records.Size > FirstRecord ? &Records.back() : NULL;
+    bool merge = last && last->Group == Group && last->InsertLen == 0 && last->Where == where;
+    if (!merge && last && last->Group == Group - 1 && last->InsertLen > 0 && last->Where + last->InsertLen == where && text_len == 1 && text[0] != '\n')
+    {
+        const char* prev_c_utf8 = Text.Data + Text.Size - 1;
+        while (prev_c_utf8 > Text.Data && (*prev_c_utf8 & 0xC0) == 0x80)
+            prev_c_utf8--;
+        unsigned int prev_c;
+        ImTextCharFromUtf8(&prev_c, prev_c_utf8, Text.Data + Text.Size);
+        merge = prev_c != '\n' && !(ImCharIsBlankW(prev_c) && !ImCharIsBlankW(text[0]));
+    }
+    if (!merge)
+    {
+        ImGuiInputTextUndoRecord rec = { where, 0, 0, Text.Size, 0, 0, Group };
+        InputTextUndoGrow(&Records, Records.Size + 1, 64);
+        Records.push_back(rec);
+        last = &Records.back();
+    }
+    InputTextUndoAppendText(&Text, text, text_len, text_bytes);
+    last->InsertLen += text_len;
+    last->InsertBytes += text_bytes;
+    last->Group = Group;
+    UndoPoint = Records.Size;
+    ApplyMemoryLimit();
+}
+
+// Discard oldest records when using more than io.ConfigInputTextUndoMemoryMax, down to 3/4 of it so we don't do this on every edit.
+// Discarded records are only skipped over, they are removed once they take more space than the remaining history.
+void ImGuiInputTextUndoStack::ApplyMemoryLimit()
+{
+    ImGuiContext& g = *GImGui;
+    const int memory_max = g.IO.ConfigInputTextUndoMemoryMax;
+    if (GetMemoryUsage() <= memory_max)
+        return;
+    const int memory_target = memory_max - memory_max / 4;
+    while (FirstRecord < UndoPoint && GetMemoryUsage() > memory_target)
+        FirstRecord++;
+
+    const int discard_bytes = GetTextOffset();
+    if (FirstRecord == 0 || discard_bytes < Text.Size - discard_bytes)
+        return;
+    Text.erase(Text.Data, Text.Data + discard_bytes);
+    Records.erase(Records.Data, Records.Data + FirstRecord);
+    for (int n = 0; n < Records.Size; n++)
+        Records[n].TextOffset -= discard_bytes;
+    UndoPoint -= FirstRecord;
+    FirstRecord = 0;
+}
+
 // Wrapper for stb_textedit.h to edit text (our wrapper is for: statically sized buffer, single-line, wchar characters. InputText converts between UTF-8 and wchar)
 namespace ImStb
 {
@@ -3561,6 +3760,25 @@ static int     STB_TEXTEDIT_KEYTOTEXT(int key)
 static ImWchar STB_TEXTEDIT_NEWLINE = '\n';
 static void    STB_TEXTEDIT_LAYOUTROW(StbTexteditRow* r, STB_TEXTEDIT_STRING* obj, int line_start_idx)
 {
+    // Multi-line: use the line index, as stb_textedit.h walks all rows from the start of the text to locate the cursor or the mouse.
+    // We don't measure the row width: it is only used to early out when clicking past the end of a row, which still gives the same result.
+    if (!obj->Stb.single_line)
+    {
+        InputTextUpdateLineStarts(obj);
+        int line_no = obj->LineStartsLastRow + 1;
+        if (line_no >= obj->LineStartsW.Size || obj->LineStartsW[line_no] != line_start_idx)
+            line_no = InputTextFindLineNo(obj, line_start_idx);
+        obj->LineStartsLastRow = line_no;
+        const int line_end_idx = (line_no + 1 < obj->LineStartsW.Size) ? obj->LineStartsW[line_no + 1] : obj->CurLenW;
+        r->x0 = 0.0f;
+        r->x1 = FLT_MAX;
+        r->baseline_y_delta = GImGui->FontSize;
+        r->ymin = 0.0f;
+        r->ymax = GImGui->FontSize;
+        r->num_chars = line_end_idx - line_start_idx;
+        return;
+    }
+
     const ImWchar* text = obj->TextW.Data;
     const ImWchar* text_remaining = NULL;
     const ImVec2 size = InputTextCalcTextSizeW(text + line_start_idx, text + obj->CurLenW, &text_remaining, NULL, true);
@@ -3587,26 +3805,53 @@ static int  STB_TEXTEDIT_MOVEWORDRIGHT_IMPL(STB_TEXTEDIT_STRING* obj, int idx)
 static void STB_TEXTEDIT_DELETECHARS(STB_TEXTEDIT_STRING* obj, int pos, int n)
 {
     ImWchar* dst = obj->TextW.Data + pos;
+    const int n_utf8 = ImTextCountUtf8BytesFromStr(dst, dst + n);
+    obj->Undo.RecordDelete(pos, dst, n);
+
+    // Update line index: remove lines starting inside the deleted range, offset the following ones
+    if (!obj->LineStartsDirty)
+    {
+        const int line_first = InputTextFindLineNo(obj, pos) + 1;
+        const int line_last = InputTextFindLineNo(obj, pos + n) + 1;
+        if (line_last > line_first)
+        {
+            obj->LineStartsW.erase(obj->LineStartsW.Data + line_first, obj->LineStartsW.Data + line_last);
+            obj->LineStartsA.erase(obj->LineStartsA.Data + line_first, obj->LineStartsA.Data + line_last);
+        }
+        for (int line_no = line_first; line_no < obj->LineStartsW.Size; line_no++)
+        {
+            obj->LineStartsW[line_no] -= n;
+            obj->LineStartsA[line_no] -= n_utf8;
+        }
+    }
+
+    // Apply the same edit to the UTF-8 mirror, so we never have to convert the whole text back
+    if (obj->TextAIsValid)
+    {
+        char* dst_a = obj->TextA.Data + InputTextCalcTextOffsetA(obj, pos);
+        memmove(dst_a, dst_a + n_utf8, (size_t)(obj->TextA.Data + obj->CurLenA - (dst_a + n_utf8)) + 1);
+    }
 
     // We maintain our buffer length in both UTF-8 and wchar formats
     obj->Edited = true;
-    obj->CurLenA -= ImTextCountUtf8BytesFromStr(dst, dst + n);
+    obj->CurLenA -= n_utf8;
     obj->CurLenW -= n;
 
-    // Offset remaining text (FIXME-OPT: Use memmove)
-    const ImWchar* src = obj->TextW.Data + pos + n;
-    while (ImWchar c = *src++)
-        *dst++ = c;
-    *dst = '\0';
+    // Offset remaining text
+    memmove(dst, dst + n, (size_t)(obj->CurLenW - pos) * sizeof(ImWchar));
+    obj->TextW[obj->CurLenW] = '\0';
 }
 
-static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const ImWchar* new_text, int new_text_len)
+// Insert 'new_text_len' characters at 'pos', given either as wide characters ('new_text') or as UTF-8 ('new_text_utf8', when 'new_text' is NULL).
+// UTF-8 input is decoded directly into TextW, so undo/redo doesn't need a temporary buffer for the restored text.
+static bool InputTextInsertChars(ImGuiInputTextState* obj, int pos, const ImWchar* new_text, int new_text_len, const char* new_text_utf8, const char* new_text_utf8_end)
 {
     const bool is_resizable = (obj->UserFlags & ImGuiInputTextFlags_CallbackResize) != 0;
     const int text_len = obj->CurLenW;
     IM_ASSERT(pos <= text_len);
+    IM_ASSERT(new_text != NULL || new_text_utf8 != NULL);
 
-    const int new_text_len_utf8 = ImTextCountUtf8BytesFromStr(new_text, new_text + new_text_len);
+    const int new_text_len_utf8 = new_text ? ImTextCountUtf8BytesFromStr(new_text, new_text + new_text_len) : (int)(new_text_utf8_end - new_text_utf8);
     if (!is_resizable && (new_text_len_utf8 + obj->CurLenA + 1 > obj->BufCapacityA))
         return false;
 
@@ -3619,19 +3864,127 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
         obj->TextW.resize(text_len + ImClamp(new_text_len * 4, 32, ImMax(256, new_text_len)) + 1);
     }
 
+    // Apply the same edit to the UTF-8 mirror (before modifying TextW, which is used to locate the insertion point)
+    const int pos_a = InputTextCalcTextOffsetA(obj, pos);
+    if (obj->TextAIsValid)
+    {
+        if (obj->CurLenA + new_text_len_utf8 + 1 > obj->TextA.Size)
+            obj->TextA.resize(obj->CurLenA + new_text_len_utf8 + 1);
+        char* text_a = obj->TextA.Data;
+        if (pos_a != obj->CurLenA)
+            memmove(text_a + pos_a + new_text_len_utf8, text_a + pos_a, (size_t)(obj->CurLenA - pos_a));
+        if (new_text)
+        {
+            const char backup_c = text_a[pos_a + new_text_len_utf8]; // ImTextStrToUtf8() zero-terminates
+            ImTextStrToUtf8(text_a + pos_a, new_text_len_utf8 + 1, new_text, new_text + new_text_len);
+            text_a[pos_a + new_text_len_utf8] = backup_c;
+        }
+        else
+        {
+            memcpy(text_a + pos_a, new_text_utf8, (size_t)new_text_len_utf8);
+        }
+        text_a[obj->CurLenA + new_text_len_utf8] = '\0';
+    }
+
     ImWchar* text = obj->TextW.Data;
     if (pos != text_len)
         memmove(text + pos + new_text_len, text + pos, (size_t)(text_len - pos) * sizeof(ImWchar));
-    memcpy(text + pos, new_text, (size_t)new_text_len * sizeof(ImWchar));
+    if (new_text)
+    {
+        memcpy(text + pos, new_text, (size_t)new_text_len * sizeof(ImWchar));
+    }
+    else
+    {
+        const ImWchar backup_c = text[pos + new_text_len]; // ImTextStrFromUtf8() zero-terminates
+        ImTextStrFromUtf8(text + pos, new_text_len + 1, new_text_utf8, new_text_utf8_end);
+        text[pos + new_text_len] = backup_c;
+        new_text = text + pos;
+    }
+
+    // Update line index: offset the following lines, add lines for inserted new-lines
+    if (!obj->LineStartsDirty)
+    {
+        const int line_first = InputTextFindLineNo(obj, pos) + 1;
+        for (int line_no = line_first; line_no < obj->LineStartsW.Size; line_no++)
+        {
+            obj->LineStartsW[line_no] += new_text_len;
+            obj->LineStartsA[line_no] += new_text_len_utf8;
+        }
+        int new_lines_count = 0;
+        for (int n = 0; n < new_text_len; n++)
+            new_lines_count += (new_text[n] == '\n') ? 1 : 0;
+        if (new_lines_count > 0)
+        {
+            const int lines_count = obj->LineStartsW.Size;
+            obj->LineStartsW.resize(lines_count + new_lines_count);
+            obj->LineStartsA.resize(lines_count + new_lines_count);
+            memmove(obj->LineStartsW.Data + line_first + new_lines_count, obj->LineStartsW.Data + line_first, (size_t)(lines_count - line_first) * sizeof(int));
+            memmove(obj->LineStartsA.Data + line_first + new_lines_count, obj->LineStartsA.Data + line_first, (size_t)(lines_count - line_first) * sizeof(int));
+            int line_no = line_first;
+            int offset_a = pos_a;
+            for (int n = 0; n < new_text_len; n++)
+            {
+                const unsigned int c = new_text[n];
+                offset_a += (c < 0x80) ? 1 : ImTextCountUtf8BytesFromStr(new_text + n, new_text + n + 1);
+                if (c == '\n')
+                {
+                    obj->LineStartsW[line_no] = pos + n + 1;
+                    obj->LineStartsA[line_no] = offset_a;
+                    line_no++;
+                }
+            }
+        }
+    }
 
     obj->Edited = true;
     obj->CurLenW += new_text_len;
     obj->CurLenA += new_text_len_utf8;
     obj->TextW[obj->CurLenW] = '\0';
+    obj->Undo.RecordInsert(pos, new_text, new_text_len);
 
     return true;
 }
 
+static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const ImWchar* new_text, int new_text_len)
+{
+    return InputTextInsertChars(obj, pos, new_text, new_text_len, NULL, NULL);
+}
+
+// Undo/redo from our own history (STB_TEXTEDIT_UNDO_CUSTOM)
+static void STB_TEXTEDIT_UNDOREDO_IMPL(STB_TEXTEDIT_STRING* obj, STB_TexteditState* state, bool redo)
+{
+    ImGuiInputTextUndoStack* undo = &obj->Undo;
+    if (redo ? (undo->UndoPoint >= undo->Records.Size) : (undo->UndoPoint <= undo->FirstRecord))
+        return;
+    const ImGuiInputTextUndoRecord rec = undo->Records[redo ? undo->UndoPoint : undo->UndoPoint - 1];
+    const int remove_len = redo ? rec.DeleteLen : rec.InsertLen;
+    const int restore_len = redo ? rec.InsertLen : rec.DeleteLen;
+    const char* restore_text = undo->Text.Data + rec.TextOffset + (redo ? rec.DeleteBytes : 0);
+    const char* restore_text_end = restore_text + (redo ? rec.InsertBytes : rec.DeleteBytes);
+    if (rec.Where + remove_len > obj->CurLenW)
+    {
+        undo->Clear(); // Text was modified behind our back
+        return;
+    }
+
+    undo->Applying = true;
+    if (remove_len > 0)
+        STB_TEXTEDIT_DELETECHARS(obj, rec.Where, remove_len);
+    const bool restored = (restore_len == 0) || InputTextInsertChars(obj, rec.Where, NULL, restore_len, restore_text, restore_text_end);
+    undo->Applying = false;
+
+    state->cursor = rec.Where + (restored ? restore_len : 0);
+    if (restored)
+        undo->UndoPoint += redo ? +1 : -1;
+    else
+        undo->Clear();
+    undo->NextGroup(false);
+}
+static void STB_TEXTEDIT_UNDO_IMPL(STB_TEXTEDIT_STRING* obj, STB_TexteditState* state) { STB_TEXTEDIT_UNDOREDO_IMPL(obj, state, false); }
+static void STB_TEXTEDIT_REDO_IMPL(STB_TEXTEDIT_STRING* obj, STB_TexteditState* state) { STB_TEXTEDIT_UNDOREDO_IMPL(obj, state, true); }
+#define STB_TEXTEDIT_UNDO   STB_TEXTEDIT_UNDO_IMPL
+#define STB_TEXTEDIT_REDO   STB_TEXTEDIT_REDO_IMPL
+
 // We don't use an enum so we can build even with conflicting symbols (if another user of stb_textedit.h leak their STB_TEXTEDIT_K_* symbols)
 #define STB_TEXTEDIT_K_LEFT         0x200000 // keyboard input to move cursor left
 #define STB_TEXTEDIT_K_RIGHT        0x200001 // keyboard input to move cursor right
@@ -3654,11 +4007,10 @@ static bool STB_TEXTEDIT_INSERTCHARS(STB_TEXTEDIT_STRING* obj, int pos, const Im
 #define STB_TEXTEDIT_IMPLEMENTATION
 #include "imstb_textedit.h"
 
-// stb_textedit internally allows for a single undo record to do addition and deletion, but somehow, calling
-// the stb_textedit_paste() function creates two separate records, so we perform it manually. (FIXME: Report to nothings/stb?)
+// Replace the whole text. The delete and insert are merged into a single undo record.
 static void stb_textedit_replace(STB_TEXTEDIT_STRING* str, STB_TexteditState* state, const STB_TEXTEDIT_CHARTYPE* text, int text_len)
 {
-    stb_text_makeundo_replace(str, state, 0, str->CurLenW, text_len);
+    str->Undo.NextGroup(false);
     ImStb::STB_TEXTEDIT_DELETECHARS(str, 0, str->CurLenW);
     if (text_len <= 0)
         return;
@@ -3675,6 +4027,9 @@ static void stb_textedit_replace(STB_TEXTEDIT_STRING* str, STB_TexteditState* st
 
 void ImGuiInputTextState::OnKeyPressed(int key)
 {
+    // Typed characters and Backspace/Delete presses may be merged with the previous undo record
+    const int key_no_shift = key & ~STB_TEXTEDIT_K_SHIFT;
+    Undo.NextGroup(key_no_shift < STB_TEXTEDIT_K_LEFT || key_no_shift == STB_TEXTEDIT_K_BACKSPACE || key_no_shift == STB_TEXTEDIT_K_DELETE);
     stb_textedit_key(this, &Stb, key);
     CursorFollow = true;
     CursorAnimReset();
@@ -3721,7 +4076,7 @@ void ImGuiInputTextCallbackData::InsertChars(int pos, const char* new_text, cons
         IM_ASSERT(edit_state->ID != 0 && g.ActiveId == edit_state->ID);
         IM_ASSERT(Buf == edit_state->TextA.Data);
         int new_buf_size = BufTextLen + ImClamp(new_text_len * 4, 32, ImMax(256, new_text_len)) + 1;
-        edit_state->TextA.reserve(new_buf_size + 1);
+        edit_state->TextA.resize(new_buf_size + 1);
         Buf = edit_state->TextA.Data;
         BufSize = edit_state->BufCapacityA = new_buf_size;
     }
@@ -3833,6 +4188,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     ImGuiWindow* window = GetCurrentWindow();
     if (window->SkipItems)
         return false;
+    ImGuiMemCategoryScope mem_category_scope(ImGuiMemCategory_InputText);
 
     IM_ASSERT(buf != NULL && buf_size >= 0);
     IM_ASSERT(!((flags & ImGuiInputTextFlags_CallbackHistory) && (flags & ImGuiInputTextFlags_Multiline)));        // Can't use both together (they both use up/down keys)
@@ -3926,23 +4282,43 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         state = &g.InputTextState;
         state->CursorAnimReset();
 
-        // Take a copy of the initial buffer value (both in original UTF-8 format and converted to wchar)
-        // From the moment we focused we are ignoring the content of 'buf' (unless we are in read-only mode)
-        const int buf_len = (int)strlen(buf);
-        state->InitialTextA.resize(buf_len + 1);    // UTF-8. we use +1 to make sure that .Data is always pointing to at least an empty string.
-        memcpy(state->InitialTextA.Data, buf, buf_len + 1);
-
-        // Start edition
-        const char* buf_end = NULL;
-        state->TextW.resize(buf_size + 1);          // wchar count <= UTF-8 count. we use +1 to make sure that .Data is always pointing to at least an empty string.
-        state->TextA.resize(0);
-        state->TextAIsValid = false;                // TextA is not valid yet (we will display buf until then)
-        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, NULL, &buf_end);
-        state->CurLenA = (int)(buf_end - buf);      // We can't get the result from ImStrncpy() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+        // While dragging the scrollbar of an inactive multi-line widget we get here every frame: keep the converted text and line index if 'buf' hasn't changed.
+        const bool recycle_state = (state->ID == id && !init_changed_specs);
+        const bool recycle_text = recycle_state && !init_make_active && state->TextA.Size > 0 && strcmp(state->TextA.Data, buf) == 0;
+        if (!recycle_text)
+        {
+            // Take a copy of the initial buffer value (both in original UTF-8 format and converted to wchar)
+            // From the moment we focused we are ignoring the content of 'buf' (unless we are in read-only mode)
+            const int buf_len = (int)strlen(buf);
+            state->InitialTextA.resize(buf_len + 1);    // UTF-8. we use +1 to make sure that .Data is always pointing to at least an empty string.
+            memcpy(state->InitialTextA.Data, buf, buf_len + 1);
+
+            // Start edition
+            const char* buf_end = NULL;
+            state->TextW.resize(buf_size + 1);          // wchar count <= UTF-8 count. we use +1 to make sure that .Data is always pointing to at least an empty string.
+            state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, buf_size, buf, buf + buf_len, &buf_end);
+            state->CurLenA = (int)(buf_end - buf);      // We can't get the result from ImStrncpy() above because it is not UTF-8 aware. Here we'll cut off malformed UTF-8.
+            state->TextAOffsetCacheW = state->TextAOffsetCacheA = 0;
+            state->LineStartsDirty = true;
+
+            // Build the UTF-8 mirror once, it is then maintained by the edit callbacks.
+            // Read-only widgets always display the live user buffer: we only keep a copy of it in TextA to detect changes.
+            state->TextAIsValid = !is_readonly;
+            if (!is_readonly)
+            {
+                state->CurLenA = ImTextCountUtf8BytesFromStr(state->TextW.Data, state->TextW.Data + state->CurLenW); // May differ from 'buf' with malformed UTF-8
+                state->TextA.resize(ImMax(buf_size, state->CurLenA + 1));
+                ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, state->TextW.Data + state->CurLenW);
+            }
+            else
+            {
+                state->TextA.resize(buf_len + 1);
+                memcpy(state->TextA.Data, buf, buf_len + 1);
+            }
+        }
 
         // Preserve cursor position and undo/redo stack if we come back to same widget
         // FIXME: For non-readonly widgets we might be able to require that TextAIsValid && TextA == buf ? (untested) and discard undo stack if user buffer has changed.
-        const bool recycle_state = (state->ID == id && !init_changed_specs);
         if (recycle_state)
         {
             // Recycle existing cursor/selection/undo stack but clamp position
@@ -3954,6 +4330,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             state->ID = id;
             state->ScrollX = 0.0f;
             stb_textedit_initialize_state(&state->Stb, !is_multiline);
+            state->Undo.Clear();
             if (!is_multiline && focus_requested_by_code)
                 select_all = true;
         }
@@ -3998,13 +4375,19 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
     bool enter_pressed = false;
 
     // When read-only we always use the live data passed to the function
-    // FIXME-OPT: Because our selection/cursor code currently needs the wide text we need to convert it when active, which is not ideal :(
-    if (is_readonly && state != NULL && (render_cursor || render_selection))
+    // Because our selection/cursor code currently needs the wide text we need to convert it when active, but only when it has changed (TextA holds a copy of what we converted).
+    if (is_readonly && state != NULL && (render_cursor || render_selection) && (state->TextA.Size == 0 || strcmp(state->TextA.Data, buf) != 0))
     {
         const char* buf_end = NULL;
         state->TextW.resize(buf_size + 1);
-        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, NULL, &buf_end);
+        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, buf, buf + strlen(buf), &buf_end); // Passing the end allows converting ASCII runs 16 at a time
         state->CurLenA = (int)(buf_end - buf);
+        state->TextA.resize(state->CurLenA + 1);
+        memcpy(state->TextA.Data, buf, (size_t)state->CurLenA);
+        state->TextA[state->CurLenA] = 0;
+        state->TextAIsValid = false;
+        state->TextAOffsetCacheW = state->TextAOffsetCacheA = 0;
+        state->LineStartsDirty = true;
         state->CursorClamp();
         render_selection &= state->HasSelection();
     }
@@ -4067,6 +4450,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             if (hovered)
             {
                 stb_textedit_click(state, &state->Stb, mouse_x, mouse_y);
+                state->Undo.NextGroup(false);
                 state->CursorAnimReset();
             }
         }
@@ -4190,9 +4574,15 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 const int ib = state->HasSelection() ? ImMin(state->Stb.select_start, state->Stb.select_end) : 0;
                 const int ie = state->HasSelection() ? ImMax(state->Stb.select_start, state->Stb.select_end) : state->CurLenW;
-                const int clipboard_data_len = ImTextCountUtf8BytesFromStr(state->TextW.Data + ib, state->TextW.Data + ie) + 1;
+                const int ib_a = state->TextAIsValid ? InputTextCalcTextOffsetA(state, ib) : 0;
+                const int clipboard_data_len = (state->TextAIsValid ? InputTextCalcTextOffsetA(state, ie) - ib_a : ImTextCountUtf8BytesFromStr(state->TextW.Data + ib, state->TextW.Data + ie)) + 1;
+                PushFrameArenaAllocator();
                 char* clipboard_data = (char*)IM_ALLOC(clipboard_data_len * sizeof(char));
-                ImTextStrToUtf8(clipboard_data, clipboard_data_len, state->TextW.Data + ib, state->TextW.Data + ie);
+                PopFrameArenaAllocator();
+                if (state->TextAIsValid)
+                    ImStrncpy(clipboard_data, state->TextA.Data + ib_a, (size_t)clipboard_data_len);
+                else
+                    ImTextStrToUtf8(clipboard_data, clipboard_data_len, state->TextW.Data + ib, state->TextW.Data + ie);
                 SetClipboardText(clipboard_data);
                 MemFree(clipboard_data);
             }
@@ -4201,6 +4591,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 if (!state->HasSelection())
                     state->SelectAll();
                 state->CursorFollow = true;
+                state->Undo.NextGroup(false);
                 stb_textedit_cut(state, &state->Stb);
             }
         }
@@ -4210,7 +4601,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             {
                 // Filter pasted buffer
                 const int clipboard_len = (int)strlen(clipboard);
+                PushFrameArenaAllocator();
                 ImWchar* clipboard_filtered = (ImWchar*)IM_ALLOC((clipboard_len + 1) * sizeof(ImWchar));
+                PopFrameArenaAllocator();
                 int clipboard_filtered_len = 0;
                 for (const char* s = clipboard; *s; )
                 {
@@ -4225,6 +4618,7 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 clipboard_filtered[clipboard_filtered_len] = 0;
                 if (clipboard_filtered_len > 0) // If everything was filtered, ignore the pasting operation
                 {
+                    state->Undo.NextGroup(false);
                     stb_textedit_paste(state, &state->Stb, clipboard_filtered, clipboard_filtered_len);
                     state->CursorFollow = true;
                 }
@@ -4253,7 +4647,9 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                 ImVector<ImWchar> w_text;
                 if (apply_new_text_length > 0)
                 {
+                    PushFrameArenaAllocator();
                     w_text.resize(ImTextCountCharsFromUtf8(apply_new_text, apply_new_text + apply_new_text_length) + 1);
+                    PopFrameArenaAllocator();
                     ImTextStrFromUtf8(w_text.Data, w_text.Size, apply_new_text, apply_new_text + apply_new_text_length);
                 }
                 stb_textedit_replace(state, &state->Stb, w_text.Data, (apply_new_text_length > 0) ? (w_text.Size - 1) : 0);
@@ -4269,12 +4665,20 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             // Apply new value immediately - copy modified buffer back
             // Note that as soon as the input box is active, the in-widget value gets priority over any underlying modification of the input buffer
             // FIXME: We actually always render 'buf' when calling DrawList->AddText, making the comment above incorrect.
-            // FIXME-OPT: CPU waste to do this every time the widget is active, should mark dirty state from the stb_textedit callbacks.
+            // TextA is kept up to date by the stb_textedit callbacks, we only need to make sure the callbacks below may use the full user buffer size.
             if (!is_readonly)
             {
-                state->TextAIsValid = true;
-                state->TextA.resize(state->TextW.Size * 4 + 1);
-                ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, NULL);
+                if (!state->TextAIsValid) // ImGuiInputTextFlags_ReadOnly was cleared while active
+                {
+                    state->TextAIsValid = true;
+                    state->TextAOffsetCacheW = state->TextAOffsetCacheA = 0;
+                    state->LineStartsDirty = true;
+                    state->CurLenA = ImTextCountUtf8BytesFromStr(state->TextW.Data, state->TextW.Data + state->CurLenW);
+                    state->TextA.resize(state->CurLenA + 1);
+                    ImTextStrToUtf8(state->TextA.Data, state->TextA.Size, state->TextW.Data, state->TextW.Data + state->CurLenW);
+                }
+                if (state->TextA.Size < state->BufCapacityA)
+                    state->TextA.resize(state->BufCapacityA);
             }
 
             // User callback
@@ -4324,10 +4728,10 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     callback_data.BufDirty = false;
 
                     // We have to convert from wchar-positions to UTF-8-positions, which can be pretty slow (an incentive to ditch the ImWchar buffer, see https://github.com/nothings/stb/issues/188)
-                    ImWchar* text = state->TextW.Data;
-                    const int utf8_cursor_pos = callback_data.CursorPos = ImTextCountUtf8BytesFromStr(text, text + state->Stb.cursor);
-                    const int utf8_selection_start = callback_data.SelectionStart = ImTextCountUtf8BytesFromStr(text, text + state->Stb.select_start);
-                    const int utf8_selection_end = callback_data.SelectionEnd = ImTextCountUtf8BytesFromStr(text, text + state->Stb.select_end);
+                    // Counting is done from the last converted position, which is usually near the cursor.
+                    const int utf8_cursor_pos = callback_data.CursorPos = InputTextCalcTextOffsetA(state, state->Stb.cursor);
+                    const int utf8_selection_start = callback_data.SelectionStart = InputTextCalcTextOffsetA(state, state->Stb.select_start);
+                    const int utf8_selection_end = callback_data.SelectionEnd = InputTextCalcTextOffsetA(state, state->Stb.select_end);
 
                     // Call user code
                     callback(&callback_data);
@@ -4343,10 +4747,44 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
                     if (buf_dirty)
                     {
                         IM_ASSERT(callback_data.BufTextLen == (int)strlen(callback_data.Buf)); // You need to maintain BufTextLen if you change the text!
+
+                        // Record the change in the undo stack as a single replace, skipping the unmodified head and tail of the text
+                        const char* new_text = callback_data.Buf;
+                        const char* new_text_end = callback_data.Buf + callback_data.BufTextLen;
+                        const ImWchar* old_text_w = state->TextW.Data;
+                        const int old_len_w = state->CurLenW;
+                        int head_len_w = 0;
+                        int tail_len_w = 0;
+                        for (unsigned int c; head_len_w < old_len_w && new_text < new_text_end; head_len_w++)
+                        {
+                            const int c_len = ImTextCharFromUtf8(&c, new_text, new_text_end);
+                            if (c != old_text_w[head_len_w])
+                                break;
+                            new_text += c_len;
+                        }
+                        for (unsigned int c; head_len_w + tail_len_w < old_len_w && new_text_end > new_text; tail_len_w++)
+                        {
+                            const char* c_utf8 = new_text_end - 1;
+                            while (c_utf8 > new_text && (*c_utf8 & 0xC0) == 0x80)
+                                c_utf8--;
+                            ImTextCharFromUtf8(&c, c_utf8, new_text_end);
+                            if (c != old_text_w[old_len_w - 1 - tail_len_w])
+                                break;
+                            new_text_end = c_utf8;
+                        }
+                        state->Undo.NextGroup(false);
+                        state->Undo.RecordDelete(head_len_w, old_text_w + head_len_w, old_len_w - head_len_w - tail_len_w);
+
                         if (callback_data.BufTextLen > backup_current_text_length && is_resizable)
                             state->TextW.resize(state->TextW.Size + (callback_data.BufTextLen - backup_current_text_length));
-                        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, NULL);
+                        state->CurLenW = ImTextStrFromUtf8(state->TextW.Data, state->TextW.Size, callback_data.Buf, callback_data.Buf + callback_data.BufTextLen);
+                        if (state->CurLenW - tail_len_w >= head_len_w)
+                            state->Undo.RecordInsert(head_len_w, state->TextW.Data + head_len_w, state->CurLenW - tail_len_w - head_len_w);
+                        else
+                            state->Undo.Clear(); // Text was truncated
                         state->CurLenA = callback_data.BufTextLen;  // Assume correct length and valid UTF-8 from user, saves us an extra strlen()
+                        state->TextAOffsetCacheW = state->TextAOffsetCacheA = 0;
+                        state->LineStartsDirty = true;
                         state->CursorAnimReset();
                     }
                 }
@@ -4437,52 +4875,25 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         // - Measure text height (for scrollbar)
         // We are attempting to do most of that in **one main pass** to minimize the computation cost (non-negligible for large amount of text) + 2nd pass for selection rendering (we could merge them by an extra refactoring effort)
         // FIXME: This should occur on buf_display but we'd need to maintain cursor/select_start/select_end for UTF-8.
+        // The line index is maintained by the edit callbacks (and only rebuilt when the text was rewritten as a whole), so we don't need to scan the text here.
         const ImWchar* text_begin = state->TextW.Data;
         ImVec2 cursor_offset, select_start_offset;
+        InputTextUpdateLineStarts(state);
+        const int line_count = state->LineStartsW.Size;
+        int select_start_line_no = 0;
 
         {
-            // Find lines numbers straddling 'cursor' (slot 0) and 'select_start' (slot 1) positions.
-            const ImWchar* searches_input_ptr[2] = { NULL, NULL };
-            int searches_result_line_no[2] = { -1000, -1000 };
-            int searches_remaining = 0;
-            if (render_cursor)
-            {
-                searches_input_ptr[0] = text_begin + state->Stb.cursor;
-                searches_result_line_no[0] = -1;
-                searches_remaining++;
-            }
+            // Find lines numbers of 'cursor' and 'select_start' positions.
+            // Calculate 2d position by measuring distance from the beginning of the line.
+            const int cursor_line_no = InputTextFindLineNo(state, state->Stb.cursor);
+            cursor_offset.x = InputTextCalcTextSizeW(text_begin + state->LineStartsW[cursor_line_no], text_begin + state->Stb.cursor).x;
+            cursor_offset.y = (cursor_line_no + 1) * g.FontSize;
             if (render_selection)
             {
-                searches_input_ptr[1] = text_begin + ImMin(state->Stb.select_start, state->Stb.select_end);
-                searches_result_line_no[1] = -1;
-                searches_remaining++;
-            }
-
-            // Iterate all lines to find our line numbers
-            // In multi-line mode, we never exit the loop until all lines are counted, so add one extra to the searches_remaining counter.
-            searches_remaining += is_multiline ? 1 : 0;
-            int line_count = 0;
-            //for (const ImWchar* s = text_begin; (s = (const ImWchar*)wcschr((const wchar_t*)s, (wchar_t)'\n')) != NULL; s++)  // FIXME-OPT: Could use this when wchar_t are 16-bit
-            for (const ImWchar* s = text_begin; *s != 0; s++)
-                if (*s == '\n')
-                {
-                    line_count++;
-                    if (searches_result_line_no[0] == -1 && s >= searches_input_ptr[0]) { searches_result_line_no[0] = line_count; if (--searches_remaining <= 0) break; }
-                    if (searches_result_line_no[1] == -1 && s >= searches_input_ptr[1]) { searches_result_line_no[1] = line_count; if (--searches_remaining <= 0) break; }
-                }
-            line_count++;
-            if (searches_result_line_no[0] == -1)
-                searches_result_line_no[0] = line_count;
-            if (searches_result_line_no[1] == -1)
-                searches_result_line_no[1] = line_count;
-
-            // Calculate 2d position by finding the beginning of the line and measuring distance
-            cursor_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[0], text_begin), searches_input_ptr[0]).x;
-            cursor_offset.y = searches_result_line_no[0] * g.FontSize;
-            if (searches_result_line_no[1] >= 0)
-            {
-                select_start_offset.x = InputTextCalcTextSizeW(ImStrbolW(searches_input_ptr[1], text_begin), searches_input_ptr[1]).x;
-                select_start_offset.y = searches_result_line_no[1] * g.FontSize;
+                const int select_start = ImMin(state->Stb.select_start, state->Stb.select_end);
+                select_start_line_no = InputTextFindLineNo(state, select_start);
+                select_start_offset.x = InputTextCalcTextSizeW(text_begin + state->LineStartsW[select_start_line_no], text_begin + select_start).x;
+                select_start_offset.y = (select_start_line_no + 1) * g.FontSize;
             }
 
             // Store text height (note that we haven't calculated text width at all, see GitHub issues #383, #1224)
@@ -4525,6 +4936,15 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             state->CursorFollow = false;
         }
 
+        // Range of visible lines (after scrolling)
+        int line_visible_first = 0;
+        int line_visible_end = line_count;
+        if (is_multiline)
+        {
+            line_visible_first = ImClamp((int)((clip_rect.y - draw_pos.y) / g.FontSize), 0, line_count - 1);
+            line_visible_end = ImClamp((int)((clip_rect.w - draw_pos.y) / g.FontSize) + 1, line_visible_first + 1, line_count);
+        }
+
         // Draw selection
         const ImVec2 draw_scroll = ImVec2(state->ScrollX, 0.0f);
         if (render_selection)
@@ -4536,6 +4956,12 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             float bg_offy_up = is_multiline ? 0.0f : -1.0f;    // FIXME: those offsets should be part of the style? they don't play so well with multi-line selection.
             float bg_offy_dn = is_multiline ? 0.0f : 2.0f;
             ImVec2 rect_pos = draw_pos + select_start_offset - draw_scroll;
+            if (select_start_line_no < line_visible_first)
+            {
+                // Skip lines above the visible area
+                text_selected_begin = ImMin(text_begin + state->LineStartsW[line_visible_first], text_selected_end);
+                rect_pos = ImVec2(draw_pos.x - draw_scroll.x, draw_pos.y + (line_visible_first + 1) * g.FontSize);
+            }
             for (const ImWchar* p = text_selected_begin; p < text_selected_end; )
             {
                 if (rect_pos.y > clip_rect.w + g.FontSize)
@@ -4563,7 +4989,14 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
         }
 
         // We test for 'buf_display_max_length' as a way to avoid some pathological cases (e.g. single-line 1 MB string) which would make ImDrawList crash.
-        if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
+        // Multi-line: only submit visible lines.
+        if (is_multiline && !is_displaying_hint)
+        {
+            const char* buf_visible_begin = buf_display + ImMin(state->LineStartsA[line_visible_first], (int)(buf_display_end - buf_display));
+            const char* buf_visible_end = (line_visible_end < line_count) ? buf_display + ImMin(state->LineStartsA[line_visible_end], (int)(buf_display_end - buf_display)) : buf_display_end;
+            draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll + ImVec2(0.0f, line_visible_first * g.FontSize), GetColorU32(ImGuiCol_Text), buf_visible_begin, buf_visible_end);
+        }
+        else if (is_multiline || (buf_display_end - buf_display) < buf_display_max_length)
         {
             ImU32 col = GetColorU32(is_displaying_hint ? ImGuiCol_TextDisabled : ImGuiCol_Text);
             draw_window->DrawList->AddText(g.Font, g.FontSize, draw_pos - draw_scroll, col, buf_display, buf_display_end, 0.0f, is_multiline ? NULL : &clip_rect);
@@ -4578,6 +5011,12 @@ bool ImGui::InputTextEx(const char* label, const char* hint, char* buf, int buf_
             ImRect cursor_screen_rect(cursor_screen_pos.x, cursor_screen_pos.y - g.FontSize + 0.5f, cursor_screen_pos.x + 1.0f, cursor_screen_pos.y - 1.5f);
             if (cursor_is_visible && cursor_screen_rect.Overlaps(clip_rect))
                 draw_window->DrawList->AddLine(cursor_screen_rect.Min, cursor_screen_rect.GetBL(), GetColorU32(ImGuiCol_Text));
+            if (g.IO.ConfigInputTextCursorBlink)
+            {
+                // Next blink (cursor stays visible while CursorAnim <= 0.80f, then blinks with a period of 1.20f)
+                const float blink_t = (state->CursorAnim <= 0.0f) ? state->CursorAnim : ImFmod(state->CursorAnim, 1.20f);
+                SetMaxWaitBeforeNextFrame((blink_t <= 0.80f ? 0.80f : 1.20f) - blink_t);
+            }
 
             // Notify OS of text input position for advanced IME (-1 x offset so that Windows IME can cover our cursor. Bit of an extra nicety.)
             if (!is_readonly)
@@ -7273,6 +7712,7 @@ static void ImGui::TabBarLayout(ImGuiTabBar* tab_bar)
         tab_bar->ScrollingSpeed = ImMax(tab_bar->ScrollingSpeed, ImFabs(tab_bar->ScrollingTarget - tab_bar->ScrollingAnim) / 0.3f);
         const bool teleport = (tab_bar->PrevFrameVisible + 1 < g.FrameCount) || (tab_bar->ScrollingTargetDistToVisibility > 10.0f * g.FontSize);
         tab_bar->ScrollingAnim = teleport ? tab_bar->ScrollingTarget : ImLinearSweep(tab_bar->ScrollingAnim, tab_bar->ScrollingTarget, g.IO.DeltaTime * tab_bar->ScrollingSpeed);
+        SetMaxWaitBeforeNextFrame(0.0f);
     }
     else
     {
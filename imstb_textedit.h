@@ -2,6 +2,7 @@
 // This is a slightly modified version of stb_textedit.h 1.13. 
 // Those changes would need to be pushed into nothings/stb:
 // - Fix in stb_textedit_discard_redo (see https://github.com/nothings/stb/issues/321)
+// - Added STB_TEXTEDIT_UNDO_CUSTOM to replace the fixed-size undo buffers with an external undo engine
 // Grep for [DEAR IMGUI] to find the changes.
 
 // stb_textedit.h - v1.13  - public domain - Sean Barrett
@@ -296,6 +297,11 @@
 #define STB_TEXTEDIT_POSITIONTYPE    int
 #endif
 
+// [DEAR IMGUI]
+// Define STB_TEXTEDIT_UNDO_CUSTOM to remove the fixed-size undo buffers from STB_TexteditState.
+// Undo/redo keys then call STB_TEXTEDIT_UNDO(obj,state) and STB_TEXTEDIT_REDO(obj,state), which you need to define,
+// and edits are not recorded by stb_textedit (record them from STB_TEXTEDIT_DELETECHARS/STB_TEXTEDIT_INSERTCHARS).
+#ifndef STB_TEXTEDIT_UNDO_CUSTOM
 typedef struct
 {
    // private data
@@ -313,6 +319,7 @@ typedef struct
    short undo_point, redo_point;
    int undo_char_point, redo_char_point;
 } StbUndoState;
+#endif
 
 typedef struct
 {
@@ -349,7 +356,9 @@ typedef struct
    unsigned char single_line;
    unsigned char padding1, padding2, padding3;
    float preferred_x; // this determines where the cursor up/down tries to seek to along x
+#ifndef STB_TEXTEDIT_UNDO_CUSTOM
    StbUndoState undostate;
+#endif
 } STB_TexteditState;
 
 
@@ -717,8 +726,10 @@ static int stb_textedit_paste_internal(STB_TEXTEDIT_STRING *str, STB_TexteditSta
       return 1;
    }
    // remove the undo since we didn't actually insert the characters
+#ifndef STB_TEXTEDIT_UNDO_CUSTOM
    if (state->undostate.undo_point)
       --state->undostate.undo_point;
+#endif
    return 0;
 }
 
@@ -1117,6 +1128,33 @@ retry:
 //
 // @OPTIMIZE: the undo/redo buffer should be circular
 
+#ifdef STB_TEXTEDIT_UNDO_CUSTOM
+// [DEAR IMGUI]
+static void stb_text_undo(STB_TEXTEDIT_STRING *str, STB_TexteditState *state)
+{
+   STB_TEXTEDIT_UNDO(str, state);
+}
+
+static void stb_text_redo(STB_TEXTEDIT_STRING *str, STB_TexteditState *state)
+{
+   STB_TEXTEDIT_REDO(str, state);
+}
+
+static void stb_text_makeundo_insert(STB_TexteditState *state, int where, int length)
+{
+   (void)state; (void)where; (void)length;
+}
+
+static void stb_text_makeundo_delete(STB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int length)
+{
+   (void)str; (void)state; (void)where; (void)length;
+}
+
+static void stb_text_makeundo_replace(STB_TEXTEDIT_STRING *str, STB_TexteditState *state, int where, int old_length, int new_length)
+{
+   (void)str; (void)state; (void)where; (void)old_length; (void)new_length;
+}
+#else
 static void stb_textedit_flush_redo(StbUndoState *state)
 {
    state->redo_point = STB_TEXTEDIT_UNDOSTATECOUNT;
@@ -1363,14 +1401,17 @@ static void stb_text_makeundo_replace(STB_TEXTEDIT_STRING *str, STB_TexteditStat
          p[i] = STB_TEXTEDIT_GETCHAR(str, where+i);
    }
 }
+#endif // #ifdef STB_TEXTEDIT_UNDO_CUSTOM
 
 // reset the state to default
 static void stb_textedit_clear_state(STB_TexteditState *state, int is_single_line)
 {
+#ifndef STB_TEXTEDIT_UNDO_CUSTOM
    state->undostate.undo_point = 0;
    state->undostate.undo_char_point = 0;
    state->undostate.redo_point = STB_TEXTEDIT_UNDOSTATECOUNT;
    state->undostate.redo_char_point = STB_TEXTEDIT_UNDOCHARCOUNT;
+#endif
    state->select_end = state->select_start = 0;
    state->cursor = 0;
    state->has_preferred_x = 0;